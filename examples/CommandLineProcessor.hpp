@@ -3,8 +3,9 @@
 
 struct CommandLineProcessor {
 
-    int order, dimension, number_target_coords, number_source_coords, number_of_batches;
+    int order, dimension, number_target_coords, number_source_coords, number_of_batches, number_of_neighbor_buckets, targets_per_team;
     std::string constraint_name, solver_name, problem_name;
+    bool overlap_batches, stream_alphas, apply_to_data, regenerate_alphas, single_precision_solve, pack_targets_for_simd, order_along_curve;
 
     CommandLineProcessor(int argc, char* args[], const bool print=true) {
 
@@ -13,9 +14,18 @@ struct CommandLineProcessor {
         number_target_coords = 200; 
         number_source_coords = -1; 
         number_of_batches = 1; 
+        number_of_neighbor_buckets = 0; 
+        overlap_batches = false; 
+        stream_alphas = false; 
+        apply_to_data = false; 
+        regenerate_alphas = false; 
+        single_precision_solve = false; 
+        pack_targets_for_simd = false; 
+        order_along_curve = false; 
+        targets_per_team = 0; 
     
         constraint_name = "NO_CONSTRAINT"; // "NEUMANN_GRAD_SCALAR"
-        solver_name = "QR"; // LU
+        solver_name = "QR"; // LU, CHOLESKY
         problem_name = "STANDARD"; // MANIFOLD
 
         for (int i = 1; i < argc; ++i) {
@@ -30,6 +40,24 @@ struct CommandLineProcessor {
                    number_source_coords = atoi(args[i+1]); 
                 } else if (std::string(args[i]) == "--nb") {
                    number_of_batches = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--nbuckets") {
+                   number_of_neighbor_buckets = atoi(args[i+1]); 
+                } else if (std::string(args[i]) == "--overlap") {
+                   overlap_batches = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--stream") {
+                   stream_alphas = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--apply-to-data") {
+                   apply_to_data = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--regenerate") {
+                   regenerate_alphas = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--single-precision") {
+                   single_precision_solve = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--simd-pack") {
+                   pack_targets_for_simd = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--curve-order") {
+                   order_along_curve = atoi(args[i+1]) != 0; 
+                } else if (std::string(args[i]) == "--targets-per-team") {
+                   targets_per_team = atoi(args[i+1]); 
                 } else if (std::string(args[i]) == "--solver") {
                    solver_name = std::string(args[i+1]); 
                 } else if (std::string(args[i]) == "--problem") {
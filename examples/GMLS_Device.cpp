@@ -1,10 +1,12 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <map>
 #include <stdlib.h> 
 #include <cstdio>
 #include <random>
+#include <memory>
 
 #include <Compadre_Config.h>
 #include <Compadre_GMLS.hpp>
@@ -24,6 +26,34 @@
 
 using namespace Compadre;
 
+//! Compares target outputs (value, Laplacian and gradient, all on the host) against reference outputs and
+//! reports the largest difference relative to the reference when it exceeds the tolerance.
+template <typename value_view_type, typename gradient_view_type, 
+         typename reference_value_view_type, typename reference_gradient_view_type>
+bool outputsAgree(const std::string& description, value_view_type value, value_view_type laplacian, 
+        gradient_view_type gradient, reference_value_view_type reference_value, 
+        reference_value_view_type reference_laplacian, reference_gradient_view_type reference_gradient, 
+        const double tolerance) {
+
+    auto relative_difference = [](const double computed, const double reference) {
+        return std::abs(computed - reference)/(1+std::abs(reference));
+    };
+
+    double max_difference = 0;
+    for (size_t i=0; i<reference_value.extent(0); i++) {
+        max_difference = std::max(max_difference, relative_difference(value(i), reference_value(i)));
+        max_difference = std::max(max_difference, relative_difference(laplacian(i), reference_laplacian(i)));
+        for (size_t j=0; j<reference_gradient.extent(1); j++) {
+            max_difference = std::max(max_difference, relative_difference(gradient(i,j), reference_gradient(i,j)));
+        }
+    }
+    if (max_difference > tolerance) {
+        std::cout << description << " differ by " << max_difference << std::endl;
+        return false;
+    }
+    return true;
+}
+
 //! [Parse Command Line Arguments]
 
 // called from command line
@@ -52,14 +82,25 @@ bool all_passed = true;
     auto solver_name = clp.solver_name;
     auto problem_name = clp.problem_name;
     auto number_of_batches = clp.number_of_batches;
-    bool keep_coefficients = number_of_batches==1;
+    auto number_of_neighbor_buckets = clp.number_of_neighbor_buckets;
+    auto overlap_batches = clp.overlap_batches;
+    auto stream_alphas = clp.stream_alphas;
+    auto apply_to_data = clp.apply_to_data;
+    auto regenerate_alphas = clp.regenerate_alphas;
+    auto single_precision_solve = clp.single_precision_solve;
+    auto pack_targets_for_simd = clp.pack_targets_for_simd;
+    auto targets_per_team = clp.targets_per_team;
+    auto order_along_curve = clp.order_along_curve;
+    bool keep_coefficients = number_of_batches==1 && number_of_neighbor_buckets<2 && !regenerate_alphas 
+        && !single_precision_solve && !order_along_curve;
     
     // the functions we will be seeking to reconstruct are in the span of the basis
     // of the reconstruction space we choose for GMLS, so the error should be very small
-    const double failure_tolerance = 1e-9;
+    // (limited by round-off of the dense solve when it is performed in single precision)
+    const double failure_tolerance = (single_precision_solve) ? 1e-3 : 1e-9;
     
     // Laplacian is a second order differential operator, which we expect to be slightly less accurate
-    const double laplacian_failure_tolerance = 1e-9;
+    const double laplacian_failure_tolerance = (single_precision_solve) ? 1e-2 : 1e-9;
     
     // minimum neighbors for unisolvency is the same as the size of the polynomial basis 
     const int min_neighbors = Compadre::GMLS::getNP(order, dimension);
@@ -195,7 +236,8 @@ bool all_passed = true;
     
     // Point cloud construction for neighbor search
     // CreatePointCloudSearch constructs an object of type PointCloudSearch, but deduces the templates for you
-    auto point_cloud_search(CreatePointCloudSearch(source_coords, dimension));
+    // (optionally building the kd-tree over source sites in Morton order, which neighbor lists do not expose)
+    auto point_cloud_search(CreatePointCloudSearch(source_coords, dimension, -1 /* max_leaf */, order_along_curve));
 
     double epsilon_multiplier = 1.4;
 
@@ -289,11 +331,138 @@ bool all_passed = true;
     
     // power to use in that weighting kernel function
     my_GMLS.setWeightingParameter(2);
+
+    // group target sites by number of neighbors so that each group is solved without padding to the maximum
+    my_GMLS.setNumberOfNeighborBuckets(number_of_neighbor_buckets);
+
+    // solve for target sites in Morton order (alphas are still indexed by target sites as given)
+    my_GMLS.setOrderTargetsAlongCurve(order_along_curve);
+
+    // store and solve the least squares problems in single precision (alphas are still double precision)
+    my_GMLS.setSinglePrecisionSolve(single_precision_solve);
+
+    // solve groups of target sites together, one per SIMD lane (CHOLESKY solver on the host only)
+    my_GMLS.setPackTargetsForSIMD(pack_targets_for_simd);
+
+    // a non-positive number of batches selects the fewest batches that fit in half of the memory
+    // needed to generate alphas for all target sites at once
+    if (number_of_batches <= 0) {
+        number_of_batches = my_GMLS.selectNumberOfBatches(my_GMLS.estimateMemoryFootprint(1)/2);
+        std::cout << "Selected " << number_of_batches << " batches." << std::endl;
+    }
     
+    // streams alphas for each batch into their place in a view for all target sites, 
+    // to be compared against alphas generated with all target sites stored below
+    Kokkos::View<double*, layout_right> streamed_alphas("streamed alphas", 0);
+    if (stream_alphas) {
+        my_GMLS.generatePolynomialCoefficients([&](const SolutionSet<device_memory_space>& batch_solution_set, 
+                    const int first_target_index, const int end_target_index) {
+            auto batch_alphas = batch_solution_set.getAlphas();
+            const size_t offset = batch_solution_set._alpha_index_offset;
+            if (streamed_alphas.extent(0) < offset + batch_alphas.extent(0)) {
+                Kokkos::resize(streamed_alphas, offset + batch_alphas.extent(0));
+            }
+            Kokkos::deep_copy(Kokkos::subview(streamed_alphas, 
+                        Kokkos::make_pair(offset, offset + batch_alphas.extent(0))), batch_alphas);
+        }, number_of_batches, overlap_batches);
+    }
+
     // generate the alphas that to be combined with data for each target operation requested in lro
-    my_GMLS.generateAlphas(number_of_batches, keep_coefficients /* keep polynomial coefficients, only needed for a test later in this program */);
+    // (consecutive batches alternate between two buffers when overlapping batches)
+    my_GMLS.generateAlphas(number_of_batches, keep_coefficients /* keep polynomial coefficients, only needed for a test later in this program */,
+            overlap_batches);
+
+    if (stream_alphas) {
+        auto alphas = my_GMLS.getSolutionSetDevice()->getAlphas();
+        double max_difference = 0;
+        Kokkos::parallel_reduce("compare streamed alphas", Kokkos::RangePolicy<>(0, alphas.extent(0)), 
+                KOKKOS_LAMBDA(const int i, double& t_max_difference) {
+            const double difference = (i < (int)streamed_alphas.extent(0)) ? 
+                std::abs(alphas(i) - streamed_alphas(i)) : std::abs(alphas(i));
+            t_max_difference = (difference > t_max_difference) ? difference : t_max_difference;
+        }, Kokkos::Max<double>(max_difference));
+        if (streamed_alphas.extent(0) != alphas.extent(0) || max_difference > 0) {
+            all_passed = false;
+            std::cout << "Streamed alphas differ from stored alphas by " << max_difference << std::endl;
+        }
+    }
     
     
+    // regenerates alphas for a few target sites after changing their neighborhoods, to be compared 
+    // against alphas generated for all target sites from scratch with the same neighborhoods
+    std::shared_ptr<GMLS> fresh_GMLS;
+    if (regenerate_alphas) {
+        // regenerating without any changes leaves alphas as they were
+        Kokkos::View<int*, Kokkos::HostSpace> unchanged_targets("unchanged targets", 2);
+        unchanged_targets(0) = 1;
+        unchanged_targets(1) = number_target_coords-1;
+        my_GMLS.regeneratePolynomialCoefficients(unchanged_targets, number_of_batches);
+
+        // drop the last neighbor of two target sites, and add a neighbor to a third one, which no longer
+        // fits in its row of the neighbor lists
+        const int grown_target = std::min(5, number_target_coords-1);
+        Kokkos::View<int*, Kokkos::HostSpace> new_number_of_neighbors_list("new number of neighbors list", 
+                number_target_coords);
+        Kokkos::deep_copy(new_number_of_neighbors_list, number_of_neighbors_list);
+        new_number_of_neighbors_list(0)--;
+        new_number_of_neighbors_list(3)--;
+        new_number_of_neighbors_list(grown_target)++;
+        Kokkos::View<int*, Kokkos::HostSpace> new_neighbor_lists("new neighbor lists", neighbor_lists.extent(0)+1);
+        int old_offset = 0, new_offset = 0;
+        for (int i=0; i<number_target_coords; ++i) {
+            for (int j=0; j<std::min(number_of_neighbors_list(i), new_number_of_neighbors_list(i)); ++j) {
+                new_neighbor_lists(new_offset + j) = neighbor_lists(old_offset + j);
+            }
+            if (i == grown_target) {
+                // first source site not already a neighbor
+                int added_neighbor = 0;
+                while (std::find(&neighbor_lists(old_offset), &neighbor_lists(old_offset)+number_of_neighbors_list(i), 
+                            added_neighbor) != &neighbor_lists(old_offset)+number_of_neighbors_list(i)) {
+                    added_neighbor++;
+                }
+                new_neighbor_lists(new_offset + number_of_neighbors_list(i)) = added_neighbor;
+            }
+            old_offset += number_of_neighbors_list(i);
+            new_offset += new_number_of_neighbors_list(i);
+        }
+
+        // only target site 0 and 3 are marked, the grown target site is added since its number of neighbors changed
+        Kokkos::View<bool*, Kokkos::HostSpace> changed_targets("changed targets", number_target_coords);
+        changed_targets(0) = true;
+        changed_targets(3) = true;
+        my_GMLS.regeneratePolynomialCoefficients(changed_targets, new_neighbor_lists, new_number_of_neighbors_list,
+                number_of_batches);
+
+        fresh_GMLS = std::make_shared<GMLS>(VectorOfScalarClonesTaylorPolynomial, VectorPointSample,
+                order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2);
+        fresh_GMLS->setProblemData(new_neighbor_lists, new_number_of_neighbors_list, source_coords_device, 
+                target_coords_device, epsilon_device);
+        fresh_GMLS->addTargets(lro);
+        fresh_GMLS->setWeightingType(WeightingFunctionType::Power);
+        fresh_GMLS->setWeightingParameter(2);
+        fresh_GMLS->generateAlphas(number_of_batches);
+    }
+
+    // solves for the scalar target operations with a ScalarTaylorPolynomial basis, with tiles of targets_per_team
+    // target sites per team (one per thread), to be compared against the alphas generated above
+    std::shared_ptr<GMLS> tiled_GMLS;
+    if (targets_per_team > 0) {
+        tiled_GMLS = std::make_shared<GMLS>(ScalarTaylorPolynomial, PointSample,
+                order, dimension, solver_name.c_str(), problem_name.c_str(), constraint_name.c_str(), 2);
+        tiled_GMLS->setProblemData(neighbor_lists_device, number_of_neighbors_list_device, source_coords_device, 
+                target_coords_device, epsilon_device);
+        tiled_GMLS->addTargets(lro[0]);
+        tiled_GMLS->addTargets(lro[1]);
+        tiled_GMLS->addTargets(lro[2]);
+        tiled_GMLS->setWeightingType(WeightingFunctionType::Power);
+        tiled_GMLS->setWeightingParameter(2);
+        tiled_GMLS->setNumberOfNeighborBuckets(number_of_neighbor_buckets);
+        tiled_GMLS->setOrderTargetsAlongCurve(order_along_curve);
+        tiled_GMLS->setSinglePrecisionSolve(single_precision_solve);
+        tiled_GMLS->setTargetsPerTeam(targets_per_team);
+        tiled_GMLS->generateAlphas(number_of_batches);
+    }
+    
     //! [Setting Up The GMLS Object]
     
     double instantiation_time = timer.seconds();
@@ -332,12 +501,73 @@ bool all_passed = true;
     
     // retrieves polynomial coefficients instead of remapped field
     decltype(output_curl) scalar_coefficients;
-    if (number_of_batches==1)
+    if (keep_coefficients)
         scalar_coefficients = 
             gmls_evaluator.applyFullPolynomialCoefficientsBasisToDataAllComponents<double**, Kokkos::HostSpace>
                 (sampling_data_device);
     
     //! [Apply GMLS Alphas To Data]
+
+    // generates target outputs directly from data without storing alphas (matrix-free), 
+    // to be compared against applying alphas to data above
+    if (apply_to_data) {
+        my_GMLS.generateTargetOutputs(sampling_data_device, number_of_batches);
+
+        auto host_direct_value = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                Kokkos::subview(my_GMLS.getTargetOutput(ScalarPointEvaluation), Kokkos::ALL(), 0));
+        auto host_direct_laplacian = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                Kokkos::subview(my_GMLS.getTargetOutput(LaplacianOfScalarPointEvaluation), Kokkos::ALL(), 0));
+        auto host_direct_gradient = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                my_GMLS.getTargetOutput(GradientOfScalarPointEvaluation));
+
+        all_passed &= outputsAgree("Target outputs generated from data and from applying alphas", 
+                host_direct_value, host_direct_laplacian, host_direct_gradient, 
+                output_value, output_laplacian, output_gradient, 1e-12);
+    }
+    
+    if (regenerate_alphas) {
+        Evaluator fresh_gmls_evaluator(fresh_GMLS.get());
+        auto fresh_output_value = fresh_gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, 
+                Kokkos::HostSpace>(sampling_data_device, ScalarPointEvaluation);
+        auto fresh_output_laplacian = fresh_gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, 
+                Kokkos::HostSpace>(sampling_data_device, LaplacianOfScalarPointEvaluation);
+        auto fresh_output_gradient = fresh_gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, 
+                Kokkos::HostSpace>(sampling_data_device, GradientOfScalarPointEvaluation);
+
+        all_passed &= outputsAgree("Regenerated alphas and alphas generated from scratch", 
+                fresh_output_value, fresh_output_laplacian, fresh_output_gradient, 
+                output_value, output_laplacian, output_gradient, 1e-12);
+    }
+    
+    if (targets_per_team > 0) {
+        Evaluator tiled_gmls_evaluator(tiled_GMLS.get());
+        auto tiled_output_value = tiled_gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, 
+                Kokkos::HostSpace>(sampling_data_device, ScalarPointEvaluation);
+        auto tiled_output_laplacian = tiled_gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double*, 
+                Kokkos::HostSpace>(sampling_data_device, LaplacianOfScalarPointEvaluation);
+        auto tiled_output_gradient = tiled_gmls_evaluator.applyAlphasToDataAllComponentsAllTargetSites<double**, 
+                Kokkos::HostSpace>(sampling_data_device, GradientOfScalarPointEvaluation);
+
+        // alphas of a single precision solve only agree to single precision
+        const double tolerance = (single_precision_solve) ? 1e-4 : 1e-10;
+        all_passed &= outputsAgree("Alphas solved for with tiles of target sites", 
+                tiled_output_value, tiled_output_laplacian, tiled_output_gradient, 
+                output_value, output_laplacian, output_gradient, tolerance);
+
+        // target outputs generated from data by the same kernel are compared as well
+        if (apply_to_data) {
+            tiled_GMLS->generateTargetOutputs(sampling_data_device, number_of_batches);
+            auto host_tiled_direct_value = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                    Kokkos::subview(tiled_GMLS->getTargetOutput(ScalarPointEvaluation), Kokkos::ALL(), 0));
+            auto host_tiled_direct_laplacian = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                    Kokkos::subview(tiled_GMLS->getTargetOutput(LaplacianOfScalarPointEvaluation), Kokkos::ALL(), 0));
+            auto host_tiled_direct_gradient = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                    tiled_GMLS->getTargetOutput(GradientOfScalarPointEvaluation));
+            all_passed &= outputsAgree("Target outputs generated from data with tiles of target sites", 
+                    host_tiled_direct_value, host_tiled_direct_laplacian, host_tiled_direct_gradient, 
+                    output_value, output_laplacian, output_gradient, tolerance);
+        }
+    }
     
     Kokkos::fence(); // let application of alphas to data finish before using results
     Kokkos::Profiling::popRegion();
@@ -360,7 +590,7 @@ bool all_passed = true;
         // this is a test that the scalar_coefficients 2d array returned hold valid entries
         // scalar_coefficients(i,1)*1./epsilon(i) is equivalent to the target operation acting 
         // on the polynomials applied to the polynomial coefficients
-        double GMLS_GradX = (number_of_batches==1) ? scalar_coefficients(i,1)*1./epsilon(i) : output_gradient(i,0);
+        double GMLS_GradX = (keep_coefficients) ? scalar_coefficients(i,1)*1./epsilon(i) : output_gradient(i,0);
     
         // load partial y from gradient
         double GMLS_GradY = (dimension>1) ? output_gradient(i,1) : 0;
@@ -50,6 +50,7 @@ bool all_passed = true;
     auto constraint_name = clp.constraint_name;
     auto solver_name = clp.solver_name;
     auto problem_name = clp.problem_name;
+    auto overlap_batches = clp.overlap_batches;
 
     // the functions we will be seeking to reconstruct are in the span of the basis
     // of the reconstruction space we choose for GMLS, so the error should be very small
@@ -252,7 +253,12 @@ bool all_passed = true;
     vector_divfree_basis_gmls.setWeightingParameter(2);
 
     // generate the alphas that to be combined with data for each target operation requested in lro
-    vector_divfree_basis_gmls.generateAlphas(15 /* # batches */);
+    if (overlap_batches) {
+        // consecutive batches alternate between two buffers, overlapping where the backend allows it
+        vector_divfree_basis_gmls.generateAlphas(15 /* # batches */, false /* keep coefficients */, true /* overlap batches */);
+    } else {
+        vector_divfree_basis_gmls.generateAlphas(15 /* # batches */);
+    }
 
     //! [Setting Up The GMLS Object]
 
@@ -217,11 +217,21 @@ bool all_passed = true;
     // set source sites once for all targets
     my_GMLS.setSourceSites(source_coords_device);
 
+    // set up storage once for all targets, since each target has the same operations and
+    // no more than the estimated upper bound on the number of neighbors
+    my_GMLS.setupPolynomialCoefficients(1 /*number of batches*/,
+            PointCloudSearch<decltype(source_coords)>::getEstimatedNumberNeighborsUpperBound(min_neighbors, dimension, 1.5),
+            1 /*one target at a time*/);
+
         
     // Point cloud construction for neighbor search
     // CreatePointCloudSearch constructs an object of type PointCloudSearch, but deduces the templates for you
     auto point_cloud_search(CreatePointCloudSearch(source_coords, dimension));
 
+    // a copy of the previous target's solution set, whose alphas must not be overwritten by the next target
+    auto previous_solution_set = *(my_GMLS.getSolutionSetDevice());
+    Kokkos::View<double*> expected_previous_alphas("expected previous alphas", 0);
+
     // loop through the target sites
     for (int i=0; i<number_target_coords; i++) {
         timer.reset();
@@ -300,6 +310,24 @@ bool all_passed = true;
         std::cout << "Took " << instantiation_time << "s to complete alphas generation." << std::endl;
         Kokkos::fence(); // let generateAlphas finish up before using alphas
 
+        // alphas of the previous target are still referenced, so they were not reused as storage
+        if (i > 0) {
+            auto previous_alphas = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                    previous_solution_set.getAlphas());
+            auto host_expected_previous_alphas = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), 
+                    expected_previous_alphas);
+            for (size_t j=0; j<host_expected_previous_alphas.extent(0); ++j) {
+                if (previous_alphas(j) != host_expected_previous_alphas(j)) {
+                    all_passed = false;
+                    std::cout << i << " Overwrote alphas of the previous target site." << std::endl;
+                    break;
+                }
+            }
+        }
+        previous_solution_set = *(my_GMLS.getSolutionSetDevice());
+        Kokkos::resize(expected_previous_alphas, previous_solution_set.getAlphas().extent(0));
+        Kokkos::deep_copy(expected_previous_alphas, previous_solution_set.getAlphas());
+
         
         //! [Apply GMLS Alphas To Data]
         
@@ -50,6 +50,8 @@ bool all_passed = true;
     auto constraint_name = clp.constraint_name;
     auto solver_name = clp.solver_name;
     auto problem_name = clp.problem_name;
+    auto number_of_batches = clp.number_of_batches;
+    bool keep_coefficients = number_of_batches==1;
     
     // the functions we will be seeking to reconstruct are in the span of the basis
     // of the reconstruction space we choose for GMLS, so the error should be very small
@@ -280,8 +282,26 @@ bool all_passed = true;
     // power to use in that weighting kernel function
     my_GMLS.setWeightingParameter(2);
     
+    // memory estimated before any alphas are generated matches what is allocated for them (only one of the 
+    // identical diagonal blocks of P is solved for unless polynomial coefficients are kept)
+    const std::size_t estimated_bytes = my_GMLS.estimateMemoryFootprint(number_of_batches, false /*overlap_batches*/, 
+            false /*stream_alphas*/, keep_coefficients);
+    my_GMLS.setupPolynomialCoefficients(number_of_batches, 0, 0, keep_coefficients);
+    if (my_GMLS.getPolynomialCoefficientsStorageBytes() != estimated_bytes) {
+        all_passed = false;
+        std::cout << "Estimated " << estimated_bytes << " bytes, but " << my_GMLS.getPolynomialCoefficientsStorageBytes() 
+            << " bytes were allocated." << std::endl;
+    }
+    my_GMLS.clearPolynomialCoefficientsStorage();
+
     // generate the alphas that to be combined with data for each target operation requested in lro
-    my_GMLS.generateAlphas(1, true /* keep polynomial coefficients, only needed for a test later in this program */);
+    my_GMLS.generateAlphas(number_of_batches, keep_coefficients /* keep polynomial coefficients, only needed for a test later in this program */);
+
+    // and the estimate does not depend on the generation that came before it
+    if (my_GMLS.estimateMemoryFootprint(number_of_batches, false, false, keep_coefficients) != estimated_bytes) {
+        all_passed = false;
+        std::cout << "Estimate after generating alphas differs from " << estimated_bytes << " bytes." << std::endl;
+    }
     
     
     //! [Setting Up The GMLS Object]
@@ -321,11 +341,14 @@ bool all_passed = true;
             (gradient_sampling_data_device, GradientOfVectorPointEvaluation);
     
     // retrieves polynomial coefficients instead of remapped field
-    auto scalar_coefficients = gmls_evaluator.applyFullPolynomialCoefficientsBasisToDataAllComponents<double**, Kokkos::HostSpace>
-            (sampling_data_device);
+    decltype(output_curl) scalar_coefficients, vector_coefficients;
+    if (keep_coefficients) {
+        scalar_coefficients = gmls_evaluator.applyFullPolynomialCoefficientsBasisToDataAllComponents<double**, Kokkos::HostSpace>
+                (sampling_data_device);
 
-    auto vector_coefficients = gmls_evaluator.applyFullPolynomialCoefficientsBasisToDataAllComponents<double**, Kokkos::HostSpace>
-            (gradient_sampling_data_device);
+        vector_coefficients = gmls_evaluator.applyFullPolynomialCoefficientsBasisToDataAllComponents<double**, Kokkos::HostSpace>
+                (gradient_sampling_data_device);
+    }
     
     //! [Apply GMLS Alphas To Data]
     
@@ -347,7 +370,7 @@ bool all_passed = true;
         // this is a test that the scalar_coefficients 2d array returned hold valid entries
         // scalar_coefficients(i,1)*1./epsilon(i) is equivalent to the target operation acting 
         // on the polynomials applied to the polynomial coefficients
-        double GMLS_GradX = scalar_coefficients(i,1)*1./epsilon(i);
+        double GMLS_GradX = (keep_coefficients) ? scalar_coefficients(i,1)*1./epsilon(i) : output_gradient(i,0);
     
         // load partial y from gradient
         double GMLS_GradY = (dimension>1) ? output_gradient(i,1) : 0;
@@ -370,11 +393,13 @@ bool all_passed = true;
         double GMLS_GradXZ = (dimension>2) ? output_hessian(i,0*dimension+2) : 0;
         double GMLS_GradYX = (dimension>1) ? output_hessian(i,1*dimension+0) : 0;
         // replace YY with with vector_coefficients as test that vector_coefficients hold valid entries
-        double GMLS_GradYY = (dimension>1) ? vector_coefficients(i,1*NP+2)*1./epsilon(i) : 0;
+        double GMLS_GradYY = (dimension>1) ? ((keep_coefficients) ? vector_coefficients(i,1*NP+2)*1./epsilon(i) 
+                : output_hessian(i,1*dimension+1)) : 0;
         double GMLS_GradYZ = (dimension>2) ? output_hessian(i,1*dimension+2) : 0;
         double GMLS_GradZX = (dimension>2) ? output_hessian(i,2*dimension+0) : 0;
         // replace ZY with with vector_coefficients as test that vector_coefficients hold valid entries
-        double GMLS_GradZY = (dimension>2) ? vector_coefficients(i,2*NP+2)*1./epsilon(i) : 0;
+        double GMLS_GradZY = (dimension>2) ? ((keep_coefficients) ? vector_coefficients(i,2*NP+2)*1./epsilon(i) 
+                : output_hessian(i,2*dimension+1)) : 0;
         double GMLS_GradZZ = (dimension>2) ? output_hessian(i,2*dimension+2) : 0;
     
         // target site i's coordinate
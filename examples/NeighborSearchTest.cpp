@@ -5,6 +5,8 @@
 #include <Compadre_Config.h>
 #include <Compadre_GMLS.hpp>
 #include <Compadre_PointCloudSearch.hpp>
+#include <Compadre_BVHSearch.hpp>
+#include <Compadre_CellListSearch.hpp>
 #include <Compadre_KokkosParser.hpp>
 
 #ifdef COMPADRE_USE_MPI
@@ -27,6 +29,48 @@ std::multimap<T2,T1> invert_map(const std::map<T1,T2> &original_map)
 
 using namespace Compadre;
 
+//! Searches with views on the device, then copies the results back for checking on the host.
+//! Does a knn search if min_neighbors > 0, and otherwise a radius search using epsilon.
+template <typename search_type, typename target_view_type>
+size_t searchOnDevice(search_type& search, target_view_type target_coords, 
+        Kokkos::View<int*, Kokkos::DefaultHostExecutionSpace>& neighbor_lists, 
+        Kokkos::View<int*, Kokkos::DefaultHostExecutionSpace> number_neighbors_list, 
+        Kokkos::View<double*, Kokkos::DefaultHostExecutionSpace> epsilon, const int min_neighbors) {
+
+    auto d_target_coords = Kokkos::create_mirror_view_and_copy(device_memory_space(), target_coords);
+    Kokkos::View<int*, device_memory_space> d_neighbor_lists("neighbor lists", 0);
+    Kokkos::View<int*, device_memory_space> d_number_neighbors_list("number of neighbors list", 
+            number_neighbors_list.extent(0));
+    Kokkos::View<double*, device_memory_space> d_epsilon("h supports", epsilon.extent(0));
+    Kokkos::deep_copy(d_epsilon, epsilon);
+
+    // start with a dry-run, but without enough room to store the results
+    size_t total_num_neighbors = (min_neighbors > 0) ?
+        search.generateCRNeighborListsFromKNNSearch(true /* dry-run for sizes */,
+            d_target_coords, d_neighbor_lists, d_number_neighbors_list, d_epsilon, min_neighbors, 1.5 /* cutoff_multiplier */) :
+        search.generateCRNeighborListsFromRadiusSearch(true /* dry run */,
+            d_target_coords, d_neighbor_lists, d_number_neighbors_list, d_epsilon);
+    printf("total num neighbors: %lu\n", total_num_neighbors);
+
+    // resize neighbor lists to be large enough to hold the results
+    Kokkos::resize(d_neighbor_lists, total_num_neighbors);
+
+    // search again, now that we know that there is enough room to store the results
+    if (min_neighbors > 0) {
+        search.generateCRNeighborListsFromKNNSearch(false /*not dry run*/, 
+            d_target_coords, d_neighbor_lists, d_number_neighbors_list, d_epsilon, min_neighbors, 1.5 /* cutoff_multiplier */);
+    } else {
+        search.generateCRNeighborListsFromRadiusSearch(false /* dry run */,
+            d_target_coords, d_neighbor_lists, d_number_neighbors_list, d_epsilon);
+    }
+
+    Kokkos::resize(neighbor_lists, total_num_neighbors);
+    Kokkos::deep_copy(neighbor_lists, d_neighbor_lists);
+    Kokkos::deep_copy(number_neighbors_list, d_number_neighbors_list);
+    Kokkos::deep_copy(epsilon, d_epsilon);
+    return total_num_neighbors;
+}
+
 int main (int argc, char* args[]) {
 
 // initializes MPI (if available) with command line arguments given
@@ -52,10 +96,20 @@ bool all_passed = true;
             search_type = arg5toi;
         }
     }
+    // 0 - kd-tree (host), 1 - bounding volume hierarchy (device), 2 - cell list (device), 
+    // 3 - cell list if sources are quasi-uniform, otherwise bounding volume hierarchy (device)
+    int search_backend = 0;
+    if (argc >= 6) {
+        int arg6toi = atoi(args[5]);
+        if (arg6toi >= 0) {
+            search_backend = arg6toi;
+        }
+    }
     bool do_radius_search = (search_type==0);
     bool do_knn_search = (search_type==1);
     printf("do_radius_search: %d\n", do_radius_search);
     printf("do_knn_search: %d\n", do_knn_search);
+    printf("search_backend: %d\n", search_backend);
 
     // check if 4 arguments are given from the command line
     //  multiplier times h spacing for search
@@ -183,22 +237,35 @@ bool all_passed = true;
             
             // query the point cloud to generate the neighbor lists using a radius search
 
-            // start with a dry-run, but without enough room to store the results
-            size_t total_num_neighbors = point_cloud_search.generateCRNeighborListsFromRadiusSearch(true /* dry run */,
-                target_coords, neighbor_lists, number_neighbors_list, epsilon);
-            printf("total num neighbors: %lu\n", total_num_neighbors);
-
-            // resize neighbor lists to be large enough to hold the results
-            Kokkos::resize(neighbor_lists, total_num_neighbors);
-
-            // search again, now that we know that there is enough room to store the results
-            point_cloud_search.generateCRNeighborListsFromRadiusSearch(false /* dry run */,
-                target_coords, neighbor_lists, number_neighbors_list, epsilon);
+            size_t total_num_neighbors = 0;
+            if (search_backend > 0) {
+                auto d_source_coords = Kokkos::create_mirror_view_and_copy(device_memory_space(), source_coords);
+                auto bvh_search(CreateBVHSearch(d_source_coords, dimension));
+                auto cell_list_search(CreateCellListSearch(d_source_coords, dimension));
+                // backend 3 chooses the cell list for quasi-uniform sources and the bvh otherwise
+                const bool use_cell_list = (search_backend==2) || (search_backend==3 && cell_list_search.isQuasiUniform());
+                printf("device search: %s\n", use_cell_list ? "cell list" : "bvh");
+                total_num_neighbors = use_cell_list ? 
+                    searchOnDevice(cell_list_search, target_coords, neighbor_lists, number_neighbors_list, epsilon, 0 /* radius search */) :
+                    searchOnDevice(bvh_search, target_coords, neighbor_lists, number_neighbors_list, epsilon, 0 /* radius search */);
+            } else {
+                // start with a dry-run, but without enough room to store the results
+                total_num_neighbors = point_cloud_search.generateCRNeighborListsFromRadiusSearch(true /* dry run */,
+                    target_coords, neighbor_lists, number_neighbors_list, epsilon);
+                printf("total num neighbors: %lu\n", total_num_neighbors);
+
+                // resize neighbor lists to be large enough to hold the results
+                Kokkos::resize(neighbor_lists, total_num_neighbors);
+
+                // search again, now that we know that there is enough room to store the results
+                point_cloud_search.generateCRNeighborListsFromRadiusSearch(false /* dry run */,
+                    target_coords, neighbor_lists, number_neighbors_list, epsilon);
+            }
 
             auto nla(CreateNeighborLists(neighbor_lists, number_neighbors_list));
 
             double radius_search_time = timer.seconds();
-            printf("nanoflann search time: %f s\n", radius_search_time);
+            printf("%s search time: %f s\n", (search_backend > 0) ? "device" : "nanoflann", radius_search_time);
 
             // convert point cloud search to vector of maps
             timer.reset();
@@ -532,17 +599,30 @@ bool all_passed = true;
             
             // query the point cloud to generate the neighbor lists using a KNN search
 
-            // start with a dry-run, but without enough room to store the results
-            auto total_num_neighbors = point_cloud_search.generateCRNeighborListsFromKNNSearch(true /* dry-run for sizes */,
-                    target_coords, neighbor_lists, number_neighbors_list, epsilon, min_neighbors, 1.5 /* cutoff_multiplier */);
-            printf("total num neighbors: %lu\n", total_num_neighbors);
-
-            // resize with room to store results
-            Kokkos::resize(neighbor_lists, total_num_neighbors);
-
-            // real knn search with space to store
-            point_cloud_search.generateCRNeighborListsFromKNNSearch(false /*not dry run*/, 
-                    target_coords, neighbor_lists, number_neighbors_list, epsilon, min_neighbors, 1.5 /* cutoff_multiplier */);
+            size_t total_num_neighbors = 0;
+            if (search_backend > 0) {
+                auto d_source_coords = Kokkos::create_mirror_view_and_copy(device_memory_space(), source_coords);
+                auto bvh_search(CreateBVHSearch(d_source_coords, dimension));
+                auto cell_list_search(CreateCellListSearch(d_source_coords, dimension));
+                // backend 3 chooses the cell list for quasi-uniform sources and the bvh otherwise
+                const bool use_cell_list = (search_backend==2) || (search_backend==3 && cell_list_search.isQuasiUniform());
+                printf("device search: %s\n", use_cell_list ? "cell list" : "bvh");
+                total_num_neighbors = use_cell_list ? 
+                    searchOnDevice(cell_list_search, target_coords, neighbor_lists, number_neighbors_list, epsilon, min_neighbors) :
+                    searchOnDevice(bvh_search, target_coords, neighbor_lists, number_neighbors_list, epsilon, min_neighbors);
+            } else {
+                // start with a dry-run, but without enough room to store the results
+                total_num_neighbors = point_cloud_search.generateCRNeighborListsFromKNNSearch(true /* dry-run for sizes */,
+                        target_coords, neighbor_lists, number_neighbors_list, epsilon, min_neighbors, 1.5 /* cutoff_multiplier */);
+                printf("total num neighbors: %lu\n", total_num_neighbors);
+
+                // resize with room to store results
+                Kokkos::resize(neighbor_lists, total_num_neighbors);
+
+                // real knn search with space to store
+                point_cloud_search.generateCRNeighborListsFromKNNSearch(false /*not dry run*/, 
+                        target_coords, neighbor_lists, number_neighbors_list, epsilon, min_neighbors, 1.5 /* cutoff_multiplier */);
+            }
 
             auto nla(CreateNeighborLists(neighbor_lists, number_neighbors_list));
 
@@ -311,6 +311,35 @@ TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Same_LDA_NDA_Lar
     EXPECT_NEAR(-0.803571428571429, B2(2,3), 1e-14);
 }
 
+TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Blocked_Same_LDA_NDA_Larger_NRHS_LRA_LRB_LRX) {
+    int M=3, N=3, NRHS=4, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=4;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    // block size of 2 gives one full block and one partial block
+    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, M, N, NRHS, num_matrices, 2 /*block size*/);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                  0  -0.071428571428571  -0.035714285714286  -0.053571428571429
+    //                  0  -0.285714285714286  -0.142857142857143  -0.214285714285714
+    //                  0  -0.071428571428571  -0.535714285714286  -0.803571428571429
+    //               ]
+    host_scratch_matrix_right_type B2(B.data() + 1*ldb*ndb, ldb, ndb);
+    EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, B2(0,1), 1e-14);
+    EXPECT_NEAR(-0.285714285714286, B2(1,1), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, B2(2,1), 1e-14);
+    EXPECT_NEAR(-0.035714285714286, B2(0,2), 1e-14);
+    EXPECT_NEAR(-0.142857142857143, B2(1,2), 1e-14);
+    EXPECT_NEAR(-0.535714285714286, B2(2,2), 1e-14);
+    EXPECT_NEAR(-0.053571428571429, B2(0,3), 1e-14);
+    EXPECT_NEAR(-0.214285714285714, B2(1,3), 1e-14);
+    EXPECT_NEAR(-0.803571428571429, B2(2,3), 1e-14);
+}
+
 TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Larger_LDA_NDA_LRA_LRB_LRX) {
     // lda and nda larger than M and N
     int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
@@ -671,6 +700,324 @@ TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Larger_LDB_NDB_L
     EXPECT_NEAR(-0.803571428571429, B2(2,3), 1e-14);
 }
 
+//
+// Cholesky Tests
+// The fixture's A is negative definite, so it is only solved through the pivoted fallback,
+// while -A is positive definite and is solved by the Cholesky factorization
+//
+
+TEST_F (LinearAlgebraTest, Square_FullRank_batchCholeskySolve_Fallback_LRA_LLB) {
+    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = [
+    //                   0  -0.071428571428571  -0.035714285714286
+    //                   0  -0.285714285714286  -0.142857142857143
+    //                   0  -0.071428571428571  -0.535714285714286
+    //               ]
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        host_scratch_matrix_right_type B2(B.data() + mat_num*ldb*ndb, ldb, ndb);
+        EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+        EXPECT_NEAR(-0.071428571428571, B2(0,1), 1e-14);
+        EXPECT_NEAR(-0.285714285714286, B2(1,1), 1e-14);
+        EXPECT_NEAR(-0.071428571428571, B2(2,1), 1e-14);
+        EXPECT_NEAR(-0.035714285714286, B2(0,2), 1e-14);
+        EXPECT_NEAR(-0.142857142857143, B2(1,2), 1e-14);
+        EXPECT_NEAR(-0.535714285714286, B2(2,2), 1e-14);
+    }
+}
+
+TEST_F (LinearAlgebraTest, Square_FullRank_batchCholeskySolve_Mixed_Larger_LDB_NDB_Larger_NRHS_LRA_LLB) {
+    int M=3, N=3, NRHS=4, num_matrices=3, rank=3;
+    int lda=3, nda=3;
+    int ldb=8, ndb=12; // relative to layout left
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    // negate A for the first and last matrix, making them positive definite
+    for (int i=0; i<lda*nda; ++i) {
+        A(i) *= -1;
+        A((num_matrices-1)*lda*nda + i) *= -1;
+    }
+    Kokkos::deep_copy(A_d, A);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = (+/-) [
+    //                  0  -0.071428571428571  -0.035714285714286  -0.053571428571429
+    //                  0  -0.285714285714286  -0.142857142857143  -0.214285714285714
+    //                  0  -0.071428571428571  -0.535714285714286  -0.803571428571429
+    //               ]
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        const double sign = (mat_num==1) ? 1.0 : -1.0;
+        host_scratch_matrix_right_type B2(B.data() + mat_num*ldb*ndb, ldb, ndb);
+        EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+        EXPECT_NEAR(sign*-0.071428571428571, B2(0,1), 1e-14);
+        EXPECT_NEAR(sign*-0.285714285714286, B2(1,1), 1e-14);
+        EXPECT_NEAR(sign*-0.071428571428571, B2(2,1), 1e-14);
+        EXPECT_NEAR(sign*-0.035714285714286, B2(0,2), 1e-14);
+        EXPECT_NEAR(sign*-0.142857142857143, B2(1,2), 1e-14);
+        EXPECT_NEAR(sign*-0.535714285714286, B2(2,2), 1e-14);
+        EXPECT_NEAR(sign*-0.053571428571429, B2(0,3), 1e-14);
+        EXPECT_NEAR(sign*-0.214285714285714, B2(1,3), 1e-14);
+        EXPECT_NEAR(sign*-0.803571428571429, B2(2,3), 1e-14);
+    }
+}
+
+TEST_F (LinearAlgebraTest, Square_FullRank_batchCholeskySolve_Mixed_Lower_Triangle_LRA_LLB) {
+    int M=3, N=3, NRHS=3, num_matrices=3, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    // negate A for the first and last matrix, making them positive definite, and clear the upper
+    // triangle of every matrix (as is assembled by symmetricRankKUpdateAndScaleRows)
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        host_scratch_matrix_right_type this_A(A.data() + mat_num*lda*nda, lda, nda);
+        for (int i=0; i<N; ++i) {
+            for (int j=0; j<N; ++j) {
+                if (j>i) this_A(i,j) = 0;
+                else if (mat_num!=1) this_A(i,j) *= -1;
+            }
+        }
+    }
+    Kokkos::deep_copy(A_d, A);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = (+/-) [
+    //                  0  -0.071428571428571  -0.035714285714286
+    //                  0  -0.285714285714286  -0.142857142857143
+    //                  0  -0.071428571428571  -0.535714285714286
+    //               ]
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        const double sign = (mat_num==1) ? 1.0 : -1.0;
+        host_scratch_matrix_right_type B2(B.data() + mat_num*ldb*ndb, ldb, ndb);
+        EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+        EXPECT_NEAR(sign*-0.071428571428571, B2(0,1), 1e-14);
+        EXPECT_NEAR(sign*-0.285714285714286, B2(1,1), 1e-14);
+        EXPECT_NEAR(sign*-0.071428571428571, B2(2,1), 1e-14);
+        EXPECT_NEAR(sign*-0.035714285714286, B2(0,2), 1e-14);
+        EXPECT_NEAR(sign*-0.142857142857143, B2(1,2), 1e-14);
+        EXPECT_NEAR(sign*-0.535714285714286, B2(2,2), 1e-14);
+    }
+}
+
+#if !defined(COMPADRE_USE_CUDA)
+TEST_F (LinearAlgebraTest, Square_FullRank_batchCholeskySolve_Mixed_SIMDPacked_Larger_LDB_NDB_Larger_NRHS_LRA_LLB) {
+    int M=3, N=3, NRHS=4, num_matrices=11, rank=3; // more than one pack, and a partial pack
+    int lda=3, nda=3;
+    int ldb=8, ndb=12; // relative to layout left
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, false/*B is LL*/);
+    // negate A for the first and last matrix, making them positive definite
+    for (int i=0; i<lda*nda; ++i) {
+        A(i) *= -1;
+        A((num_matrices-1)*lda*nda + i) *= -1;
+    }
+    Kokkos::deep_copy(A_d, A);
+    GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left>(pm, A_d.data(), lda, nda, B_d.data(), ldb, ndb, N, NRHS, num_matrices, true/*pack for SIMD*/);
+    Kokkos::deep_copy(B, B_d);
+    Kokkos::fence();
+    // solution: X = (+/-) [
+    //                  0  -0.071428571428571  -0.035714285714286  -0.053571428571429
+    //                  0  -0.285714285714286  -0.142857142857143  -0.214285714285714
+    //                  0  -0.071428571428571  -0.535714285714286  -0.803571428571429
+    //               ]
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        const double sign = (mat_num==0 || mat_num==num_matrices-1) ? -1.0 : 1.0;
+        host_scratch_matrix_right_type B2(B.data() + mat_num*ldb*ndb, ldb, ndb);
+        EXPECT_NEAR(               0.0, B2(0,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(1,0), 1e-14);
+        EXPECT_NEAR(               0.0, B2(2,0), 1e-14);
+        EXPECT_NEAR(sign*-0.071428571428571, B2(0,1), 1e-14);
+        EXPECT_NEAR(sign*-0.285714285714286, B2(1,1), 1e-14);
+        EXPECT_NEAR(sign*-0.071428571428571, B2(2,1), 1e-14);
+        EXPECT_NEAR(sign*-0.035714285714286, B2(0,2), 1e-14);
+        EXPECT_NEAR(sign*-0.142857142857143, B2(1,2), 1e-14);
+        EXPECT_NEAR(sign*-0.535714285714286, B2(2,2), 1e-14);
+        EXPECT_NEAR(sign*-0.053571428571429, B2(0,3), 1e-14);
+        EXPECT_NEAR(sign*-0.214285714285714, B2(1,3), 1e-14);
+        EXPECT_NEAR(sign*-0.803571428571429, B2(2,3), 1e-14);
+    }
+}
+#endif
+
+TEST_F (LinearAlgebraTest, Square_FullRank_serialQRPivotingSolve_LRA_LRX) {
+    int M=3, N=3, NRHS=3, num_matrices=1, rank=3;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    // B = diag(0, 1, 2) is given by its diagonal, and X is N x M (as solved for by each thread of TiledStandardGMLS)
+    host_scratch_matrix_right_type this_A(A.data(), lda, nda);
+    Kokkos::View<double*, Kokkos::HostSpace> b("b", M), w_fast("w_fast", M + 2*N), w_slow("w_slow", N*M);
+    Kokkos::View<double**, layout_right, Kokkos::HostSpace> X("X", N, M), U("U", M, N), V("V", N, N);
+    Kokkos::View<int*, Kokkos::HostSpace> p("p", N);
+    for (int i=0; i<M; ++i) b(i) = B(i*ndb+i);
+    GMLS_LinearAlgebra::serialQRPivotingSolve(this_A, b, X, U, V, p, w_fast, w_slow, M, N);
+    // solution: X = [
+    //                   0  -0.071428571428571  -0.035714285714286
+    //                   0  -0.285714285714286  -0.142857142857143
+    //                   0  -0.071428571428571  -0.535714285714286
+    //               ]
+    EXPECT_NEAR(               0.0, X(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, X(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, X(2,0), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, X(0,1), 1e-14);
+    EXPECT_NEAR(-0.285714285714286, X(1,1), 1e-14);
+    EXPECT_NEAR(-0.071428571428571, X(2,1), 1e-14);
+    EXPECT_NEAR(-0.035714285714286, X(0,2), 1e-14);
+    EXPECT_NEAR(-0.142857142857143, X(1,2), 1e-14);
+    EXPECT_NEAR(-0.535714285714286, X(2,2), 1e-14);
+}
+
+TEST_F (LinearAlgebraTest, Square_RankDeficient_serialQRPivotingSolve_LRA_LRX) {
+    int M=3, N=3, NRHS=3, num_matrices=1, rank=2;
+    int lda=3, nda=3;
+    int ldb=3, ndb=3;
+    SetUp(lda, nda, ldb, ndb, M, N, NRHS, num_matrices, rank, true/*A is LR*/, true/*B is LR*/);
+    host_scratch_matrix_right_type this_A(A.data(), lda, nda);
+    Kokkos::View<double*, Kokkos::HostSpace> b("b", M), w_fast("w_fast", M + 2*N), w_slow("w_slow", N*M);
+    Kokkos::View<double**, layout_right, Kokkos::HostSpace> X("X", N, M), U("U", M, N), V("V", N, N);
+    Kokkos::View<int*, Kokkos::HostSpace> p("p", N);
+    for (int i=0; i<M; ++i) b(i) = B(i*ndb+i);
+    GMLS_LinearAlgebra::serialQRPivotingSolve(this_A, b, X, U, V, p, w_fast, w_slow, M, N);
+    // minimum norm solution: X = pinv(A)*B = [
+    //                   0   0.011111111111111   0.005555555555556
+    //                   0   0.022222222222222   0.011111111111111
+    //                   0   0.055555555555556  -0.472222222222222
+    //               ]
+    EXPECT_NEAR(               0.0, X(0,0), 1e-14);
+    EXPECT_NEAR(               0.0, X(1,0), 1e-14);
+    EXPECT_NEAR(               0.0, X(2,0), 1e-14);
+    EXPECT_NEAR( 0.011111111111111, X(0,1), 1e-14);
+    EXPECT_NEAR( 0.022222222222222, X(1,1), 1e-14);
+    EXPECT_NEAR( 0.055555555555556, X(2,1), 1e-14);
+    EXPECT_NEAR( 0.005555555555556, X(0,2), 1e-14);
+    EXPECT_NEAR( 0.011111111111111, X(1,2), 1e-14);
+    EXPECT_NEAR(-0.472222222222222, X(2,2), 1e-14);
+}
+
+//
+// Host UTV Kernels vs. TeamVector UTV Kernels
+//
+// On the host with one thread per team, batchQRPivotingSolve uses the forked host kernels,
+// so its solutions are compared against those of the TeamVector kernels they were forked from
+//
+
+// fills num_matrices copies of an M x N matrix A, whose last column is a combination of the first 
+// two when rank_deficient, and of an M x NRHS right hand side B (in a ldb=max(M,N) by NRHS layout right block)
+void fillUTVComparisonProblem(Kokkos::View<double*, host_execution_space>& A, Kokkos::View<double*, host_execution_space>& B,
+        const int M, const int N, const int NRHS, const int num_matrices, const bool rank_deficient) {
+    const int ldb = (M > N) ? M : N;
+    Kokkos::resize(A, M*N*num_matrices);
+    Kokkos::resize(B, ldb*NRHS*num_matrices);
+    Kokkos::deep_copy(A, 0.0);
+    Kokkos::deep_copy(B, 0.0);
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        host_scratch_matrix_right_type this_A(A.data() + mat_num*M*N, M, N);
+        host_scratch_matrix_right_type this_B(B.data() + mat_num*ldb*NRHS, ldb, NRHS);
+        for (int i=0; i<M; ++i) {
+            for (int j=0; j<N; ++j) {
+                this_A(i,j) = std::sin(1.3*i + 0.7*j + 0.1*mat_num) + ((i==j) ? 2.0 : 0.0);
+            }
+            if (rank_deficient) {
+                this_A(i,N-1) = this_A(i,0) - 2.0*this_A(i,1);
+            }
+            for (int j=0; j<NRHS; ++j) {
+                this_B(i,j) = std::cos(0.9*i - 0.4*j + 0.2*mat_num);
+            }
+        }
+    }
+}
+
+// solves each problem with the TeamVector UTV kernels, regardless of the team size
+void teamVectorQRPivotingSolve(Kokkos::View<double*, device_execution_space> A_d, 
+        Kokkos::View<double*, device_execution_space> B_d, const int M, const int N, const int NRHS, const int num_matrices) {
+    typedef KokkosBatched::Algo::UTV::Unblocked algo_tag_type;
+    const int ldb = (M > N) ? M : N;
+    Kokkos::View<double***, layout_right, device_execution_space> U("U", num_matrices, M, N), V("V", num_matrices, N, N);
+    Kokkos::View<double**, layout_right, device_execution_space> w_fast("w_fast", num_matrices, 3*M), 
+        w_slow("w_slow", num_matrices, N*NRHS);
+    Kokkos::View<int**, layout_right, device_execution_space> p("p", num_matrices, N);
+    Kokkos::parallel_for(Kokkos::TeamPolicy<device_execution_space>(num_matrices, Kokkos::AUTO), 
+            KOKKOS_LAMBDA(const member_type& member) {
+        const int k = member.league_rank();
+        scratch_matrix_right_type A_k(A_d.data() + k*M*N, M, N);
+        scratch_matrix_right_type B_k(B_d.data() + k*ldb*NRHS, ldb, NRHS);
+        auto U_k = Kokkos::subview(U, k, Kokkos::ALL(), Kokkos::ALL());
+        auto V_k = Kokkos::subview(V, k, Kokkos::ALL(), Kokkos::ALL());
+        auto p_k = Kokkos::subview(p, k, Kokkos::ALL());
+        auto w_fast_k = Kokkos::subview(w_fast, k, Kokkos::ALL());
+        auto w_slow_k = Kokkos::subview(w_slow, k, Kokkos::ALL());
+        int matrix_rank(0);
+        KokkosBatched::TeamVectorUTV<member_type,algo_tag_type>
+          ::invoke(member, A_k, p_k, U_k, V_k, w_fast_k, matrix_rank);
+        member.team_barrier();
+        KokkosBatched::TeamVectorSolveUTVCompadre<member_type,algo_tag_type>
+          ::invoke(member, matrix_rank, M, N, NRHS, U_k, A_k, V_k, p_k, B_k, B_k, w_slow_k, w_fast_k);
+    });
+    Kokkos::fence();
+}
+
+// compares the first N rows (the solution X) of each problem solved by both kernels
+void compareUTVSolutions(ParallelManager pm, const int M, const int N, const int NRHS, const int num_matrices, 
+        const bool rank_deficient, const int block_size) {
+    const int ldb = (M > N) ? M : N;
+    Kokkos::View<double*, host_execution_space> A("A", 0), B("B", 0);
+    fillUTVComparisonProblem(A, B, M, N, NRHS, num_matrices, rank_deficient);
+    Kokkos::View<double*, device_execution_space> A_d("A_d", A.extent(0)), B_d("B_d", B.extent(0));
+    Kokkos::View<double*, device_execution_space> A_ref_d("A_ref_d", A.extent(0)), B_ref_d("B_ref_d", B.extent(0));
+    Kokkos::deep_copy(A_d, A);
+    Kokkos::deep_copy(B_d, B);
+    Kokkos::deep_copy(A_ref_d, A);
+    Kokkos::deep_copy(B_ref_d, B);
+
+    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(pm, A_d.data(), M, N, 
+            B_d.data(), ldb, NRHS, M, N, NRHS, num_matrices, block_size);
+    teamVectorQRPivotingSolve(A_ref_d, B_ref_d, M, N, NRHS, num_matrices);
+
+    auto X = Kokkos::create_mirror_view(B_d);
+    auto X_ref = Kokkos::create_mirror_view(B_ref_d);
+    Kokkos::deep_copy(X, B_d);
+    Kokkos::deep_copy(X_ref, B_ref_d);
+    for (int mat_num=0; mat_num<num_matrices; ++mat_num) {
+        host_scratch_matrix_right_type this_X(X.data() + mat_num*ldb*NRHS, ldb, NRHS);
+        host_scratch_matrix_right_type this_X_ref(X_ref.data() + mat_num*ldb*NRHS, ldb, NRHS);
+        for (int i=0; i<N; ++i) {
+            for (int j=0; j<NRHS; ++j) {
+                EXPECT_NEAR(this_X_ref(i,j), this_X(i,j), 1e-12*(1.0 + std::abs(this_X_ref(i,j))));
+            }
+        }
+    }
+}
+
+TEST_F (LinearAlgebraTest, Square_RankDeficient_batchQRPivotingSolve_HostVsTeamVector) {
+    compareUTVSolutions(pm, 5, 5, 3, 4, true /*rank deficient*/, 1 /*block size*/);
+}
+
+TEST_F (LinearAlgebraTest, Square_RankDeficient_batchQRPivotingSolve_Blocked_HostVsTeamVector) {
+    compareUTVSolutions(pm, 5, 5, 3, 4, true /*rank deficient*/, 2 /*block size*/);
+}
+
+TEST_F (LinearAlgebraTest, Tall_FullRank_batchQRPivotingSolve_HostVsTeamVector) {
+    compareUTVSolutions(pm, 9, 4, 9, 4, false /*rank deficient*/, 1 /*block size*/);
+}
+
+TEST_F (LinearAlgebraTest, Tall_RankDeficient_batchQRPivotingSolve_HostVsTeamVector) {
+    compareUTVSolutions(pm, 9, 4, 9, 4, true /*rank deficient*/, 1 /*block size*/);
+}
+
+TEST_F (LinearAlgebraTest, Tall_RankDeficient_batchQRPivotingSolve_Blocked_HostVsTeamVector) {
+    compareUTVSolutions(pm, 9, 4, 9, 4, true /*rank deficient*/, 3 /*block size*/);
+}
+
 //LLX!TEST_F (LinearAlgebraTest, Square_FullRank_batchQRPivotingSolve_Same_LDA_NDA_LRA_LLB_LLX) {
 //LLX!    int M=3, N=3, NRHS=3, num_matrices=2, rank=3;
 //LLX!    int lda=3, nda=3;
@@ -184,4 +184,92 @@ TEST_F (PointCloudSearchTest, 1D_Dynamic_Search) {
     ASSERT_TRUE(t1_neighbors.find(1) != t1_neighbors.end());
 }
 
+TEST_F (PointCloudSearchTest, 1D_Radius_Search_Single_Call) {
+    Kokkos::View<double*, host_execution_space> epsilon("h supports", 
+            number_target_coords);
+
+    // No dry run, neighbor lists are allocated and returned
+    auto nla = point_cloud_search.generateCRNeighborListsFromRadiusSearch(target_coords, epsilon, 0.2 /*radius*/);
+
+    ASSERT_EQ(2, nla.getNumberOfTargets());
+    ASSERT_EQ(2, nla.getNumberOfNeighborsHost(0));
+    ASSERT_EQ(2, nla.getNumberOfNeighborsHost(1));
+    ASSERT_EQ(4, nla.getTotalNeighborsOverAllListsHost());
+    ASSERT_DOUBLE_EQ(0.2, epsilon(0));
+    ASSERT_DOUBLE_EQ(0.2, epsilon(1));
+    // same neighbors, in the same order, as with a dry run
+    ASSERT_EQ(1, nla.getNeighborHost(0,0));
+    ASSERT_EQ(2, nla.getNeighborHost(0,1));
+    ASSERT_EQ(3, nla.getNeighborHost(1,0));
+    ASSERT_EQ(2, nla.getNeighborHost(1,1));
+}
+
+TEST_F (PointCloudSearchTest, 1D_Dynamic_Search_Single_Call) {
+    Kokkos::View<double*, host_execution_space> epsilon("h supports", 
+            number_target_coords);
+
+    // No dry run, neighbor lists are allocated and returned
+    auto nla = point_cloud_search.generateCRNeighborListsFromKNNSearch(target_coords, epsilon, 
+            3 /*min_neighbors*/, 1.5 /*epsilon_multiplier*/);
+
+    ASSERT_EQ(2, nla.getNumberOfTargets());
+    ASSERT_EQ(4, nla.getNumberOfNeighborsHost(0));
+    ASSERT_EQ(4, nla.getNumberOfNeighborsHost(1));
+    ASSERT_DOUBLE_EQ(0.5, epsilon(0));
+    ASSERT_DOUBLE_EQ(0.5, epsilon(1));
+
+    std::set<int> t0_neighbors, t1_neighbors;
+    for (int j=0; j<4; ++j) {
+        t0_neighbors.insert(nla.getNeighborHost(0,j));
+        t1_neighbors.insert(nla.getNeighborHost(1,j));
+    }
+    // closest neighbor is first, the rest are not sorted
+    ASSERT_EQ(1, nla.getNeighborHost(0,0));
+    ASSERT_TRUE(t0_neighbors.find(2) != t0_neighbors.end());
+    ASSERT_TRUE(t0_neighbors.find(0) != t0_neighbors.end());
+    ASSERT_TRUE(t0_neighbors.find(3) != t0_neighbors.end());
+    ASSERT_EQ(3, nla.getNeighborHost(1,0));
+    ASSERT_TRUE(t1_neighbors.find(2) != t1_neighbors.end());
+    ASSERT_TRUE(t1_neighbors.find(4) != t1_neighbors.end());
+    ASSERT_TRUE(t1_neighbors.find(1) != t1_neighbors.end());
+}
+
+TEST_F (PointCloudSearchTest, 1D_Dynamic_Search_Ordered_Sources) {
+    Kokkos::View<double*, host_execution_space> epsilon("h supports", 
+            number_target_coords);
+
+    // source sites given in reverse order, with the kd-tree built over them in Morton order
+    Kokkos::View<double**, host_execution_space> reversed_source_coords("reversed source coordinates", 
+            number_source_coords, 1);
+    for (int i=0; i<number_source_coords; ++i) {
+        reversed_source_coords(i,0) = source_coords(number_source_coords-1-i,0);
+    }
+    auto ordered_search = CreatePointCloudSearch(reversed_source_coords, 1 /*dimension*/, 
+            -1 /*max_leaf*/, true /*order_sources_along_curve*/);
+
+    auto nla = ordered_search.generateCRNeighborListsFromKNNSearch(target_coords, epsilon, 
+            3 /*min_neighbors*/, 1.5 /*epsilon_multiplier*/);
+
+    ASSERT_EQ(2, nla.getNumberOfTargets());
+    ASSERT_EQ(4, nla.getNumberOfNeighborsHost(0));
+    ASSERT_EQ(4, nla.getNumberOfNeighborsHost(1));
+    ASSERT_DOUBLE_EQ(0.5, epsilon(0));
+    ASSERT_DOUBLE_EQ(0.5, epsilon(1));
+
+    std::set<int> t0_neighbors, t1_neighbors;
+    for (int j=0; j<4; ++j) {
+        t0_neighbors.insert(nla.getNeighborHost(0,j));
+        t1_neighbors.insert(nla.getNeighborHost(1,j));
+    }
+    // neighbors index source sites as given (reversed), not as ordered in the kd-tree
+    ASSERT_EQ(3, nla.getNeighborHost(0,0));
+    ASSERT_TRUE(t0_neighbors.find(2) != t0_neighbors.end());
+    ASSERT_TRUE(t0_neighbors.find(4) != t0_neighbors.end());
+    ASSERT_TRUE(t0_neighbors.find(1) != t0_neighbors.end());
+    ASSERT_EQ(1, nla.getNeighborHost(1,0));
+    ASSERT_TRUE(t1_neighbors.find(2) != t1_neighbors.end());
+    ASSERT_TRUE(t1_neighbors.find(0) != t1_neighbors.end());
+    ASSERT_TRUE(t1_neighbors.find(3) != t1_neighbors.end());
+}
+
 #endif
@@ -776,9 +776,18 @@ https://github.com/sandialabs/compadre/blob/master/pycompadre/pycompadre.cpp
     .def("getWeightingType", &GMLS::getWeightingType, "Get the weighting type.")
     .def("setWeightingType", overload_cast_<const std::string&>()(&GMLS::setWeightingType), "Set the weighting type with a string.")
     .def("setWeightingType", overload_cast_<WeightingFunctionType>()(&GMLS::setWeightingType), "Set the weighting type with a WeightingFunctionType.")
+    .def("getNumberOfNeighborBuckets", &GMLS::getNumberOfNeighborBuckets, "Get number of buckets target sites are grouped into by number of neighbors.")
+    .def("setNumberOfNeighborBuckets", &GMLS::setNumberOfNeighborBuckets, py::arg("number_of_neighbor_buckets"), "Set number of buckets target sites are grouped into by number of neighbors (0 or 1 disables).")
+    .def("setSinglePrecisionSolve", &GMLS::setSinglePrecisionSolve, py::arg("single_precision_solve"), "Set whether least squares problems are stored and solved in single precision.")
+    .def("setPackTargetsForSIMD", &GMLS::setPackTargetsForSIMD, py::arg("pack_targets_for_simd"), "Set whether the Cholesky solver interleaves groups of target sites, one per SIMD lane.")
     .def("addTargets", overload_cast_<TargetOperation>()(&GMLS::addTargets), "Add a target operation.")
     .def("addTargets", overload_cast_<std::vector<TargetOperation> >()(&GMLS::addTargets), "Add a list of target operations.")
-    .def("generateAlphas", &GMLS::generateAlphas, py::arg("number_of_batches")=1, py::arg("keep_coefficients")=false)
+    .def("generateAlphas", &GMLS::generateAlphas, py::arg("number_of_batches")=1, py::arg("keep_coefficients")=false, py::arg("overlap_batches")=false)
+    .def("getBatchTimes", &GMLS::getBatchTimes, "Get wall time spent on each batch in the last call to generateAlphas.")
+    .def("setupPolynomialCoefficients", &GMLS::setupPolynomialCoefficients, py::arg("number_of_batches")=1, py::arg("max_num_neighbors")=0, py::arg("max_num_targets")=0, py::arg("keep_coefficients")=false, "Set up storage to be reused by later calls to generateAlphas.")
+    .def("estimateMemoryFootprint", &GMLS::estimateMemoryFootprint, py::arg("number_of_batches")=1, py::arg("overlap_batches")=false, py::arg("stream_alphas")=false, py::arg("keep_coefficients")=false, "Estimate bytes allocated by generateAlphas.")
+    .def("selectNumberOfBatches", &GMLS::selectNumberOfBatches, py::arg("memory_budget")=0, py::arg("overlap_batches")=false, py::arg("stream_alphas")=false, py::arg("keep_coefficients")=false, "Get smallest number of batches for which generateAlphas fits in memory_budget bytes (0 uses free memory).")
+    .def("clearPolynomialCoefficientsStorage", &GMLS::clearPolynomialCoefficientsStorage, "Release storage set up by setupPolynomialCoefficients.")
     .def("getSolutionSet", &GMLS::getSolutionSetHost, py::return_value_policy::reference_internal)
     .def("getNP", &GMLS::getNP, "Get size of basis.")
     .def("getNN", &GMLS::getNN, "Heuristic number of neighbors.");
@@ -7,14 +7,14 @@ namespace Compadre {
 /*! \brief For applying the evaluations from a target functional to the polynomial coefficients
     \param data                     [out/in] - GMLSSolutionData struct (stores solution in data._d_ss._alphas)
     \param teamMember                   [in] - Kokkos::TeamPolicy member type (created by parallel_for)
-    \param Q                            [in] - 2D Kokkos View containing the polynomial coefficients
+    \param Q                            [in] - 2D Kokkos View containing the polynomial coefficients (double or float)
     \param P_target_row                 [in] - 1D Kokkos View where the evaluation of the polynomial basis is stored
 */
-template <typename SolutionData>
+template <typename SolutionData, typename coefficients_type>
 KOKKOS_INLINE_FUNCTION
-void applyTargetsToCoefficients(const SolutionData& data, const member_type& teamMember, scratch_matrix_right_type Q, scratch_matrix_right_type P_target_row) {
+void applyTargetsToCoefficients(const SolutionData& data, const member_type& teamMember, coefficients_type Q, scratch_matrix_right_type P_target_row) {
 
-    const int target_index = data._initial_index_for_batch + teamMember.league_rank();
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
 
 #if defined(COMPADRE_USE_CUDA)
 //        // GPU
@@ -67,15 +67,21 @@ void applyTargetsToCoefficients(const SolutionData& data, const member_type& tea
                 for (int k=0; k<data._d_ss._lro_output_tile_size[j]; ++k) {
                     for (int m=0; m<data._d_ss._lro_input_tile_size[j]; ++m) {
                         const int offset_index_jmke = data._d_ss.getTargetOffsetIndex(j,m,k,e);
-                        const int alphas_index = data._d_ss.getAlphaIndex(target_index, offset_index_jmke);
+                        // alphas are not computed for tiles that are zero or clones of another tile
+                        if (!data._d_ss.isAlphaTileStored(offset_index_jmke)) continue;
+                        const int alphas_index = data._d_ss.getAlphaIndex(target_index, 
+                                data._d_ss.getAlphaStorageIndex(offset_index_jmke));
                             double alpha_ij = 0;
                             if (data._sampling_multiplier>1 && m<data._sampling_multiplier) {
-                                const int m_neighbor_offset = i+m*nn;
+                                // coefficients of a single diagonal block are applied to the block for component m
+                                const int block = (data._number_of_diagonal_blocks>1) ? m : 0;
+                                const int P_col_offset = block*data.this_num_cols;
+                                const int m_neighbor_offset = i+(m-block)*nn;
                                 Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, data.this_num_cols),
                                   [&] (int& l, double& t_alpha_ij) {
-                                    t_alpha_ij += P_target_row(offset_index_jmke, l)*Q(l, m_neighbor_offset);
+                                    t_alpha_ij += P_target_row(offset_index_jmke, P_col_offset+l)*Q(l, m_neighbor_offset);
 
-                                    compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, l)==P_target_row(offset_index_jmke, l) 
+                                    compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, P_col_offset+l)==P_target_row(offset_index_jmke, P_col_offset+l) 
                                             && "NaN in P_target_row matrix.");
                                     compadre_kernel_assert_extreme_debug(Q(l, m_neighbor_offset)==Q(l, m_neighbor_offset) 
                                             && "NaN in Q coefficient matrix.");
@@ -107,10 +113,9 @@ void applyTargetsToCoefficients(const SolutionData& data, const member_type& tea
 
     // CPU
     const int alphas_per_tile_per_target = data.number_of_neighbors_list(target_index) + data._d_ss._added_alpha_size;
-    const global_index_type base_offset_index_jmke = data._d_ss.getTargetOffsetIndex(0,0,0,0);
-    const global_index_type base_alphas_index = data._d_ss.getAlphaIndex(target_index, base_offset_index_jmke);
+    const global_index_type base_alphas_index = data._d_ss.getAlphaIndex(target_index, 0);
 
-    scratch_matrix_right_type this_alphas(data._d_ss._alphas.data() + TO_GLOBAL(base_alphas_index), data._d_ss._total_alpha_values*data._d_ss._max_evaluation_sites_per_target, alphas_per_tile_per_target);
+    scratch_matrix_right_type this_alphas(data._d_ss._alphas.data() + TO_GLOBAL(base_alphas_index), data._d_ss._total_stored_alpha_values*data._d_ss._max_evaluation_sites_per_target, alphas_per_tile_per_target);
 
     auto n_evaluation_sites_per_target = data.additional_number_of_neighbors_list(target_index) + 1;
     const auto nn = data.number_of_neighbors_list(target_index);
@@ -120,19 +125,25 @@ void applyTargetsToCoefficients(const SolutionData& data, const member_type& tea
             for (int k=0; k<data._d_ss._lro_output_tile_size[j]; ++k) {
                 for (int m=0; m<data._d_ss._lro_input_tile_size[j]; ++m) {
                     const int offset_index_jmke = data._d_ss.getTargetOffsetIndex(j,m,k,e);
+                    // alphas are not computed for tiles that are zero or clones of another tile
+                    if (!data._d_ss.isAlphaTileStored(offset_index_jmke)) continue;
+                    const int alphas_row = data._d_ss.getAlphaStorageIndex(offset_index_jmke);
+                    // coefficients of a single diagonal block are applied to the block for component m
+                    const int block = (data._number_of_diagonal_blocks>1) ? m : 0;
+                    const int P_col_offset = block*data.this_num_cols;
                     for (int i=0; i<nn + data._d_ss._added_alpha_size; ++i) {
                         double alpha_ij = 0;
-                        const int Q_col = i+m*nn;
+                        const int Q_col = i+(m-block)*nn;
                         // one thread per team on CPU, so no reason to add inner parallel reductions here
                         // or Kokkos::single. Either will cause significant slowdown.
                         for (int l=0; l<data.this_num_cols; ++l) {
                             if (data._sampling_multiplier>1 && m<data._sampling_multiplier) {
 
-                                alpha_ij += P_target_row(offset_index_jmke, l)*Q(l, Q_col);
+                                alpha_ij += P_target_row(offset_index_jmke, P_col_offset+l)*Q(l, Q_col);
 
-                                compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, l)==P_target_row(offset_index_jmke, l) 
+                                compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, P_col_offset+l)==P_target_row(offset_index_jmke, P_col_offset+l) 
                                         && "NaN in P_target_row matrix.");
-                                compadre_kernel_assert_extreme_debug(Q(l, i+m*data.number_of_neighbors_list(target_index))==Q(l, i+m*data.number_of_neighbors_list(target_index))
+                                compadre_kernel_assert_extreme_debug(Q(l, Q_col)==Q(l, Q_col)
                                         && "NaN in Q coefficient matrix.");
 
                             } else if (data._sampling_multiplier == 1) {
@@ -148,7 +159,7 @@ void applyTargetsToCoefficients(const SolutionData& data, const member_type& tea
                                 alpha_ij += 0;
                             }
                         }
-                        this_alphas(offset_index_jmke,i) = alpha_ij;
+                        this_alphas(alphas_row,i) = alpha_ij;
                     }
                 }
             }
@@ -159,5 +170,193 @@ void applyTargetsToCoefficients(const SolutionData& data, const member_type& tea
     teamMember.team_barrier();
 }
 
+/*! \brief For applying target evaluations known analytically (see GMLS::usesAnalyticTargetRows) to the polynomial 
+    coefficients, where each alpha is a scaled sum of a few entries of Q rather than a dot product with a row of 
+    evaluations
+    \param data                     [out/in] - GMLSSolutionData struct (stores solution in data._d_ss._alphas)
+    \param teamMember                   [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+    \param Q                            [in] - 2D Kokkos View containing the polynomial coefficients (double or float)
+*/
+template <typename SolutionData, typename coefficients_type>
+KOKKOS_INLINE_FUNCTION
+void applyAnalyticTargetsToCoefficients(const SolutionData& data, const member_type& teamMember, coefficients_type Q) {
+
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
+    const int alphas_per_tile_per_target = data.number_of_neighbors_list(target_index) + data._d_ss._added_alpha_size;
+    const auto rows = data._analytic_target_rows;
+    auto alphas = data._d_ss._alphas;
+
+    for (int r=0; r<(int)rows.extent(0); ++r) {
+        const int num_entries = rows(r,0);
+        const double scale = std::pow(data._epsilons(target_index), -rows(r,1));
+        const global_index_type alphas_index = data._d_ss.getAlphaIndex(target_index, data._d_ss.getAlphaStorageIndex(r));
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, alphas_per_tile_per_target), [&] (const int i) {
+            double alpha_ij = 0;
+            for (int c=0; c<num_entries; ++c) {
+                alpha_ij += Q(rows(r,2+c), i);
+                compadre_kernel_assert_extreme_debug(Q(rows(r,2+c),i)==Q(rows(r,2+c),i) 
+                        && "NaN in Q coefficient matrix.");
+            }
+            alphas(alphas_index+i) = scale*alpha_ij;
+        });
+    }
+
+    teamMember.team_barrier();
+}
+
+/*! \brief For applying target evaluations known analytically to the polynomial coefficients of one target site 
+    with a single thread (see applyAnalyticTargetsToCoefficients), so that each thread of a team may own a target
+    \param data                     [out/in] - GMLSSolutionData struct (stores solution in data._d_ss._alphas)
+    \param target_index                 [in] - index of the target site
+    \param Q                            [in] - 2D Kokkos View containing the polynomial coefficients (double or float)
+*/
+template <typename SolutionData, typename coefficients_type>
+KOKKOS_INLINE_FUNCTION
+void applyAnalyticTargetsToCoefficientsSerial(const SolutionData& data, const int target_index, coefficients_type Q) {
+
+    const int alphas_per_tile_per_target = data.number_of_neighbors_list(target_index) + data._d_ss._added_alpha_size;
+    const auto rows = data._analytic_target_rows;
+    auto alphas = data._d_ss._alphas;
+
+    for (int r=0; r<(int)rows.extent(0); ++r) {
+        const int num_entries = rows(r,0);
+        const double scale = std::pow(data._epsilons(target_index), -rows(r,1));
+        const global_index_type alphas_index = data._d_ss.getAlphaIndex(target_index, data._d_ss.getAlphaStorageIndex(r));
+        for (int i=0; i<alphas_per_tile_per_target; ++i) {
+            double alpha_ij = 0;
+            for (int c=0; c<num_entries; ++c) {
+                alpha_ij += Q(rows(r,2+c), i);
+            }
+            alphas(alphas_index+i) = scale*alpha_ij;
+        }
+    }
+}
+
+/*! \brief For applying target evaluations known analytically to the polynomial coefficients of one target site 
+    with a single thread and contracting the result directly against sampling data, without storing alphas 
+    (see applyTargetsToCoefficientsAndData)
+    \param data                     [out/in] - GMLSSolutionData struct (reads data._sampling_data and stores 
+                                                target outputs in data._target_output)
+    \param target_index                 [in] - index of the target site
+    \param Q                            [in] - 2D Kokkos View containing the polynomial coefficients (double or float)
+*/
+template <typename SolutionData, typename coefficients_type>
+KOKKOS_INLINE_FUNCTION
+void applyAnalyticTargetsToCoefficientsAndDataSerial(const SolutionData& data, const int target_index, 
+        coefficients_type Q) {
+
+    const int nn = data.number_of_neighbors_list(target_index);
+    // a single column of sampling data is used for every input component
+    const bool scalar_as_vector = (data._sampling_data.extent(1) == 1);
+    const auto rows = data._analytic_target_rows;
+
+    // target evaluations are known analytically only for a single evaluation site
+    int output_column = 0;
+    for (int j=0; j<(int)data.operations_size; ++j) {
+        for (int k=0; k<data._d_ss._lro_output_tile_size[j]; ++k) {
+            double target_value = 0;
+            for (int m=0; m<data._d_ss._lro_input_tile_size[j]; ++m) {
+                const int offset_index_jmk = data._d_ss.getTargetOffsetIndex(j,m,k,0);
+                // tiles whose alphas are all zero contribute nothing
+                if (data._d_ss.getAlphaStorageIndex(offset_index_jmk) < 0) continue;
+                const int data_column = (scalar_as_vector) ? 0 : m;
+                const int num_entries = rows(offset_index_jmk,0);
+                const double scale = std::pow(data._epsilons(target_index), -rows(offset_index_jmk,1));
+                for (int i=0; i<nn; ++i) {
+                    double alpha_ij = 0;
+                    for (int c=0; c<num_entries; ++c) {
+                        alpha_ij += Q(rows(offset_index_jmk,2+c), i);
+                    }
+                    target_value += scale*alpha_ij
+                        *data._sampling_data(data._d_ss._neighbor_lists.getNeighborDevice(target_index, i), data_column);
+                }
+            }
+            data._target_output(target_index, output_column + k) = target_value;
+        }
+        output_column += data._d_ss._lro_output_tile_size[j];
+    }
+}
+
+/*! \brief For applying the evaluations from a target functional to the polynomial coefficients and contracting 
+    the result directly against sampling data, without storing alphas (matrix-free)
+    \param data                     [out/in] - GMLSSolutionData struct (reads data._sampling_data and stores 
+                                                target outputs in data._target_output)
+    \param teamMember                   [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+    \param Q                            [in] - 2D Kokkos View containing the polynomial coefficients (double or float)
+    \param P_target_row                 [in] - 1D Kokkos View where the evaluation of the polynomial basis is stored
+                                               (not used if data._analytic_target_rows is not empty)
+*/
+template <typename SolutionData, typename coefficients_type>
+KOKKOS_INLINE_FUNCTION
+void applyTargetsToCoefficientsAndData(const SolutionData& data, const member_type& teamMember, coefficients_type Q, scratch_matrix_right_type P_target_row) {
+
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
+
+    const auto n_evaluation_sites_per_target = data.additional_number_of_neighbors_list(target_index) + 1;
+    const int nn = data.number_of_neighbors_list(target_index);
+    // a single column of sampling data is used for every input component
+    const bool scalar_as_vector = (data._sampling_data.extent(1) == 1);
+    const auto rows = data._analytic_target_rows;
+    const bool analytic = (rows.extent(0) > 0);
+
+    for (int e=0; e<n_evaluation_sites_per_target; ++e) {
+        int output_column = e*data.total_output_values;
+        for (int j=0; j<(int)data.operations_size; ++j) {
+            for (int k=0; k<data._d_ss._lro_output_tile_size[j]; ++k) {
+                double target_value = 0;
+                for (int m=0; m<data._d_ss._lro_input_tile_size[j]; ++m) {
+                    // alphas are zero for these input components, so they contribute nothing
+                    if (data._sampling_multiplier>1 && m>=data._sampling_multiplier) continue;
+
+                    const int offset_index_jmke = data._d_ss.getTargetOffsetIndex(j,m,k,e);
+                    // tiles whose alphas are all zero contribute nothing
+                    if (data._d_ss.getAlphaStorageIndex(offset_index_jmke) < 0) continue;
+                    // coefficients of a single diagonal block are applied to the block for component m
+                    const int block = (data._number_of_diagonal_blocks>1) ? m : 0;
+                    const int P_col_offset = block*data.this_num_cols;
+                    const int Q_col_offset = (data._sampling_multiplier>1) ? (m-block)*nn : 0;
+                    const int data_column = (scalar_as_vector) ? 0 : m;
+
+                    // target evaluations known analytically are a few scaled entries (see applyAnalyticTargetsToCoefficients)
+                    const int num_analytic_entries = (analytic) ? rows(offset_index_jmke,0) : 0;
+                    const double analytic_scale = (analytic) ? 
+                        std::pow(data._epsilons(target_index), -rows(offset_index_jmke,1)) : 0;
+
+                    // alpha_ij is formed and used in registers, rather than being written to alphas
+                    double component_value = 0;
+                    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, nn), [&] (const int i, double& t_value) {
+                        double alpha_ij = 0;
+                        if (analytic) {
+                            for (int c=0; c<num_analytic_entries; ++c) {
+                                alpha_ij += Q(rows(offset_index_jmke,2+c), Q_col_offset+i);
+                            }
+                            alpha_ij *= analytic_scale;
+                        } else {
+                            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, data.this_num_cols),
+                              [&] (const int l, double& t_alpha_ij) {
+                                t_alpha_ij += P_target_row(offset_index_jmke, P_col_offset+l)*Q(l, Q_col_offset+i);
+
+                                compadre_kernel_assert_extreme_debug(P_target_row(offset_index_jmke, P_col_offset+l)==P_target_row(offset_index_jmke, P_col_offset+l) 
+                                        && "NaN in P_target_row matrix.");
+                                compadre_kernel_assert_extreme_debug(Q(l, Q_col_offset+i)==Q(l, Q_col_offset+i) 
+                                        && "NaN in Q coefficient matrix.");
+
+                            }, alpha_ij);
+                        }
+                        t_value += alpha_ij*data._sampling_data(data._d_ss._neighbor_lists.getNeighborDevice(target_index, i), data_column);
+                    }, component_value);
+                    target_value += component_value;
+                }
+                Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
+                    data._target_output(target_index, output_column + k) = target_value;
+                });
+            }
+            output_column += data._d_ss._lro_output_tile_size[j];
+        }
+    }
+
+    teamMember.team_barrier();
+}
+
 } // Compadre
 #endif
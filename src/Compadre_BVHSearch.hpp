@@ -0,0 +1,291 @@
+#ifndef _COMPADRE_BVHSEARCH_HPP_
+#define _COMPADRE_BVHSEARCH_HPP_
+
+#include "Compadre_Typedefs.hpp"
+#include "Compadre_DeviceNeighborSearch.hpp"
+#include "Compadre_SpaceFillingCurve.hpp"
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+#include <cstdint>
+#include <limits>
+
+namespace Compadre {
+
+//!  BVHSearch generates neighbor lists and window sizes for each target site on the device
+/*!
+*  Source sites are ordered along a Morton curve and grouped into leaves of at most `max_leaf` sites.
+*  A complete binary tree of bounding boxes is built over the leaves, one level at a time. The build
+*  and the searches both run on `device_execution_space` with one target site per thread, so source and
+*  target coordinates, neighbor lists, and epsilons can all reside in `device_memory_space`.
+*
+*  Compressed row neighbor lists are generated as described in DeviceNeighborSearch.
+*
+*/
+template <typename view_type>
+class BVHSearch : public DeviceNeighborSearch<BVHSearch<view_type> > {
+
+    public:
+
+        typedef Kokkos::View<double**, layout_right, device_memory_space> coordinates_view_type;
+        typedef Kokkos::View<int*, device_memory_space> index_view_type;
+
+        //! Device copyable view of the tree, used inside of search kernels
+        struct Tree {
+
+            //! source coordinates in Morton order
+            coordinates_view_type sorted_pts;
+            //! index of each source site in Morton order
+            index_view_type sorted_indices;
+            //! bounding box of node n (minimum in columns 0-2, maximum in columns 3-5), with
+            //! children 2n and 2n+1, and leaves numbered from num_leaves
+            coordinates_view_type boxes;
+            int dim;
+            int max_leaf;
+            int num_leaves;
+            int num_pts;
+
+            //! Squared distance from x to the bounding box of node
+            KOKKOS_INLINE_FUNCTION
+            double boxDistance(const double* x, const int node) const {
+                double distance = 0;
+                for (int d=0; d<dim; ++d) {
+                    const double below = boxes(node,d) - x[d];
+                    const double above = x[d] - boxes(node,3+d);
+                    const double outside = (below > 0) ? below : ((above > 0) ? above : 0);
+                    distance += outside*outside;
+                }
+                return distance;
+            }
+
+            //! Squared distance from x to the source site at position j in Morton order
+            KOKKOS_INLINE_FUNCTION
+            double pointDistance(const double* x, const int j) const {
+                double distance = 0;
+                for (int d=0; d<dim; ++d) {
+                    distance += (x[d]-sorted_pts(j,d))*(x[d]-sorted_pts(j,d));
+                }
+                return distance;
+            }
+
+            //! Calls f(source index, squared distance) for every source site at a squared distance less than r2 from x
+            template <typename F>
+            KOKKOS_INLINE_FUNCTION
+            void radiusSearch(const double* x, const double r2, F& f) const {
+                int stack[64];
+                int top = 0;
+                stack[top++] = 1;
+                while (top > 0) {
+                    const int node = stack[--top];
+                    // a box is never closer than the sites inside of it
+                    if (boxDistance(x, node) >= r2) continue;
+                    if (node >= num_leaves) {
+                        const int begin = (node - num_leaves)*max_leaf;
+                        const int end = (begin + max_leaf < num_pts) ? begin + max_leaf : num_pts;
+                        for (int j=begin; j<end; ++j) {
+                            const double distance = pointDistance(x, j);
+                            if (distance < r2) f(sorted_indices(j), distance);
+                        }
+                    } else {
+                        stack[top++] = 2*node+1;
+                        stack[top++] = 2*node;
+                    }
+                }
+            }
+
+            //! Finds the k source sites nearest to x, storing their squared distances (as a max heap, so
+            //! heap_distances[0] is the distance to the kth neighbor) and source indices. Returns number found.
+            KOKKOS_INLINE_FUNCTION
+            int knnSearch(const double* x, const int k, double* heap_distances, int* heap_indices) const {
+                if (k <= 0) return 0;
+                int count = 0;
+                int stack[64];
+                double stack_distances[64];
+                int top = 0;
+                stack[top] = 1;
+                stack_distances[top++] = boxDistance(x, 1);
+                while (top > 0) {
+                    --top;
+                    const int node = stack[top];
+                    if (count==k && stack_distances[top] > heap_distances[0]) continue;
+                    if (node >= num_leaves) {
+                        const int begin = (node - num_leaves)*max_leaf;
+                        const int end = (begin + max_leaf < num_pts) ? begin + max_leaf : num_pts;
+                        for (int j=begin; j<end; ++j) {
+                            const double distance = pointDistance(x, j);
+                            addToNearestNeighborHeap(distance, sorted_indices(j), k, count, heap_distances, heap_indices);
+                        }
+                    } else {
+                        // nearer child is visited first
+                        const double left_distance = boxDistance(x, 2*node);
+                        const double right_distance = boxDistance(x, 2*node+1);
+                        const bool left_first = (left_distance <= right_distance);
+                        stack[top] = left_first ? 2*node+1 : 2*node;
+                        stack_distances[top++] = left_first ? right_distance : left_distance;
+                        stack[top] = left_first ? 2*node : 2*node+1;
+                        stack_distances[top++] = left_first ? left_distance : right_distance;
+                    }
+                }
+                return count;
+            }
+        };
+
+    protected:
+
+        //! source site coordinates
+        view_type _src_pts_view;
+        local_index_type _dim;
+        local_index_type _max_leaf;
+
+        Tree _tree;
+        bool _tree_built;
+
+    public:
+
+        BVHSearch(view_type src_pts_view, const local_index_type dimension = -1,
+                const local_index_type max_leaf = -1)
+                : _src_pts_view(src_pts_view),
+                  _dim((dimension < 0) ? src_pts_view.extent(1) : dimension),
+                  _max_leaf((max_leaf < 0) ? 10 : max_leaf),
+                  _tree_built(false) {
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename view_type::memory_space>::accessible==1)
+                    && "Views passed to BVHSearch at construction should be accessible from the device.");
+            compadre_assert_release((_dim>=1 && _dim<=3) && "BVHSearch only supports dimensions 1, 2, and 3.");
+        };
+
+        ~BVHSearch() {};
+
+        //! Returns the dimension of the search
+        int getDimension() const { return _dim; }
+
+        //! Returns the number of source sites
+        int getNumberOfSources() const { return _src_pts_view.extent(0); }
+
+        //! Returns the tree, building it if needed
+        Tree getTree() {
+            if (!_tree_built) this->generateBVH();
+            return _tree;
+        }
+
+        void generateBVH() {
+
+            const int num_pts = _src_pts_view.extent(0);
+            const int dim = _dim;
+            const int max_leaf = _max_leaf;
+            auto src_pts_view = _src_pts_view;
+
+            // bounding box of source sites
+            double box_min[3] = {0,0,0};
+            double box_max[3] = {0,0,0};
+            double inv_box_length[3] = {0,0,0};
+            getBoundingBoxDevice(src_pts_view, dim, box_min, box_max);
+            for (int d=0; d<dim; ++d) {
+                inv_box_length[d] = (box_max[d] > box_min[d]) ? 1.0/(box_max[d] - box_min[d]) : 0.0;
+            }
+            const double box_min_0 = box_min[0], box_min_1 = box_min[1], box_min_2 = box_min[2];
+            const double inv_box_length_0 = inv_box_length[0], inv_box_length_1 = inv_box_length[1],
+                  inv_box_length_2 = inv_box_length[2];
+
+            // order source sites along a Morton curve
+            typedef Kokkos::View<std::uint64_t*, device_memory_space> key_view_type;
+            key_view_type keys("bvh morton codes", num_pts);
+            Kokkos::parallel_for("bvh morton codes", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int i) {
+                const double this_box_min[3] = {box_min_0, box_min_1, box_min_2};
+                const double this_inv_box_length[3] = {inv_box_length_0, inv_box_length_1, inv_box_length_2};
+                double x[3] = {0,0,0};
+                for (int d=0; d<dim; ++d) x[d] = src_pts_view(i,d);
+                keys(i) = getMortonCode(x, this_box_min, this_inv_box_length, dim);
+            });
+
+            std::uint64_t min_key = 0, max_key = 0;
+            if (num_pts > 0) {
+                Kokkos::parallel_reduce("bvh min morton code", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                        KOKKOS_LAMBDA(const int i, std::uint64_t& t_min) {
+                    t_min = (keys(i) < t_min) ? keys(i) : t_min;
+                }, Kokkos::Min<std::uint64_t>(min_key));
+                Kokkos::parallel_reduce("bvh max morton code", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                        KOKKOS_LAMBDA(const int i, std::uint64_t& t_max) {
+                    t_max = (keys(i) > t_max) ? keys(i) : t_max;
+                }, Kokkos::Max<std::uint64_t>(max_key));
+            }
+
+            _tree.sorted_indices = index_view_type("bvh sorted indices", num_pts);
+            auto sorted_indices = _tree.sorted_indices;
+            if (max_key > min_key) {
+                // bins split the range of Morton codes evenly, not space, so clustered sites can share a bin 
+                // while being far apart along the curve, and are sorted by code within their bin as well
+                typedef Kokkos::BinOp1D<key_view_type> bin_op_type;
+                Kokkos::BinSort<key_view_type, bin_op_type> bin_sort(keys, bin_op_type(num_pts, min_key, max_key), 
+                        true /*sort_within_bins*/);
+                bin_sort.create_permute_vector();
+                auto permute_vector = bin_sort.get_permute_vector();
+                Kokkos::parallel_for("bvh sorted indices", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                        KOKKOS_LAMBDA(const int i) {
+                    sorted_indices(i) = permute_vector(i);
+                });
+            } else {
+                Kokkos::parallel_for("bvh sorted indices", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                        KOKKOS_LAMBDA(const int i) {
+                    sorted_indices(i) = i;
+                });
+            }
+
+            _tree.sorted_pts = coordinates_view_type("bvh sorted coordinates", num_pts, dim);
+            auto sorted_pts = _tree.sorted_pts;
+            Kokkos::parallel_for("bvh sorted coordinates", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int i) {
+                for (int d=0; d<dim; ++d) sorted_pts(i,d) = src_pts_view(sorted_indices(i),d);
+            });
+
+            // complete binary tree over leaves, with empty boxes for leaves beyond the last source site
+            const int num_filled_leaves = (num_pts + max_leaf - 1)/max_leaf;
+            int num_leaves = 1;
+            while (num_leaves < num_filled_leaves) num_leaves *= 2;
+
+            _tree.boxes = coordinates_view_type("bvh bounding boxes", 2*num_leaves, 6);
+            auto boxes = _tree.boxes;
+            const double huge = std::numeric_limits<double>::max();
+            Kokkos::parallel_for("bvh leaf boxes", Kokkos::RangePolicy<device_execution_space>(0, num_leaves),
+                    KOKKOS_LAMBDA(const int l) {
+                const int node = num_leaves + l;
+                for (int d=0; d<3; ++d) {
+                    boxes(node,d) = huge;
+                    boxes(node,3+d) = -huge;
+                }
+                const int begin = l*max_leaf;
+                const int end = (begin + max_leaf < num_pts) ? begin + max_leaf : num_pts;
+                for (int j=begin; j<end; ++j) {
+                    for (int d=0; d<dim; ++d) {
+                        boxes(node,d) = (sorted_pts(j,d) < boxes(node,d)) ? sorted_pts(j,d) : boxes(node,d);
+                        boxes(node,3+d) = (sorted_pts(j,d) > boxes(node,3+d)) ? sorted_pts(j,d) : boxes(node,3+d);
+                    }
+                }
+            });
+            for (int level_begin=num_leaves/2; level_begin>=1; level_begin/=2) {
+                Kokkos::parallel_for("bvh internal boxes", Kokkos::RangePolicy<device_execution_space>(level_begin, 2*level_begin),
+                        KOKKOS_LAMBDA(const int node) {
+                    for (int d=0; d<3; ++d) {
+                        boxes(node,d) = (boxes(2*node,d) < boxes(2*node+1,d)) ? boxes(2*node,d) : boxes(2*node+1,d);
+                        boxes(node,3+d) = (boxes(2*node,3+d) > boxes(2*node+1,3+d)) ? boxes(2*node,3+d) : boxes(2*node+1,3+d);
+                    }
+                });
+            }
+            Kokkos::fence();
+
+            _tree.dim = dim;
+            _tree.max_leaf = max_leaf;
+            _tree.num_leaves = num_leaves;
+            _tree.num_pts = num_pts;
+            _tree_built = true;
+        }
+}; // BVHSearch
+
+//! CreateBVHSearch allows for the construction of an object of type BVHSearch with template deduction
+template <typename view_type>
+BVHSearch<view_type> CreateBVHSearch(view_type src_view, const local_index_type dimensions = -1, const local_index_type max_leaf = -1) {
+    return BVHSearch<view_type>(src_view, dimensions, max_leaf);
+}
+
+} // Compadre
+
+#endif
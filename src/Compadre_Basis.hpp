@@ -660,13 +660,13 @@ void calcHessianPij(const BasisData& data, const member_type& teamMember, double
     \param reconstruction_space [in] - space of polynomial that a sampling functional is to evaluate
     \param sampling_strategy    [in] - sampling functional specification
 */
-template <typename BasisData>
+template <typename BasisData, typename matrix_type>
 KOKKOS_INLINE_FUNCTION
-void createWeightsAndP(const BasisData& data, const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, scratch_matrix_right_type P, scratch_vector_type w, const int dimension, int polynomial_order, bool weight_p = false, scratch_matrix_right_type* V = NULL, const ReconstructionSpace reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial, const SamplingFunctional polynomial_sampling_functional = PointSample) {
+void createWeightsAndP(const BasisData& data, const member_type& teamMember, scratch_vector_type delta, scratch_vector_type thread_workspace, matrix_type P, scratch_vector_type w, const int dimension, int polynomial_order, bool weight_p = false, scratch_matrix_right_type* V = NULL, const ReconstructionSpace reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial, const SamplingFunctional polynomial_sampling_functional = PointSample) {
     /*
      * Creates sqrt(W)*P
      */
-    const int target_index = data._initial_index_for_batch + teamMember.league_rank();
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
 //    printf("specific order: %d\n", specific_order);
 //    {
 //        const int storage_size = (specific_order > 0) ? GMLS::getNP(specific_order, dimension)-GMLS::getNP(specific_order-1, dimension) : GMLS::getNP(data._poly_order, dimension);
@@ -766,7 +766,7 @@ void createWeightsAndPForCurvature(const BasisData& data, const member_type& tea
  * 2.) Used to calculate a polynomial of data._curvature_poly_order, which we use to calculate curvature of the manifold
  */
 
-    const int target_index = data._initial_index_for_batch + teamMember.league_rank();
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
     int storage_size = only_specific_order ? GMLS::getNP(1, dimension)-GMLS::getNP(0, dimension) : GMLS::getNP(data._curvature_poly_order, dimension);
     for (int j = 0; j < delta.extent(0); ++j) {
         delta(j) = 0;
@@ -0,0 +1,346 @@
+#ifndef _COMPADRE_CELLLISTSEARCH_HPP_
+#define _COMPADRE_CELLLISTSEARCH_HPP_
+
+#include "Compadre_Typedefs.hpp"
+#include "Compadre_DeviceNeighborSearch.hpp"
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <limits>
+
+namespace Compadre {
+
+//!  CellListSearch generates neighbor lists and window sizes for each target site from a uniform grid of cells
+/*!
+*  Source sites are binned into a uniform grid of cells over their bounding box with a parallel counting
+*  sort, and each query visits only the cells overlapping its search radius (or, for a k-nearest neighbor
+*  search, rings of cells around the target site until no unvisited cell can hold a nearer site). For
+*  quasi-uniform point clouds this is cheaper to build and to query than a tree.
+*
+*  Unless a `cell_size` is given, cells are sized so that a quasi-uniform point cloud filling its bounding
+*  box has about two source sites per cell. Clouds that leave most cells empty, such as sites on a
+*  lower dimensional manifold, or that crowd many sites into a few cells, are better served by a
+*  PointCloudSearch or BVHSearch, and isQuasiUniform() can be used to make that choice.
+*
+*  The build and the searches run on `device_execution_space`, and compressed row neighbor lists are
+*  generated as described in DeviceNeighborSearch.
+*
+*/
+template <typename view_type>
+class CellListSearch : public DeviceNeighborSearch<CellListSearch<view_type> > {
+
+    public:
+
+        typedef Kokkos::View<double**, layout_right, device_memory_space> coordinates_view_type;
+        typedef Kokkos::View<int*, device_memory_space> index_view_type;
+
+        //! Device copyable view of the cell list, used inside of search kernels
+        struct Tree {
+
+            //! source coordinates ordered by cell
+            coordinates_view_type sorted_pts;
+            //! index of each source site ordered by cell
+            index_view_type sorted_indices;
+            //! sites in cell c are sorted_pts(cell_offsets(c),:) through sorted_pts(cell_offsets(c+1)-1,:)
+            index_view_type cell_offsets;
+            double box_min[3];
+            double inv_cell_size;
+            double cell_size;
+            int num_cells[3];
+            int dim;
+
+            //! Index of the cell containing coordinate x in dimension d, clamped to the grid
+            KOKKOS_INLINE_FUNCTION
+            int getCell(const double x, const int d) const {
+                const double s = (x - box_min[d])*inv_cell_size;
+                if (s <= 0) return 0;
+                const int cell = (int)s;
+                return (cell < num_cells[d]) ? cell : num_cells[d]-1;
+            }
+
+            //! Squared distance from x to the source site at position j in cell order
+            KOKKOS_INLINE_FUNCTION
+            double pointDistance(const double* x, const int j) const {
+                double distance = 0;
+                for (int d=0; d<dim; ++d) {
+                    distance += (x[d]-sorted_pts(j,d))*(x[d]-sorted_pts(j,d));
+                }
+                return distance;
+            }
+
+            //! Calls f(source index, squared distance) for every source site at a squared distance less than r2 from x
+            template <typename F>
+            KOKKOS_INLINE_FUNCTION
+            void radiusSearch(const double* x, const double r2, F& f) const {
+                int lo[3] = {0,0,0}, hi[3] = {0,0,0};
+                for (int d=0; d<dim; ++d) {
+                    // widened by round-off so that no cell holding a site within the radius is missed
+                    const double r = std::sqrt(r2)*(1.0+1e-12) + 1e-12*std::abs(x[d]);
+                    lo[d] = getCell(x[d]-r, d);
+                    hi[d] = getCell(x[d]+r, d);
+                }
+                for (int c2=lo[2]; c2<=hi[2]; ++c2) {
+                    for (int c1=lo[1]; c1<=hi[1]; ++c1) {
+                        // cells adjacent in the first dimension are contiguous in sorted_pts
+                        const int row = (c2*num_cells[1] + c1)*num_cells[0];
+                        const int begin = cell_offsets(row + lo[0]);
+                        const int end = cell_offsets(row + hi[0] + 1);
+                        for (int j=begin; j<end; ++j) {
+                            const double distance = pointDistance(x, j);
+                            if (distance < r2) f(sorted_indices(j), distance);
+                        }
+                    }
+                }
+            }
+
+            //! Finds the k source sites nearest to x, storing their squared distances (as a max heap, so
+            //! heap_distances[0] is the distance to the kth neighbor) and source indices. Returns number found.
+            KOKKOS_INLINE_FUNCTION
+            int knnSearch(const double* x, const int k, double* heap_distances, int* heap_indices) const {
+                if (k <= 0) return 0;
+                int count = 0;
+                int center[3] = {0,0,0};
+                for (int d=0; d<dim; ++d) center[d] = getCell(x[d], d);
+                for (int ring=0; ; ++ring) {
+                    // visit cells whose largest offset from the center cell is ring
+                    int lo[3] = {0,0,0}, hi[3] = {0,0,0};
+                    bool covers_grid = true;
+                    for (int d=0; d<dim; ++d) {
+                        lo[d] = (center[d]-ring > 0) ? center[d]-ring : 0;
+                        hi[d] = (center[d]+ring < num_cells[d]-1) ? center[d]+ring : num_cells[d]-1;
+                        covers_grid = covers_grid && (lo[d]==0) && (hi[d]==num_cells[d]-1);
+                    }
+                    for (int c2=lo[2]; c2<=hi[2]; ++c2) {
+                        const bool c2_on_ring = (dim>2) && (c2==center[2]-ring || c2==center[2]+ring);
+                        for (int c1=lo[1]; c1<=hi[1]; ++c1) {
+                            const bool c1_on_ring = (dim>1) && (c1==center[1]-ring || c1==center[1]+ring);
+                            const int row = (c2*num_cells[1] + c1)*num_cells[0];
+                            for (int c0=lo[0]; c0<=hi[0]; ++c0) {
+                                const bool c0_on_ring = (c0==center[0]-ring || c0==center[0]+ring);
+                                if (!(c0_on_ring || c1_on_ring || c2_on_ring)) {
+                                    // interior of the ring was visited already, so skip to its far side
+                                    c0 = center[0]+ring-1;
+                                    continue;
+                                }
+                                for (int j=cell_offsets(row+c0); j<cell_offsets(row+c0+1); ++j) {
+                                    addToNearestNeighborHeap(pointDistance(x, j), sorted_indices(j), k, count,
+                                            heap_distances, heap_indices);
+                                }
+                            }
+                        }
+                    }
+                    if (covers_grid) break;
+                    if (count==k) {
+                        // distance from x to the nearest cell not yet visited, less round-off
+                        double unvisited_distance = 0;
+                        bool has_unvisited = false;
+                        for (int d=0; d<dim; ++d) {
+                            const double round_off = 1e-12*(std::abs(x[d]) + std::abs(box_min[d]) + num_cells[d]*cell_size);
+                            if (center[d]-ring > 0) {
+                                const double gap = x[d] - (box_min[d] + (center[d]-ring)*cell_size) - round_off;
+                                unvisited_distance = (!has_unvisited || gap < unvisited_distance) ? gap : unvisited_distance;
+                                has_unvisited = true;
+                            }
+                            if (center[d]+ring < num_cells[d]-1) {
+                                const double gap = (box_min[d] + (center[d]+ring+1)*cell_size) - x[d] - round_off;
+                                unvisited_distance = (!has_unvisited || gap < unvisited_distance) ? gap : unvisited_distance;
+                                has_unvisited = true;
+                            }
+                        }
+                        if (unvisited_distance > 0 && unvisited_distance*unvisited_distance > heap_distances[0]) break;
+                    }
+                }
+                return count;
+            }
+        };
+
+    protected:
+
+        //! source site coordinates
+        view_type _src_pts_view;
+        local_index_type _dim;
+        double _cell_size;
+
+        Tree _tree;
+        bool _tree_built;
+
+        //! largest number of source sites in a cell
+        int _max_sites_per_cell;
+        //! number of cells holding at least one source site
+        int _num_occupied_cells;
+
+    public:
+
+        CellListSearch(view_type src_pts_view, const local_index_type dimension = -1,
+                const double cell_size = -1)
+                : _src_pts_view(src_pts_view),
+                  _dim((dimension < 0) ? src_pts_view.extent(1) : dimension),
+                  _cell_size(cell_size),
+                  _tree_built(false),
+                  _max_sites_per_cell(0),
+                  _num_occupied_cells(0) {
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename view_type::memory_space>::accessible==1)
+                    && "Views passed to CellListSearch at construction should be accessible from the device.");
+            compadre_assert_release((_dim>=1 && _dim<=3) && "CellListSearch only supports dimensions 1, 2, and 3.");
+        };
+
+        ~CellListSearch() {};
+
+        //! Returns the dimension of the search
+        int getDimension() const { return _dim; }
+
+        //! Returns the number of source sites
+        int getNumberOfSources() const { return _src_pts_view.extent(0); }
+
+        //! Returns the cell list, building it if needed
+        Tree getTree() {
+            if (!_tree_built) this->generateCellList();
+            return _tree;
+        }
+
+        //! Returns true if source sites are spread evenly over the cells, meaning that at least a quarter
+        //! of the cells are occupied and no cell holds more than max_crowding times the average number
+        //! of sites in an occupied cell. When false, a tree based search is likely to be faster.
+        bool isQuasiUniform(const double max_crowding = 8.0) {
+            if (!_tree_built) this->generateCellList();
+            const int num_pts = _src_pts_view.extent(0);
+            if (num_pts==0) return true;
+            const double total_cells = (double)_tree.num_cells[0]*_tree.num_cells[1]*_tree.num_cells[2];
+            const double average_sites_per_cell = (double)num_pts/_num_occupied_cells;
+            return (4.0*_num_occupied_cells >= total_cells)
+                && (_max_sites_per_cell <= max_crowding*average_sites_per_cell);
+        }
+
+        void generateCellList() {
+
+            const int num_pts = _src_pts_view.extent(0);
+            const int dim = _dim;
+            auto src_pts_view = _src_pts_view;
+
+            double box_min[3] = {0,0,0};
+            double box_max[3] = {0,0,0};
+            getBoundingBoxDevice(src_pts_view, dim, box_min, box_max);
+
+            // cell size giving about two sites per cell if sites fill their bounding box
+            double cell_size = _cell_size;
+            const bool choose_cell_size = (cell_size <= 0);
+            if (choose_cell_size) {
+                double volume = 1.0;
+                int filled_dims = 0;
+                double largest_length = 0;
+                for (int d=0; d<dim; ++d) {
+                    const double length = box_max[d] - box_min[d];
+                    largest_length = (length > largest_length) ? length : largest_length;
+                    if (length > 0) {
+                        volume *= length;
+                        filled_dims++;
+                    }
+                }
+                cell_size = (filled_dims > 0 && num_pts > 0) ?
+                    std::pow(2.0*volume/num_pts, 1.0/filled_dims) : 1.0;
+                // do not let a degenerate bounding box make cells vanishingly small
+                cell_size = (largest_length > 0 && cell_size < largest_length*1e-6) ? largest_length*1e-6 : cell_size;
+            }
+
+            Tree tree;
+            double total_cells = 1;
+            while (true) {
+                tree.dim = dim;
+                tree.cell_size = cell_size;
+                tree.inv_cell_size = 1.0/cell_size;
+                total_cells = 1;
+                for (int d=0; d<3; ++d) {
+                    tree.box_min[d] = box_min[d];
+                    tree.num_cells[d] = (d<dim) ? (int)((box_max[d] - box_min[d])*tree.inv_cell_size) + 1 : 1;
+                    total_cells *= tree.num_cells[d];
+                }
+                // a thin, nearly lower dimensional bounding box can call for many more cells than sites
+                if (!choose_cell_size || total_cells <= 8.0*num_pts + 8.0) break;
+                cell_size *= 2.0;
+            }
+            compadre_assert_release((total_cells < (double)std::numeric_limits<int>::max())
+                    && "cell_size given to CellListSearch leads to too many cells.");
+            const int num_cells = total_cells;
+
+            // parallel counting sort of source sites by cell:
+            // count the sites in each cell, keeping each site's rank among sites in its cell
+            index_view_type cell_of_site("cell of site", num_pts);
+            index_view_type rank_in_cell("rank in cell", num_pts);
+            tree.cell_offsets = index_view_type("cell offsets", num_cells+1);
+            auto cell_offsets = tree.cell_offsets;
+            Kokkos::parallel_for("cell list count", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int i) {
+                int cell = 0;
+                for (int d=dim-1; d>=0; --d) {
+                    cell = cell*tree.num_cells[d] + tree.getCell(src_pts_view(i,d), d);
+                }
+                cell_of_site(i) = cell;
+                rank_in_cell(i) = Kokkos::atomic_fetch_add(&cell_offsets(cell), 1);
+            });
+
+            // largest cell and number of occupied cells, for isQuasiUniform()
+            int max_sites_per_cell = 0;
+            Kokkos::parallel_reduce("cell list max sites per cell", Kokkos::RangePolicy<device_execution_space>(0, num_cells),
+                    KOKKOS_LAMBDA(const int c, int& t_max) {
+                t_max = (cell_offsets(c) > t_max) ? cell_offsets(c) : t_max;
+            }, Kokkos::Max<int>(max_sites_per_cell));
+            int num_occupied_cells = 0;
+            Kokkos::parallel_reduce("cell list occupied cells", Kokkos::RangePolicy<device_execution_space>(0, num_cells),
+                    KOKKOS_LAMBDA(const int c, int& t_occupied) {
+                t_occupied += (cell_offsets(c) > 0) ? 1 : 0;
+            }, Kokkos::Sum<int>(num_occupied_cells));
+
+            // exclusive scan of counts gives the first position of each cell
+            Kokkos::parallel_scan("cell list offsets", Kokkos::RangePolicy<device_execution_space>(0, num_cells+1),
+                    KOKKOS_LAMBDA(const int c, int& lsum, bool final) {
+                const int count = (c < num_cells) ? cell_offsets(c) : 0;
+                if (final) cell_offsets(c) = lsum;
+                lsum += count;
+            });
+
+            // scatter
+            tree.sorted_indices = index_view_type("cell list sorted indices", num_pts);
+            auto sorted_indices = tree.sorted_indices;
+            Kokkos::parallel_for("cell list scatter", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int i) {
+                sorted_indices(cell_offsets(cell_of_site(i)) + rank_in_cell(i)) = i;
+            });
+
+            // ranks from atomics vary from run to run, so order each cell by source index
+            // to keep neighbor lists reproducible
+            Kokkos::parallel_for("cell list sort cells", Kokkos::RangePolicy<device_execution_space>(0, num_cells),
+                    KOKKOS_LAMBDA(const int c) {
+                for (int j=cell_offsets(c)+1; j<cell_offsets(c+1); ++j) {
+                    const int index = sorted_indices(j);
+                    int l = j;
+                    while (l > cell_offsets(c) && sorted_indices(l-1) > index) {
+                        sorted_indices(l) = sorted_indices(l-1);
+                        --l;
+                    }
+                    sorted_indices(l) = index;
+                }
+            });
+
+            tree.sorted_pts = coordinates_view_type("cell list sorted coordinates", num_pts, dim);
+            auto sorted_pts = tree.sorted_pts;
+            Kokkos::parallel_for("cell list sorted coordinates", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int j) {
+                for (int d=0; d<dim; ++d) sorted_pts(j,d) = src_pts_view(sorted_indices(j),d);
+            });
+            Kokkos::fence();
+
+            _tree = tree;
+            _max_sites_per_cell = max_sites_per_cell;
+            _num_occupied_cells = num_occupied_cells;
+            _tree_built = true;
+        }
+}; // CellListSearch
+
+//! CreateCellListSearch allows for the construction of an object of type CellListSearch with template deduction
+template <typename view_type>
+CellListSearch<view_type> CreateCellListSearch(view_type src_view, const local_index_type dimensions = -1, const double cell_size = -1) {
+    return CellListSearch<view_type>(src_view, dimensions, cell_size);
+}
+
+} // Compadre
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef _COMPADRE_DEVICENEIGHBORSEARCH_HPP_
+#define _COMPADRE_DEVICENEIGHBORSEARCH_HPP_
+
+#include "Compadre_Typedefs.hpp"
+#include "Compadre_NeighborLists.hpp"
+#include <Kokkos_Core.hpp>
+
+namespace Compadre {
+
+//! Adds a neighbor to a max heap of the (at most k) nearest neighbors found so far, ordered by squared distance,
+//! so that heap_distances[0] is always the squared distance to the farthest of them
+KOKKOS_INLINE_FUNCTION
+void addToNearestNeighborHeap(const double distance, const int index, const int k, int& count,
+        double* heap_distances, int* heap_indices) {
+    if (count < k) {
+        // sift up
+        int child = count++;
+        while (child > 0) {
+            const int parent = (child-1)/2;
+            if (heap_distances[parent] >= distance) break;
+            heap_distances[child] = heap_distances[parent];
+            heap_indices[child] = heap_indices[parent];
+            child = parent;
+        }
+        heap_distances[child] = distance;
+        heap_indices[child] = index;
+    } else if (distance < heap_distances[0]) {
+        // replace the farthest and sift down
+        int parent = 0;
+        while (true) {
+            int child = 2*parent+1;
+            if (child >= k) break;
+            if (child+1 < k && heap_distances[child+1] > heap_distances[child]) child++;
+            if (heap_distances[child] <= distance) break;
+            heap_distances[parent] = heap_distances[child];
+            heap_indices[parent] = heap_indices[child];
+            parent = child;
+        }
+        heap_distances[parent] = distance;
+        heap_indices[parent] = index;
+    }
+}
+
+//! Computes the bounding box of the first dim coordinates of the sites in pts_view on the device
+template <typename view_type>
+void getBoundingBoxDevice(view_type pts_view, const int dim, double* box_min, double* box_max) {
+    const int num_pts = pts_view.extent(0);
+    for (int d=0; d<dim; ++d) {
+        double d_min = 0, d_max = 0;
+        if (num_pts > 0) {
+            Kokkos::parallel_reduce("bounding box min", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int i, double& t_min) {
+                t_min = (pts_view(i,d) < t_min) ? pts_view(i,d) : t_min;
+            }, Kokkos::Min<double>(d_min));
+            Kokkos::parallel_reduce("bounding box max", Kokkos::RangePolicy<device_execution_space>(0, num_pts),
+                    KOKKOS_LAMBDA(const int i, double& t_max) {
+                t_max = (pts_view(i,d) > t_max) ? pts_view(i,d) : t_max;
+            }, Kokkos::Max<double>(d_max));
+        }
+        box_min[d] = d_min;
+        box_max[d] = d_max;
+    }
+}
+
+//!  DeviceNeighborSearch generates compressed row neighbor lists and window sizes on the device
+/*!
+*  Base class of neighbor searches whose structure can be queried from inside of a kernel on
+*  `device_execution_space`. The derived search_type provides:
+*
+*    - `getTree()`, returning a device copyable object with the member functions
+*      `radiusSearch(x, r2, f)`, calling f(source index, squared distance) for every source site at a
+*      squared distance less than r2 from x, and `knnSearch(x, k, heap_distances, heap_indices)`,
+*      filling a heap with the k nearest source sites (see addToNearestNeighborHeap) and returning
+*      the number found,
+*    - `getDimension()` and `getNumberOfSources()`.
+*
+*  Search methods follow the dry-run conventions of PointCloudSearch for compressed row neighbor lists:
+*
+*  #### When in dry-run mode:
+*
+*    `number_of_neighbors_list` will be populated with number of neighbors found for each target site.
+*
+*  #### When not in dry-run mode:
+*
+*    `neighbor_lists` will be populated with the neighbors of each target site, with row offsets
+*    computed from `number_of_neighbors_list`. As for PointCloudSearch, the closest neighbor is stored
+*    first and the rest are in no particular order.
+*
+*/
+template <typename search_type>
+class DeviceNeighborSearch {
+
+    public:
+
+        /*! \brief Generates compressed row neighbor lists by performing a radius search
+            where the radius to be searched is in the epsilons view.
+            If uniform_radius is given, then this overrides the epsilons view radii sizes.
+            Accepts 1D neighbor_lists with 1D number_of_neighbors_list, all accessible from the device.
+            \param is_dry_run               [in] - whether to do a dry-run (find neighbors, but don't store)
+            \param trg_pts_view             [in] - target coordinates from which to seek neighbors
+            \param neighbor_lists           [out] - 1D view of neighbor lists to be populated from search
+            \param number_of_neighbors_list [in/out] - number of neighbors for each target site
+            \param epsilons                 [in/out] - radius to search, overwritten if uniform_radius != 0
+            \param uniform_radius           [in] - double != 0 determines whether to overwrite all epsilons for uniform search
+            \param max_search_radius        [in] - largest valid search (useful only for MPI jobs if halo size exists)
+        */
+        template <typename trg_view_type, typename neighbor_lists_view_type, typename epsilons_view_type>
+        size_t generateCRNeighborListsFromRadiusSearch(bool is_dry_run, trg_view_type trg_pts_view,
+                neighbor_lists_view_type neighbor_lists, neighbor_lists_view_type number_of_neighbors_list,
+                epsilons_view_type epsilons, const double uniform_radius = 0.0, double max_search_radius = 0.0) {
+
+            // function does not populate epsilons, they must be prepopulated
+
+            const int dim = static_cast<search_type*>(this)->getDimension();
+
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename trg_view_type::memory_space>::accessible==1) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromRadiusSearch should be accessible from the device.");
+            compadre_assert_release((((int)trg_pts_view.extent(1))>=dim) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromRadiusSearch must have \
+                    second dimension as large as _dim.");
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename neighbor_lists_view_type::memory_space>::accessible==1) &&
+                    "Views passed to generateCRNeighborListsFromRadiusSearch should be accessible from the device.");
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename epsilons_view_type::memory_space>::accessible==1) &&
+                    "Views passed to generateCRNeighborListsFromRadiusSearch should be accessible from the device.");
+
+            // loop size
+            const int num_target_sites = trg_pts_view.extent(0);
+
+            compadre_assert_release((number_of_neighbors_list.extent(0)==(size_t)num_target_sites)
+                        && "number_of_neighbors_list or neighbor lists View does not have large enough dimensions");
+            compadre_assert_release((neighbor_lists_view_type::rank==1) && "neighbor_lists must be a 1D Kokkos view.");
+            compadre_assert_release((epsilons.extent(0)==(size_t)num_target_sites)
+                        && "epsilons View does not have the correct dimension");
+
+            const auto tree = static_cast<search_type*>(this)->getTree();
+
+            // row offsets from a previous dry-run
+            Kokkos::View<global_index_type*, device_memory_space> row_offsets;
+            if (!is_dry_run) {
+                row_offsets = Kokkos::View<global_index_type*, device_memory_space>("row offsets", num_target_sites);
+                Kokkos::parallel_scan("device search row offsets", Kokkos::RangePolicy<device_execution_space>(0, num_target_sites),
+                        KOKKOS_LAMBDA(const int i, global_index_type& lsum, bool final) {
+                    if (final) row_offsets(i) = lsum;
+                    lsum += number_of_neighbors_list(i);
+                });
+                global_index_type total_storage_size = 0;
+                Kokkos::parallel_reduce("device search total number of neighbors", Kokkos::RangePolicy<device_execution_space>(0, num_target_sites),
+                        KOKKOS_LAMBDA(const int i, global_index_type& t_total) {
+                    t_total += number_of_neighbors_list(i);
+                }, Kokkos::Sum<global_index_type>(total_storage_size));
+                compadre_assert_release((total_storage_size<=neighbor_lists.extent(0))
+                        && "neighbor_lists is not large enough to store all neighbors.");
+            }
+
+            typedef typename neighbor_lists_view_type::non_const_value_type neighbor_index_type;
+
+            Kokkos::parallel_for("device radius search", Kokkos::RangePolicy<device_execution_space>(0, num_target_sites),
+                    KOKKOS_LAMBDA(const int i) {
+
+                // set epsilons if radius is specified
+                if (uniform_radius > 0) epsilons(i) = uniform_radius;
+
+                compadre_kernel_assert_release((epsilons(i)<=max_search_radius || max_search_radius==0) && "max_search_radius given (generally derived from the size of a halo region), and search radius needed would exceed this max_search_radius.");
+
+                double x[3] = {0,0,0};
+                for (int d=0; d<dim; ++d) x[d] = trg_pts_view(i,d);
+
+                int neighbors_found = 0;
+                if (is_dry_run) {
+                    auto count_neighbor = [&](const int j, const double distance) {
+                        neighbors_found++;
+                    };
+                    tree.radiusSearch(x, epsilons(i)*epsilons(i), count_neighbor);
+                    number_of_neighbors_list(i) = neighbors_found;
+                } else {
+                    const global_index_type offset = row_offsets(i);
+                    const int row_size = number_of_neighbors_list(i);
+                    int closest = 0;
+                    double closest_distance = 0;
+                    auto store_neighbor = [&](const int j, const double distance) {
+                        if (neighbors_found < row_size) {
+                            if (neighbors_found==0 || distance < closest_distance) {
+                                closest = neighbors_found;
+                                closest_distance = distance;
+                            }
+                            neighbor_lists(offset+neighbors_found) = static_cast<neighbor_index_type>(j);
+                        }
+                        neighbors_found++;
+                    };
+                    tree.radiusSearch(x, epsilons(i)*epsilons(i), store_neighbor);
+                    compadre_kernel_assert_debug((neighbors_found==row_size)
+                            && "Number of neighbors found changed since dry-run.");
+
+                    // puts closest neighbor as the first entry in the neighbor list
+                    if (closest != 0) {
+                        const neighbor_index_type tmp = neighbor_lists(offset);
+                        neighbor_lists(offset) = neighbor_lists(offset+closest);
+                        neighbor_lists(offset+closest) = tmp;
+                    }
+                }
+            });
+            Kokkos::fence();
+
+            global_index_type total_num_neighbors = 0;
+            Kokkos::parallel_reduce("device search total number of neighbors", Kokkos::RangePolicy<device_execution_space>(0, num_target_sites),
+                    KOKKOS_LAMBDA(const int i, global_index_type& t_total) {
+                t_total += number_of_neighbors_list(i);
+            }, Kokkos::Sum<global_index_type>(total_num_neighbors));
+            Kokkos::fence();
+            return total_num_neighbors;
+        }
+
+        /*! \brief Generates compressed row neighbor lists by performing a k-nearest neighbor search
+            Only accepts 1D neighbor_lists with 1D number_of_neighbors_list, all accessible from the device.
+            \param is_dry_run               [in] - whether to do a dry-run (find neighbors, but don't store)
+            \param trg_pts_view             [in] - target coordinates from which to seek neighbors
+            \param neighbor_lists           [out] - 1D view of neighbor lists to be populated from search
+            \param number_of_neighbors_list [in/out] - number of neighbors for each target site
+            \param epsilons                 [in/out] - radius to search, overwritten if uniform_radius != 0
+            \param neighbors_needed         [in] - k neighbors needed as a minimum
+            \param epsilon_multiplier       [in] - distance to kth neighbor multiplied by epsilon_multiplier for follow-on radius search
+            \param max_search_radius        [in] - largest valid search (useful only for MPI jobs if halo size exists)
+        */
+        template <typename trg_view_type, typename neighbor_lists_view_type, typename epsilons_view_type>
+        size_t generateCRNeighborListsFromKNNSearch(bool is_dry_run, trg_view_type trg_pts_view,
+                neighbor_lists_view_type neighbor_lists, neighbor_lists_view_type number_of_neighbors_list,
+                epsilons_view_type epsilons, const int neighbors_needed, const double epsilon_multiplier = 1.6,
+                double max_search_radius = 0.0) {
+
+            // First, do a knn search (removes need for guessing initial search radius)
+
+            const int dim = static_cast<search_type*>(this)->getDimension();
+
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename trg_view_type::memory_space>::accessible==1) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromKNNSearch should be accessible from the device.");
+            compadre_assert_release((((int)trg_pts_view.extent(1))>=dim) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromKNNSearch must have \
+                    second dimension as large as _dim.");
+            compadre_assert_release((Kokkos::SpaceAccessibility<device_execution_space, typename epsilons_view_type::memory_space>::accessible==1) &&
+                    "Views passed to generateCRNeighborListsFromKNNSearch should be accessible from the device.");
+
+            // loop size
+            const int num_target_sites = trg_pts_view.extent(0);
+
+            compadre_assert_release((epsilons.extent(0)==(size_t)num_target_sites)
+                        && "epsilons View does not have the correct dimension");
+
+            // Next, check that we can find the neighbors_needed number that we require for unisolvency
+            compadre_assert_release((num_target_sites==0
+                        || (static_cast<search_type*>(this)->getNumberOfSources()>=neighbors_needed))
+                    && "Neighbor search failed to find number of neighbors needed for unisolvency.");
+
+            const auto tree = static_cast<search_type*>(this)->getTree();
+
+#ifdef COMPADRE_USE_CUDA
+            const int threads_per_team = 32;
+#else
+            const int threads_per_team = 1;
+#endif
+            const int league_size = (num_target_sites + threads_per_team - 1)/threads_per_team;
+
+            // each thread keeps a heap of its target site's k nearest neighbors in scratch
+            int thread_scratch_size = 0;
+            thread_scratch_size += scratch_vector_type::shmem_size(neighbors_needed); // squared distances
+            thread_scratch_size += scratch_local_index_type::shmem_size(neighbors_needed); // indices
+
+            Kokkos::parallel_for("device knn search", team_policy(league_size, threads_per_team)
+                    .set_scratch_size(0 /*shared memory level*/, Kokkos::PerThread(thread_scratch_size)),
+                    KOKKOS_LAMBDA(const member_type& teamMember) {
+
+                scratch_vector_type heap_distances(teamMember.thread_scratch(0 /*shared memory*/), neighbors_needed);
+                scratch_local_index_type heap_indices(teamMember.thread_scratch(0 /*shared memory*/), neighbors_needed);
+
+                const int begin = teamMember.league_rank()*threads_per_team;
+                const int end = (begin + threads_per_team < num_target_sites) ? begin + threads_per_team : num_target_sites;
+                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, begin, end), [&](const int i) {
+
+                    double x[3] = {0,0,0};
+                    for (int d=0; d<dim; ++d) x[d] = trg_pts_view(i,d);
+
+                    const int neighbors_found = tree.knnSearch(x, neighbors_needed, heap_distances.data(), heap_indices.data());
+
+                    // scale by epsilon_multiplier to window from location where the last neighbor was found
+                    epsilons(i) = (neighbors_found > 0 && heap_distances(0) > 0) ?
+                        std::sqrt(heap_distances(0))*epsilon_multiplier : 1e-14*epsilon_multiplier;
+                    // the only time the second case using 1e-14 is used is when either zero neighbors or exactly one
+                    // neighbor (neighbor is target site) is found.  when the follow on radius search is conducted, the one
+                    // neighbor (target site) will not be found if left at 0, so any positive amount will do, however 1e-14
+                    // should is small enough to ensure that other neighbors are not found
+
+                    compadre_kernel_assert_release((epsilons(i)<=max_search_radius || max_search_radius==0 || is_dry_run)
+                            && "max_search_radius given (generally derived from the size of a halo region), \
+                                and search radius needed would exceed this max_search_radius.");
+                });
+            });
+            Kokkos::fence();
+
+            // call a radius search using values now stored in epsilons
+            return generateCRNeighborListsFromRadiusSearch(is_dry_run, trg_pts_view, neighbor_lists,
+                    number_of_neighbors_list, epsilons, 0.0 /*don't set uniform radius*/, max_search_radius);
+        }
+
+}; // DeviceNeighborSearch
+
+} // Compadre
+
+#endif
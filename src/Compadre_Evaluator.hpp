@@ -151,6 +151,8 @@ public:
 
         const int alpha_input_output_component_index = _gmls->_h_ss.getAlphaColumnOffset(lro, output_component_axis_1, 
                 output_component_axis_2, input_component_axis_1, input_component_axis_2, evaluation_site_local_index);
+        // alphas for these components are all zero
+        if (alpha_input_output_component_index < 0) return value;
 
         auto sampling_subview_maker = CreateNDSliceOnDeviceView(sampling_input_data, scalar_as_vector_if_needed);
 
@@ -207,6 +209,8 @@ public:
         const int alpha_input_output_component_index = _gmls->_h_ss.getAlphaColumnOffset(lro, output_component_axis_1, 
                 output_component_axis_2, input_component_axis_1, input_component_axis_2, evaluation_site_local_index);
         const int alpha_input_output_component_index2 = alpha_input_output_component_index;
+        // alphas for these components are all zero, so they add nothing to the output
+        if (alpha_input_output_component_index < 0) return;
 
         // gather needed information for evaluation
         auto nla = *(_gmls->getNeighborLists());
@@ -14,14 +14,22 @@
 
 namespace Compadre {
 
+//! Data needed by functors to assemble, solve, and evaluate targets for a batch, where the dense solve 
+//! (P, RHS, and polynomial coefficients) is performed with solve_scalar_type
+template <typename solve_scalar_type>
 struct GMLSBasisData {
 
+    //! unmanaged view of a matrix in the dense solve
+    typedef Kokkos::View<solve_scalar_type**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            solve_matrix_type;
+
     Kokkos::View<double**, layout_right> _source_extra_data;
     Kokkos::View<double**, layout_right> _target_extra_data;
     Kokkos::View<double*> _epsilons; 
     Kokkos::View<double*****, layout_right> _prestencil_weights; 
     Kokkos::View<TargetOperation*> _curvature_support_operations;
     Kokkos::View<TargetOperation*> _operations;
+    Kokkos::View<int*> _batch_target_indices;
 
     int _poly_order; 
     int _curvature_poly_order;
@@ -58,13 +66,13 @@ struct GMLSBasisData {
 
     // convenience variables (not from GMLS class)
     int RHS_dim_0, RHS_dim_1;
-    double * RHS_data;
+    solve_scalar_type * RHS_data;
     int P_dim_0, P_dim_1;
-    double * P_data;
+    solve_scalar_type * P_data;
     int P_target_row_dim_0, P_target_row_dim_1;
     double * P_target_row_data;
     int Coeffs_dim_0, Coeffs_dim_1;
-    double * Coeffs_data;
+    solve_scalar_type * Coeffs_data;
     double * w_data;
     int max_num_rows;
     int manifold_NP;
@@ -79,36 +87,73 @@ struct GMLSBasisData {
     int manifold_gradient_dim;
 
     GMLSBasisData() : _polynomial_sampling_functional(PointSample), _data_sampling_functional(PointSample) {}
+
+    //! Target index of the local_index-th target in the batch
+    KOKKOS_INLINE_FUNCTION
+    int getTargetIndex(const int local_index) const {
+        return (_batch_target_indices.extent(0) > 0) ? 
+            _batch_target_indices(_initial_index_for_batch + local_index) : _initial_index_for_batch + local_index;
+    }
 };
 
+//! Data needed by functors to apply target evaluations to polynomial coefficients for a batch, where
+//! polynomial coefficients are stored as solve_scalar_type
+template <typename solve_scalar_type>
 struct GMLSSolutionData {
 
+    //! unmanaged view of a matrix in the dense solve
+    typedef Kokkos::View<solve_scalar_type**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            solve_matrix_type;
+
     int _sampling_multiplier;
+    int _number_of_diagonal_blocks;
     int _initial_index_for_batch;
+    Kokkos::View<int*> _batch_target_indices;
+    Kokkos::View<double**, layout_right> _sampling_data;
+    Kokkos::View<double**, layout_right> _target_output;
+    Kokkos::View<double*> _epsilons;
+    //! empty unless GMLS::usesAnalyticTargetRows, in which case P_target_row is not used
+    Kokkos::View<int**, layout_right> _analytic_target_rows;
     SolutionSet<device_memory_space> _d_ss;
 
     // convenience variables (not from GMLS class)
     int this_num_cols;
+    int total_output_values;
     int Coeffs_dim_0, Coeffs_dim_1;
-    double * Coeffs_data;
+    solve_scalar_type * Coeffs_data;
     int P_target_row_dim_0, P_target_row_dim_1;
     double * P_target_row_data;
     size_t operations_size;
     Kokkos::View<int*> number_of_neighbors_list;
     Kokkos::View<int*> additional_number_of_neighbors_list;
 
+    //! Target index of the local_index-th target in the batch
+    KOKKOS_INLINE_FUNCTION
+    int getTargetIndex(const int local_index) const {
+        return (_batch_target_indices.extent(0) > 0) ? 
+            _batch_target_indices(_initial_index_for_batch + local_index) : _initial_index_for_batch + local_index;
+    }
+
 };
 
-const GMLSSolutionData createGMLSSolutionData(const GMLS& gmls) {
+template <typename solve_scalar_type>
+const GMLSSolutionData<solve_scalar_type> createGMLSSolutionData(const GMLS& gmls) {
 
-    auto data = GMLSSolutionData();
+    auto data = GMLSSolutionData<solve_scalar_type>();
     data._sampling_multiplier = gmls._sampling_multiplier;
+    data._number_of_diagonal_blocks = gmls._number_of_diagonal_blocks;
     data._initial_index_for_batch = gmls._initial_index_for_batch;
+    data._batch_target_indices = gmls._batch_target_indices;
+    data._sampling_data = gmls._sampling_data;
+    data._target_output = gmls._target_output;
+    data._epsilons = gmls._epsilons;
+    if (gmls.usesAnalyticTargetRows()) data._analytic_target_rows = gmls._analytic_target_rows;
     data._d_ss = gmls._d_ss;
 
     // store results of calculation in struct
-    const int max_num_rows = gmls._sampling_multiplier*gmls._max_num_neighbors;
-    data.this_num_cols = gmls._basis_multiplier*gmls._NP;
+    // (coefficients are for one of the identical diagonal blocks of P)
+    const int max_num_rows = (gmls._sampling_multiplier/gmls._number_of_diagonal_blocks)*gmls._max_num_neighbors;
+    data.this_num_cols = (gmls._basis_multiplier/gmls._number_of_diagonal_blocks)*gmls._NP;
     int RHS_dim_0, RHS_dim_1;
     getRHSDims(gmls._dense_solver_type, gmls._constraint_type, gmls._reconstruction_space, 
             gmls._dimensions, max_num_rows, data.this_num_cols, RHS_dim_0, RHS_dim_1);
@@ -116,21 +161,23 @@ const GMLSSolutionData createGMLSSolutionData(const GMLS& gmls) {
     getPDims(gmls._dense_solver_type, gmls._constraint_type, gmls._reconstruction_space, 
             gmls._dimensions, max_num_rows, data.this_num_cols, P_dim_0, P_dim_1);
 
-    if ((gmls._constraint_type == ConstraintType::NO_CONSTRAINT) && (gmls._dense_solver_type != DenseSolverType::LU)) {
-        data.Coeffs_data = gmls._RHS.data();
+    if ((gmls._constraint_type == ConstraintType::NO_CONSTRAINT) && !solvesNormalEquations(gmls._dense_solver_type)) {
+        data.Coeffs_data = gmls.getSolveData<solve_scalar_type>(gmls._RHS, gmls._RHS_float);
         data.Coeffs_dim_0 = RHS_dim_0;
         data.Coeffs_dim_1 = RHS_dim_1;
     } else {
-        data.Coeffs_data = gmls._P.data();
+        data.Coeffs_data = gmls.getSolveData<solve_scalar_type>(gmls._P, gmls._P_float);
         data.Coeffs_dim_0 = P_dim_1;
         data.Coeffs_dim_1 = P_dim_0;
     }
 
     data.P_target_row_dim_0 = gmls._d_ss._total_alpha_values*gmls._d_ss._max_evaluation_sites_per_target;
-    data.P_target_row_dim_1 = data.this_num_cols;
+    data.P_target_row_dim_1 = gmls._basis_multiplier*gmls._NP;
     data.P_target_row_data = gmls._Z.data();
 
     data.operations_size = gmls._operations.size();
+    data.total_output_values = (gmls._d_ss._max_evaluation_sites_per_target > 0) ? 
+        gmls._target_output.extent(1)/gmls._d_ss._max_evaluation_sites_per_target : 0;
 
     data.number_of_neighbors_list = gmls._pc._nla._number_of_neighbors_list;
     data.additional_number_of_neighbors_list = gmls._additional_pc._nla._number_of_neighbors_list;
@@ -139,8 +186,9 @@ const GMLSSolutionData createGMLSSolutionData(const GMLS& gmls) {
 
 }
 
-const GMLSBasisData createGMLSBasisData(const GMLS& gmls) {
-    auto data = GMLSBasisData();
+template <typename solve_scalar_type>
+const GMLSBasisData<solve_scalar_type> createGMLSBasisData(const GMLS& gmls) {
+    auto data = GMLSBasisData<solve_scalar_type>();
     data._source_extra_data = gmls._source_extra_data;
     data._target_extra_data = gmls._target_extra_data;
     data._pc = gmls._pc;
@@ -172,6 +220,7 @@ const GMLSBasisData createGMLSBasisData(const GMLS& gmls) {
     data._sampling_multiplier = gmls._sampling_multiplier;
     data._data_sampling_multiplier = gmls._data_sampling_multiplier;
     data._initial_index_for_batch = gmls._initial_index_for_batch;
+    data._batch_target_indices = gmls._batch_target_indices;
     data._max_num_neighbors = gmls._max_num_neighbors;
     data._pm = gmls._pm;
     data._order_of_quadrature_points = gmls._order_of_quadrature_points;
@@ -179,7 +228,7 @@ const GMLSBasisData createGMLSBasisData(const GMLS& gmls) {
     data._qm = gmls._qm;
     data._d_ss = gmls._d_ss;
 
-    data.max_num_rows = gmls._sampling_multiplier*gmls._max_num_neighbors;
+    data.max_num_rows = (gmls._sampling_multiplier/gmls._number_of_diagonal_blocks)*gmls._max_num_neighbors;
     if (gmls._problem_type == ProblemType::MANIFOLD) {
         data.manifold_NP = GMLS::getNP(gmls._curvature_poly_order, gmls._dimensions-1, 
                 ReconstructionSpace::ScalarTaylorPolynomial);
@@ -210,22 +259,25 @@ const GMLSBasisData createGMLSBasisData(const GMLS& gmls) {
     data.P_target_row_dim_1 = data.this_num_cols;
     data.P_target_row_data = gmls._Z.data();
 
-    data.RHS_data = gmls._RHS.data();
+    // the dense solve is for one of the identical diagonal blocks of P (see createDiagonalBlockBasisData)
+    const int solve_num_cols = data.this_num_cols/gmls._number_of_diagonal_blocks;
+
+    data.RHS_data = gmls.getSolveData<solve_scalar_type>(gmls._RHS, gmls._RHS_float);
     getRHSDims(gmls._dense_solver_type, gmls._constraint_type, gmls._reconstruction_space, 
-               gmls._dimensions, data.max_num_rows, data.this_num_cols, data.RHS_dim_0, data.RHS_dim_1);
+               gmls._dimensions, data.max_num_rows, solve_num_cols, data.RHS_dim_0, data.RHS_dim_1);
 
-    data.P_data = gmls._P.data();
+    data.P_data = gmls.getSolveData<solve_scalar_type>(gmls._P, gmls._P_float);
     getPDims(gmls._dense_solver_type, gmls._constraint_type, gmls._reconstruction_space, 
-             gmls._dimensions, data.max_num_rows, data.this_num_cols, data.P_dim_0, data.P_dim_1);
+             gmls._dimensions, data.max_num_rows, solve_num_cols, data.P_dim_0, data.P_dim_1);
 
     data.w_data = gmls._w.data();
 
-    if ((gmls._constraint_type == ConstraintType::NO_CONSTRAINT) && (gmls._dense_solver_type != DenseSolverType::LU)) {
-        data.Coeffs_data = gmls._RHS.data();
+    if ((gmls._constraint_type == ConstraintType::NO_CONSTRAINT) && !solvesNormalEquations(gmls._dense_solver_type)) {
+        data.Coeffs_data = gmls.getSolveData<solve_scalar_type>(gmls._RHS, gmls._RHS_float);
         data.Coeffs_dim_0 = data.RHS_dim_0;
         data.Coeffs_dim_1 = data.RHS_dim_1;
     } else {
-        data.Coeffs_data = gmls._P.data();
+        data.Coeffs_data = gmls.getSolveData<solve_scalar_type>(gmls._P, gmls._P_float);
         data.Coeffs_dim_0 = data.P_dim_1;
         data.Coeffs_dim_1 = data.P_dim_0;
     }
@@ -233,17 +285,70 @@ const GMLSBasisData createGMLSBasisData(const GMLS& gmls) {
     return data;
 }
 
+//! Basis data for assembling one of the identical diagonal blocks of P (see GMLS::_number_of_diagonal_blocks), 
+//! which is P for a ScalarTaylorPolynomial basis sampled with PointSample
+template <typename solve_scalar_type>
+const GMLSBasisData<solve_scalar_type> createDiagonalBlockBasisData(const GMLSBasisData<solve_scalar_type>& full_data) {
+    auto data = full_data;
+    data._reconstruction_space = ReconstructionSpace::ScalarTaylorPolynomial;
+    data._reconstruction_space_rank = 0;
+    data._polynomial_sampling_functional = PointSample;
+    data._basis_multiplier = 1;
+    data._sampling_multiplier = 1;
+    data.this_num_cols = data._NP;
+    return data;
+}
+
 /** @name Functors
  *  Member functions that perform operations on the entire batch
  */
 ///@{
 
 //! Functor to apply target evaluation to polynomial coefficients to store in _alphas
+template <typename solve_scalar_type>
 struct ApplyTargets {
 
-    GMLSSolutionData _data;
+    typedef typename GMLSSolutionData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
+
+    GMLSSolutionData<solve_scalar_type> _data;
+
+    ApplyTargets(GMLSSolutionData<solve_scalar_type> data) : _data(data) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const member_type& teamMember) const {
+
+        const int local_index  = teamMember.league_rank();
+
+        /*
+         *    Data
+         */
+
+        // Coefficients for polynomial basis have overwritten _data._RHS
+        solve_matrix_type Coeffs = solve_matrix_type(_data.Coeffs_data 
+                + TO_GLOBAL(local_index)*TO_GLOBAL(_data.Coeffs_dim_0*_data.Coeffs_dim_1), 
+                    _data.Coeffs_dim_0, _data.Coeffs_dim_1);
+        scratch_matrix_right_type P_target_row(_data.P_target_row_data 
+                + TO_GLOBAL(local_index)*TO_GLOBAL(_data.P_target_row_dim_0*_data.P_target_row_dim_1), 
+                    _data.P_target_row_dim_0, _data.P_target_row_dim_1);
+
+        if (_data._analytic_target_rows.extent(0) > 0) {
+            applyAnalyticTargetsToCoefficients(_data, teamMember, Coeffs);
+        } else {
+            applyTargetsToCoefficients(_data, teamMember, Coeffs, P_target_row); 
+        }
+    }
+};
+
+//! Functor to apply target evaluation to polynomial coefficients and contract against sampling data,
+//! storing target outputs in _target_output rather than alphas
+template <typename solve_scalar_type>
+struct ApplyTargetsToData {
+
+    typedef typename GMLSSolutionData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
 
-    ApplyTargets(GMLSSolutionData data) : _data(data) {}
+    GMLSSolutionData<solve_scalar_type> _data;
+
+    ApplyTargetsToData(GMLSSolutionData<solve_scalar_type> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -255,23 +360,26 @@ struct ApplyTargets {
          */
 
         // Coefficients for polynomial basis have overwritten _data._RHS
-        scratch_matrix_right_type Coeffs = scratch_matrix_right_type(_data.Coeffs_data 
+        solve_matrix_type Coeffs = solve_matrix_type(_data.Coeffs_data 
                 + TO_GLOBAL(local_index)*TO_GLOBAL(_data.Coeffs_dim_0*_data.Coeffs_dim_1), 
                     _data.Coeffs_dim_0, _data.Coeffs_dim_1);
         scratch_matrix_right_type P_target_row(_data.P_target_row_data 
                 + TO_GLOBAL(local_index)*TO_GLOBAL(_data.P_target_row_dim_0*_data.P_target_row_dim_1), 
                     _data.P_target_row_dim_0, _data.P_target_row_dim_1);
 
-        applyTargetsToCoefficients(_data, teamMember, Coeffs, P_target_row); 
+        applyTargetsToCoefficientsAndData(_data, teamMember, Coeffs, P_target_row); 
     }
 };
 
 //! Functor to evaluate targets operations on the basis
+template <typename solve_scalar_type>
 struct EvaluateStandardTargets {
 
-    GMLSBasisData _data;
+    typedef typename GMLSBasisData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
+
+    GMLSBasisData<solve_scalar_type> _data;
 
-    EvaluateStandardTargets(GMLSBasisData data) : _data(data) {}
+    EvaluateStandardTargets(GMLSBasisData<solve_scalar_type> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -304,11 +412,14 @@ struct EvaluateStandardTargets {
 };
 
 //! Functor to calculate prestencil weights to apply to data to transform into a format expected by a GMLS stencil
+template <typename solve_scalar_type>
 struct ComputePrestencilWeights {
 
-    GMLSBasisData _data;
+    typedef typename GMLSBasisData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
+
+    GMLSBasisData<solve_scalar_type> _data;
 
-    ComputePrestencilWeights(GMLSBasisData data) : _data(data) {}
+    ComputePrestencilWeights(GMLSBasisData<solve_scalar_type> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -317,7 +428,7 @@ struct ComputePrestencilWeights {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         const int dimensions   = _data._dimensions;
 
@@ -349,7 +460,7 @@ struct ComputePrestencilWeights {
 
 
         // holds polynomial coefficients for curvature reconstruction
-        scratch_matrix_right_type Q = scratch_matrix_right_type(_data.Coeffs_data 
+        solve_matrix_type Q = solve_matrix_type(_data.Coeffs_data 
                 + TO_GLOBAL(local_index)*TO_GLOBAL(_data.Coeffs_dim_0*_data.Coeffs_dim_1),
                     _data.Coeffs_dim_0, _data.Coeffs_dim_1);
 
@@ -509,11 +620,14 @@ struct ComputePrestencilWeights {
 };
 
 //! Functor to assemble the P*sqrt(weights) matrix and construct sqrt(weights)*Identity
+template <typename solve_scalar_type>
 struct AssembleStandardPsqrtW {
 
-    GMLSBasisData _data;
+    typedef typename GMLSBasisData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
+
+    GMLSBasisData<solve_scalar_type> _data;
 
-    AssembleStandardPsqrtW(GMLSBasisData data) : _data(data) {}
+    AssembleStandardPsqrtW(GMLSBasisData<solve_scalar_type> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -522,7 +636,7 @@ struct AssembleStandardPsqrtW {
          *    Dimensions
          */
     
-        const int target_index  = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index  = _data.getTargetIndex(teamMember.league_rank());
         const int local_index   = teamMember.league_rank();
         const int this_num_rows = _data._sampling_multiplier*_data._pc._nla.getNumberOfNeighborsDevice(target_index);
     
@@ -530,10 +644,10 @@ struct AssembleStandardPsqrtW {
          *    Data
          */
     
-        scratch_matrix_right_type PsqrtW(_data.P_data
+        solve_matrix_type PsqrtW(_data.P_data
                 + TO_GLOBAL(local_index)*TO_GLOBAL(_data.P_dim_0*_data.P_dim_1), 
                     _data.P_dim_0, _data.P_dim_1);
-        scratch_matrix_right_type RHS(_data.RHS_data
+        solve_matrix_type RHS(_data.RHS_data
                 + TO_GLOBAL(local_index)*TO_GLOBAL(_data.RHS_dim_0*_data.RHS_dim_1), 
                     _data.RHS_dim_0, _data.RHS_dim_1);
         scratch_vector_type w(_data.w_data
@@ -555,34 +669,23 @@ struct AssembleStandardPsqrtW {
                 _data._poly_order, true /*weight_p*/, NULL /*&V*/, _data._reconstruction_space, 
                 _data._polynomial_sampling_functional);
     
-        if ((_data._constraint_type == ConstraintType::NO_CONSTRAINT) && (_data._dense_solver_type != DenseSolverType::LU)) {
+        if ((_data._constraint_type == ConstraintType::NO_CONSTRAINT) && !solvesNormalEquations(_data._dense_solver_type)) {
             // fill in RHS with Identity * sqrt(weights)
-            double * rhs_data = RHS.data();
+            solve_scalar_type * rhs_data = RHS.data();
             Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember, this_num_rows), [&] (const int i) {
                 rhs_data[i] = std::sqrt(w(i));
             });
         } else {
             // create global memory for matrix M = PsqrtW^T*PsqrtW
             // don't need to cast into scratch_matrix_left_type since the matrix is symmetric
-            scratch_matrix_right_type M(_data.RHS_data
+            solve_matrix_type M(_data.RHS_data
                     + TO_GLOBAL(local_index)*TO_GLOBAL(_data.RHS_dim_0*_data.RHS_dim_1), 
                         _data.RHS_dim_0, _data.RHS_dim_1);
-            KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
-    	      ::invoke(teamMember,
-    	    	   1.0,
-    	    	   PsqrtW,
-    	    	   PsqrtW,
-    	    	   0.0,
-    	    	   M);
-            teamMember.team_barrier();
-    
-            // Multiply PsqrtW with sqrt(W) to get PW
-            Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, _data.max_num_rows), [&] (const int i) {
-                for (int j=0; j < _data.this_num_cols; j++) {
-                     PsqrtW(i,j) = PsqrtW(i,j)*std::sqrt(w(i));
-                }
-            });
-            teamMember.team_barrier();
+
+            // M = PsqrtW^T*PsqrtW (only the lower triangle is needed by the Cholesky solver), while
+            // multiplying PsqrtW with sqrt(W) to get PW (rows past this_num_rows are zero)
+            GMLS_LinearAlgebra::symmetricRankKUpdateAndScaleRows(teamMember, PsqrtW, M, w, this_num_rows, 
+                    _data._dense_solver_type != DenseSolverType::CHOLESKY /*fill_upper*/);
     
             // conditionally fill in rows determined by constraint type
             if (_data._constraint_type == ConstraintType::NEUMANN_GRAD_SCALAR) {
@@ -603,15 +706,188 @@ struct AssembleStandardPsqrtW {
     }
 };
 
+//! Thread scratch (in bytes) needed by TiledStandardGMLS for problems whose dense solve has up to max_num_rows 
+//! rows and num_cols columns
+template <typename solve_scalar_type>
+int getTiledStandardGMLSScratchSize(const int max_num_rows, const int num_cols) {
+    typedef typename GMLSBasisData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
+    typedef Kokkos::View<solve_scalar_type*, Kokkos::MemoryTraits<Kokkos::Unmanaged> > solve_vector_type;
+    int thread_scratch_size = solve_matrix_type::shmem_size(max_num_rows, num_cols); // P*sqrt(w)
+    thread_scratch_size += solve_vector_type::shmem_size(max_num_rows); // sqrt(w)
+    thread_scratch_size += solve_matrix_type::shmem_size(num_cols, max_num_rows); // polynomial coefficients
+    thread_scratch_size += solve_matrix_type::shmem_size(max_num_rows, num_cols); // U
+    thread_scratch_size += solve_matrix_type::shmem_size(num_cols, num_cols); // V
+    thread_scratch_size += scratch_local_index_type::shmem_size(num_cols); // pivots
+    thread_scratch_size += solve_vector_type::shmem_size(max_num_rows + 2*num_cols); // tau, norms, householder
+    thread_scratch_size += solve_vector_type::shmem_size(num_cols*max_num_rows); // rank deficient solve
+    return thread_scratch_size;
+}
+
+//! Functor to solve STANDARD problems without constraints with QR+Pivoting for a tile of target sites per team, 
+//! where each thread owns a target site and assembles, solves, and applies targets for it alone in thread scratch 
+//! memory, so that only alphas (or target outputs) are written to global memory and _P, _RHS, _w, and _Z are not 
+//! needed. For low order stencils, a team working on a single small problem (as in batchQRPivotingSolve) leaves 
+//! most of its threads idle, while here every thread has a problem of its own. On the host, where teams have a 
+//! single thread, the thread works through its tile without team synchronization.
+//!
+//! Only for a ScalarTaylorPolynomial basis sampled with PointSample, with target evaluations known analytically
+//! (see GMLS::usesAnalyticTargetRows), so that the template parameters are the dimension and polynomial order of
+//! the basis. There is no runtime fallback, so it is only launched through launchTiledStandardGMLS.
+template <typename solve_scalar_type, int fixed_dimension, int fixed_poly_order>
+struct TiledStandardGMLS {
+
+    static_assert(fixed_dimension > 0 && fixed_poly_order >= 0, 
+            "TiledStandardGMLS requires a basis compiled for its dimension and polynomial order.");
+
+    typedef typename GMLSBasisData<solve_scalar_type>::solve_matrix_type solve_matrix_type;
+
+    GMLSBasisData<solve_scalar_type> _data;
+    GMLSSolutionData<solve_scalar_type> _solution_data;
+    int _batch_size;
+    int _targets_per_team;
+    bool _apply_to_data;
+
+    TiledStandardGMLS(GMLSBasisData<solve_scalar_type> data, GMLSSolutionData<solve_scalar_type> solution_data, 
+            int batch_size, int targets_per_team, bool apply_to_data) 
+        : _data(data), _solution_data(solution_data), _batch_size(batch_size), _targets_per_team(targets_per_team),
+          _apply_to_data(apply_to_data) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const member_type& teamMember) const {
+
+        typedef Kokkos::View<solve_scalar_type*, Kokkos::MemoryTraits<Kokkos::Unmanaged> > solve_vector_type;
+        constexpr int num_cols = ScalarTaylorPolynomialBasis::getSize<fixed_poly_order, fixed_dimension>();
+
+        /*
+         *    Dimensions
+         */
+
+        const int max_num_rows = _data.max_num_rows;
+        const int first_local_index = teamMember.league_rank()*_targets_per_team;
+        const int num_targets = (_batch_size - first_local_index < _targets_per_team) ? 
+            _batch_size - first_local_index : _targets_per_team;
+
+        /*
+         *    Data (one problem per thread, reused for each target site the thread solves for)
+         */
+
+        const int thread_level = _data._pm.getThreadScratchLevel(0);
+        solve_scalar_type* PsqrtW_data = solve_matrix_type(teamMember.thread_scratch(thread_level), 
+                max_num_rows, num_cols).data();
+        solve_vector_type sqrt_w(teamMember.thread_scratch(thread_level), max_num_rows);
+        solve_scalar_type* Coeffs_data = solve_matrix_type(teamMember.thread_scratch(thread_level), 
+                num_cols, max_num_rows).data();
+        solve_scalar_type* U_data = solve_matrix_type(teamMember.thread_scratch(thread_level), 
+                max_num_rows, num_cols).data();
+        solve_matrix_type V(teamMember.thread_scratch(thread_level), num_cols, num_cols);
+        scratch_local_index_type pivots(teamMember.thread_scratch(thread_level), num_cols);
+        solve_vector_type w_fast(teamMember.thread_scratch(thread_level), max_num_rows + 2*num_cols);
+        solve_vector_type w_slow(teamMember.thread_scratch(thread_level), num_cols*max_num_rows);
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_targets), [&] (const int t) {
+
+            const int target_index = _data.getTargetIndex(first_local_index + t);
+            const int num_neighbors = _data._pc._nla.getNumberOfNeighborsDevice(target_index);
+            const double cutoff_p = _data._epsilons(target_index);
+
+            // rows past the number of neighbors would be zero, so they are left out of the solve
+            solve_matrix_type PsqrtW(PsqrtW_data, num_neighbors, num_cols);
+            solve_matrix_type Coeffs(Coeffs_data, num_cols, num_neighbors);
+            solve_matrix_type U(U_data, num_neighbors, num_cols);
+
+            /*
+             *    Assemble P*sqrt(W) and sqrt(w) (as in createWeightsAndP)
+             */
+
+            for (int i=0; i<num_neighbors; ++i) {
+                const XYZ relative_coord = _data._pc.getRelativeCoord(target_index, i, fixed_dimension);
+                const double r = _data._pc.EuclideanVectorLength(relative_coord, fixed_dimension);
+                const double w_i = GMLS::Wab(r, cutoff_p, _data._weighting_type, _data._weighting_p, 
+                        _data._weighting_n);
+
+                double delta[num_cols];
+                ScalarTaylorPolynomialBasis::evaluate<fixed_dimension, fixed_poly_order>(delta, cutoff_p, 
+                        relative_coord.x, relative_coord.y, relative_coord.z);
+
+                const double sqrt_w_i = std::sqrt(w_i);
+                for (int j=0; j<num_cols; ++j) {
+                    PsqrtW(i, j) = delta[j] * sqrt_w_i;
+                }
+                sqrt_w(i) = sqrt_w_i;
+            }
+
+            /*
+             *    Solve P*sqrt(weights) against sqrt(weights)*Identity
+             */
+
+            GMLS_LinearAlgebra::serialQRPivotingSolve(PsqrtW, sqrt_w, Coeffs, U, V, pivots, w_fast, w_slow, 
+                    num_neighbors, num_cols);
+
+            /*
+             *    Apply Targets to Polynomial Coefficients
+             */
+
+            if (_apply_to_data) {
+                applyAnalyticTargetsToCoefficientsAndDataSerial(_solution_data, target_index, Coeffs);
+            } else {
+                applyAnalyticTargetsToCoefficientsSerial(_solution_data, target_index, Coeffs);
+            }
+        });
+    }
+};
+
+//! Launches TiledStandardGMLS compiled for dimension, with the polynomial order matched at runtime against 
+//! poly_order, poly_order-1, ..., 0 (the functor is constructed from functor_args)
+template <typename solve_scalar_type, int dimension, int poly_order>
+struct LaunchTiledStandardGMLS {
+    template <typename policy_type, typename... functor_arg_types>
+    static void run(const policy_type& tp, const int runtime_poly_order, const functor_arg_types&... functor_args) {
+        if (runtime_poly_order == poly_order) {
+            Kokkos::parallel_for(tp, TiledStandardGMLS<solve_scalar_type, dimension, poly_order>(functor_args...), 
+                    "TiledStandardGMLS");
+        } else {
+            LaunchTiledStandardGMLS<solve_scalar_type, dimension, poly_order-1>::run(tp, runtime_poly_order, 
+                    functor_args...);
+        }
+    }
+};
+
+//! No polynomial order matched, which GMLS::getTiledKernelTiling rules out
+template <typename solve_scalar_type, int dimension>
+struct LaunchTiledStandardGMLS<solve_scalar_type, dimension, -1> {
+    template <typename policy_type, typename... functor_arg_types>
+    static void run(const policy_type& /*tp*/, const int /*runtime_poly_order*/, 
+            const functor_arg_types&... /*functor_args*/) {
+        compadre_assert_release(false && "TiledStandardGMLS is not compiled for this polynomial order.");
+    }
+};
+
+//! Launches TiledStandardGMLS (constructed from functor_args) compiled for the dimension (1, 2, or 3) and 
+//! polynomial order (up to max_poly_order) of basis_data
+template <int max_poly_order, typename solve_scalar_type, typename policy_type, typename... functor_arg_types>
+void launchTiledStandardGMLS(const policy_type& tp, const GMLSBasisData<solve_scalar_type>& basis_data, 
+        const functor_arg_types&... functor_args) {
+    const int poly_order = basis_data._poly_order;
+    if (basis_data._dimensions == 3) {
+        LaunchTiledStandardGMLS<solve_scalar_type, 3, max_poly_order>::run(tp, poly_order, functor_args...);
+    } else if (basis_data._dimensions == 2) {
+        LaunchTiledStandardGMLS<solve_scalar_type, 2, max_poly_order>::run(tp, poly_order, functor_args...);
+    } else if (basis_data._dimensions == 1) {
+        LaunchTiledStandardGMLS<solve_scalar_type, 1, max_poly_order>::run(tp, poly_order, functor_args...);
+    } else {
+        compadre_assert_release(false && "TiledStandardGMLS is not compiled for this dimension.");
+    }
+}
+
 //! Functor to create a coarse tangent approximation from a given neighborhood of points
 struct ComputeCoarseTangentPlane {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
     // random number generator pool
     pool_type _random_number_pool;
 
-    ComputeCoarseTangentPlane(GMLSBasisData data) : _data(data) {
+    ComputeCoarseTangentPlane(GMLSBasisData<double> data) : _data(data) {
         // seed random number generator pool
         _random_number_pool = pool_type(1);
     }
@@ -623,7 +899,7 @@ struct ComputeCoarseTangentPlane {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         const int dimensions   = _data._dimensions;
 
@@ -678,9 +954,9 @@ struct ComputeCoarseTangentPlane {
 //! Functor to assemble the P*sqrt(weights) matrix and construct sqrt(weights)*Identity for curvature
 struct AssembleCurvaturePsqrtW {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
-    AssembleCurvaturePsqrtW(GMLSBasisData data) : _data(data) {}
+    AssembleCurvaturePsqrtW(GMLSBasisData<double> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -689,7 +965,7 @@ struct AssembleCurvaturePsqrtW {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         const int this_num_neighbors = _data._pc._nla.getNumberOfNeighborsDevice(target_index);
 
@@ -725,7 +1001,7 @@ struct AssembleCurvaturePsqrtW {
 
         // CurvaturePsqrtW is sized according to max_num_rows x this_num_cols of which in this case
         // we are only using this_num_neighbors x manifold_NP
-        if (_data._dense_solver_type != DenseSolverType::LU) {
+        if (!solvesNormalEquations(_data._dense_solver_type)) {
             // fill in RHS with Identity * sqrt(weights)
             double * rhs_data = RHS.data();
             Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember, this_num_neighbors), [&] (const int i) {
@@ -737,23 +1013,9 @@ struct AssembleCurvaturePsqrtW {
             scratch_matrix_right_type M(_data.RHS_data
                 + TO_GLOBAL(local_index)*TO_GLOBAL(_data.RHS_dim_0*_data.RHS_dim_1), 
                     _data.RHS_dim_0, _data.RHS_dim_1);
-            // Assemble matrix M
-            KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,
-                KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
-              ::invoke(teamMember,
-                   1.0,
-                   CurvaturePsqrtW,
-                   CurvaturePsqrtW,
-                   0.0,
-                   M);
-            teamMember.team_barrier();
-
-            // Multiply PsqrtW with sqrt(W) to get PW
-            Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, this_num_neighbors), [&] (const int i) {
-                    for (int j=0; j < _data.manifold_NP; j++) {
-                        CurvaturePsqrtW(i, j) = CurvaturePsqrtW(i, j)*std::sqrt(w(i));
-                    }
-            });
+            // Assemble matrix M, while multiplying PsqrtW with sqrt(W) to get PW
+            GMLS_LinearAlgebra::symmetricRankKUpdateAndScaleRows(teamMember, CurvaturePsqrtW, M, w, 
+                    this_num_neighbors, true /*fill_upper*/);
         }
         teamMember.team_barrier();
     }
@@ -762,9 +1024,9 @@ struct AssembleCurvaturePsqrtW {
 //! Functor to evaluate curvature targets and construct accurate tangent direction approximation for manifolds
 struct GetAccurateTangentDirections {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
-    GetAccurateTangentDirections(GMLSBasisData data) : _data(data) {}
+    GetAccurateTangentDirections(GMLSBasisData<double> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -773,7 +1035,7 @@ struct GetAccurateTangentDirections {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         auto dimensions = _data._dimensions;
 
@@ -915,9 +1177,9 @@ struct GetAccurateTangentDirections {
 //! We require that the normal is consistent with a right hand rule on the tangent vectors
 struct FixTangentDirectionOrdering {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
-    FixTangentDirectionOrdering(GMLSBasisData data) : _data(data) {}
+    FixTangentDirectionOrdering(GMLSBasisData<double> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -926,7 +1188,7 @@ struct FixTangentDirectionOrdering {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         auto dimensions = _data._dimensions;
 
         /*
@@ -970,9 +1232,9 @@ struct FixTangentDirectionOrdering {
 //! Functor to evaluate curvature targets and apply to coefficients of curvature reconstruction
 struct ApplyCurvatureTargets {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
-    ApplyCurvatureTargets(GMLSBasisData data) : _data(data) {}
+    ApplyCurvatureTargets(GMLSBasisData<double> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -981,7 +1243,7 @@ struct ApplyCurvatureTargets {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         auto dimensions = _data._dimensions;
 
@@ -1043,9 +1305,9 @@ struct ApplyCurvatureTargets {
 //! Functor to assemble the P*sqrt(weights) matrix and construct sqrt(weights)*Identity
 struct AssembleManifoldPsqrtW {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
-    AssembleManifoldPsqrtW(GMLSBasisData data) : _data(data) {}
+    AssembleManifoldPsqrtW(GMLSBasisData<double> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -1054,7 +1316,7 @@ struct AssembleManifoldPsqrtW {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         auto dimensions = _data._dimensions;
         const int this_num_rows = _data._sampling_multiplier*_data._pc._nla.getNumberOfNeighborsDevice(target_index);
@@ -1088,7 +1350,7 @@ struct AssembleManifoldPsqrtW {
                 _data._poly_order, true /* weight with W*/, &T, _data._reconstruction_space, 
                 _data._polynomial_sampling_functional);
 
-        if (_data._dense_solver_type != DenseSolverType::LU) {
+        if (!solvesNormalEquations(_data._dense_solver_type)) {
             // fill in RHS with Identity * sqrt(weights)
             double * Q_data = Q.data();
             Kokkos::parallel_for(Kokkos::TeamVectorRange(teamMember,this_num_rows), [&] (const int i) {
@@ -1101,22 +1363,9 @@ struct AssembleManifoldPsqrtW {
                     + TO_GLOBAL(local_index)*TO_GLOBAL(_data.RHS_dim_0*_data.RHS_dim_1), 
                         _data.RHS_dim_0, _data.RHS_dim_1);
 
-            // Assemble matrix M
-            KokkosBatched::TeamVectorGemm<member_type,KokkosBatched::Trans::Transpose,KokkosBatched::Trans::NoTranspose,KokkosBatched::Algo::Gemm::Unblocked>
-	          ::invoke(teamMember,
-	        	   1.0,
-	        	   PsqrtW,
-	        	   PsqrtW,
-	        	   0.0,
-	        	   M);
-            teamMember.team_barrier();
-
-            // Multiply PsqrtW with sqrt(W) to get PW
-            Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, _data.max_num_rows), [&] (const int i) {
-                Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, _data.this_num_cols), [&] (const int j) {
-                    PsqrtW(i, j) = PsqrtW(i, j)*std::sqrt(w(i));
-                });
-            });
+            // Assemble matrix M, while multiplying PsqrtW with sqrt(W) to get PW
+            GMLS_LinearAlgebra::symmetricRankKUpdateAndScaleRows(teamMember, PsqrtW, M, w, this_num_rows, 
+                    true /*fill_upper*/);
         }
         teamMember.team_barrier();
     }
@@ -1125,9 +1374,9 @@ struct AssembleManifoldPsqrtW {
 //! Functor to evaluate targets on a manifold
 struct EvaluateManifoldTargets {
 
-    GMLSBasisData _data;
+    GMLSBasisData<double> _data;
 
-    EvaluateManifoldTargets(GMLSBasisData data) : _data(data) {}
+    EvaluateManifoldTargets(GMLSBasisData<double> data) : _data(data) {}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const member_type& teamMember) const {
@@ -1136,7 +1385,7 @@ struct EvaluateManifoldTargets {
          *    Dimensions
          */
 
-        const int target_index = _data._initial_index_for_batch + teamMember.league_rank();
+        const int target_index = _data.getTargetIndex(teamMember.league_rank());
         const int local_index  = teamMember.league_rank();
         auto dimensions = _data._dimensions;
 
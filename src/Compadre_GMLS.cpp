@@ -1,18 +1,83 @@
 #include "Compadre_GMLS.hpp"
 #include "Compadre_Functors.hpp"
+#include "Compadre_SpaceFillingCurve.hpp"
+
+#include <algorithm>
+#include <unistd.h>
 
 namespace Compadre {
 
-void GMLS::generatePolynomialCoefficients(const int number_of_batches, const bool keep_coefficients) {
+void GMLS::setupPolynomialCoefficientsPlan(const bool keep_coefficients) {
 
-    compadre_assert_release( (keep_coefficients==false || number_of_batches==1)
-                && "keep_coefficients is set to true, but number of batches exceeds 1.");
+    if (_plan_is_current) {
+        // neighbor lists and evaluation sites may have changed since the plan was made
+        _d_ss._neighbor_lists = _neighbor_lists;
+        _d_ss._max_evaluation_sites_per_target = _h_ss._max_evaluation_sites_per_target;
+        // whether coefficients are kept can differ from the call the plan was made for
+        _number_of_diagonal_blocks = this->getNumberOfDiagonalBlocks(keep_coefficients);
+        return;
+    }
 
     /*
      *    Generate Quadrature
      */
     this->_qm = Quadrature(_order_of_quadrature_points, _dimension_of_quadrature_points, _quadrature_type);
 
+    /*
+     *    Alpha Tiles Known to be Zero or Cloned
+     */
+
+    // when vector data is sampled for a vector of identical scalar bases, the alphas for many pairs of input 
+    // and output components are zero or the same as those of another pair, so only the rest are stored
+    const bool compress_alpha_tiles = (_problem_type == ProblemType::STANDARD)
+        && (_constraint_type == ConstraintType::NO_CONSTRAINT)
+        && (_reconstruction_space == ReconstructionSpace::VectorTaylorPolynomial 
+                || _reconstruction_space == ReconstructionSpace::VectorOfScalarClonesTaylorPolynomial)
+        && (_polynomial_sampling_functional == VectorPointSample)
+        && (_data_sampling_functional == VectorPointSample);
+    if (compress_alpha_tiles) {
+        std::vector<int> alpha_tile_sources(_h_ss._total_alpha_values);
+        for (size_t i=0; i<_h_ss._lro.size(); ++i) {
+            for (int m=0; m<_h_ss._lro_input_tile_size(i); ++m) {
+                for (int k=0; k<_h_ss._lro_output_tile_size(i); ++k) {
+                    int source_m = m, source_k = k;
+                    switch (_h_ss._lro[i]) {
+                    case TargetOperation::ScalarPointEvaluation:
+                    case TargetOperation::LaplacianOfScalarPointEvaluation:
+                    case TargetOperation::GradientOfScalarPointEvaluation:
+                    case TargetOperation::PartialXOfScalarPointEvaluation:
+                    case TargetOperation::PartialYOfScalarPointEvaluation:
+                    case TargetOperation::PartialZOfScalarPointEvaluation:
+                        // only the first input component is used
+                        source_m = (m == 0) ? 0 : -1;
+                        break;
+                    case TargetOperation::VectorPointEvaluation:
+                        // output component k only depends on input component k
+                        source_m = (m == k) ? 0 : -1;
+                        source_k = 0;
+                        break;
+                    case TargetOperation::GradientOfVectorPointEvaluation:
+                        // output component k/d only depends on input component k/d, except for 
+                        // VectorOfScalarClonesTaylorPolynomial, which has the same gradient for every input component
+                        source_m = (m == k/_dimensions 
+                                || _reconstruction_space == ReconstructionSpace::VectorOfScalarClonesTaylorPolynomial) ? 0 : -1;
+                        source_k = k%_dimensions;
+                        break;
+                    case TargetOperation::CurlOfVectorPointEvaluation:
+                        // output component k does not depend on input component k
+                        source_m = (m == k) ? -1 : m;
+                        break;
+                    default:
+                        break;
+                    }
+                    alpha_tile_sources[_h_ss.getTargetOffsetIndex(i, m, k, 0)] = (source_m < 0) ? -1 
+                        : _h_ss.getTargetOffsetIndex(i, source_m, source_k, 0);
+                }
+            }
+        }
+        _h_ss.setAlphaTileSources(alpha_tile_sources);
+    }
+
     /*
      *    Generate SolutionSet on device
      */
@@ -36,6 +101,310 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     // get copy of operations on the device
     Kokkos::deep_copy(_operations, _host_operations);
 
+    /*
+     *    Determine if Nonstandard Sampling Dimension or Basis Component Dimension
+     */
+
+    // calculate the dimension of the basis (a vector space on a manifold requires two components, for example)
+    _basis_multiplier = calculateBasisMultiplier(_reconstruction_space, _local_dimensions);
+
+    // calculate sampling dimension 
+    _sampling_multiplier = calculateSamplingMultiplier(_reconstruction_space, _data_sampling_functional, _local_dimensions);
+
+    // effective number of components in the basis
+    _data_sampling_multiplier = getOutputDimensionOfSampling(_data_sampling_functional, _local_dimensions);
+
+    // special case for using a higher order for sampling from a polynomial space that are gradients of a scalar polynomial
+    if (_polynomial_sampling_functional == StaggeredEdgeAnalyticGradientIntegralSample) {
+        // if the reconstruction is being made with a gradient of a basis, then we want that basis to be one order higher so that
+        // the gradient is consistent with the convergence order expected.
+        _poly_order += 1;
+        _NP = this->getNP(_poly_order, _dimensions, _reconstruction_space);
+    }
+
+    if (_problem_type == ProblemType::MANIFOLD) {
+        // dimension of basis differs in the case of manifolds
+        _NP = this->getNP(_poly_order, _dimensions-1, _reconstruction_space);
+    }
+
+    /*
+     *    Target Evaluations Known Analytically
+     */
+
+    // for a ScalarTaylorPolynomial basis centered at the target site, point evaluations, partial derivatives,
+    // and Laplacians at the target site are scaled unit vectors, so they need not be evaluated for each target
+    bool analytic_target_rows = (_problem_type == ProblemType::STANDARD)
+        && (_reconstruction_space == ReconstructionSpace::ScalarTaylorPolynomial)
+        && (_polynomial_sampling_functional == PointSample)
+        && (_basis_multiplier == 1) && (_sampling_multiplier == 1);
+    _analytic_target_rows = decltype(_analytic_target_rows)("analytic target rows", _h_ss._total_alpha_values, 2+_dimensions);
+    auto host_analytic_target_rows = Kokkos::create_mirror_view(_analytic_target_rows);
+    Kokkos::deep_copy(host_analytic_target_rows, 0);
+    for (size_t i=0; i<_h_ss._lro.size() && analytic_target_rows; ++i) {
+        const int offset = _h_ss.getTargetOffsetIndex(i, 0, 0, 0);
+        int partial_direction = -1;
+        switch (_h_ss._lro[i]) {
+        case TargetOperation::ScalarPointEvaluation:
+            host_analytic_target_rows(offset, 0) = 1;
+            host_analytic_target_rows(offset, 1) = 0;
+            host_analytic_target_rows(offset, 2) = 0;
+            break;
+        case TargetOperation::GradientOfScalarPointEvaluation:
+            // entries are zero for a constant basis
+            for (int d=0; d<_dimensions && _poly_order>0; ++d) {
+                const int d_offset = _h_ss.getTargetOffsetIndex(i, 0, d, 0);
+                host_analytic_target_rows(d_offset, 0) = 1;
+                host_analytic_target_rows(d_offset, 1) = 1;
+                host_analytic_target_rows(d_offset, 2) = 1+d;
+            }
+            break;
+        case TargetOperation::PartialXOfScalarPointEvaluation:
+            partial_direction = 0;
+            break;
+        case TargetOperation::PartialYOfScalarPointEvaluation:
+            partial_direction = 1;
+            break;
+        case TargetOperation::PartialZOfScalarPointEvaluation:
+            partial_direction = 2;
+            break;
+        case TargetOperation::LaplacianOfScalarPointEvaluation:
+            analytic_target_rows = (_poly_order > 1);
+            host_analytic_target_rows(offset, 0) = _dimensions;
+            host_analytic_target_rows(offset, 1) = 2;
+            // columns of x^2, y^2, and z^2
+            host_analytic_target_rows(offset, 2) = _dimensions+1;
+            if (_dimensions > 1) host_analytic_target_rows(offset, 3) = (_dimensions==2) ? 5 : 6;
+            if (_dimensions > 2) host_analytic_target_rows(offset, 4) = 9;
+            break;
+        default:
+            analytic_target_rows = false;
+        }
+        if (partial_direction >= 0) {
+            // a partial derivative in a direction beyond the dimension is left to computeTargetFunctionals 
+            // (which asserts)
+            analytic_target_rows = (partial_direction < _dimensions);
+            if (_poly_order > 0) {
+                host_analytic_target_rows(offset, 0) = 1;
+                host_analytic_target_rows(offset, 1) = 1;
+                host_analytic_target_rows(offset, 2) = 1+partial_direction;
+            }
+        }
+    }
+    if (analytic_target_rows) {
+        Kokkos::deep_copy(_analytic_target_rows, host_analytic_target_rows);
+    } else {
+        _analytic_target_rows = decltype(_analytic_target_rows)();
+    }
+
+    _number_of_diagonal_blocks = this->getNumberOfDiagonalBlocks(keep_coefficients);
+
+    _plan_is_current = true;
+}
+
+int GMLS::getNumberOfDiagonalBlocks(const bool keep_coefficients) const {
+
+    // for a VectorTaylorPolynomial basis sampled with VectorPointSample, P is block diagonal with the P of a 
+    // ScalarTaylorPolynomial basis in each block, so that one block is solved for and reused for each component 
+    // (unless the polynomial coefficients of the whole basis are kept)
+    return (_problem_type == ProblemType::STANDARD 
+            && _constraint_type == ConstraintType::NO_CONSTRAINT
+            && _reconstruction_space == ReconstructionSpace::VectorTaylorPolynomial
+            && _polynomial_sampling_functional == VectorPointSample
+            && _data_sampling_functional == VectorPointSample
+            && _sampling_multiplier == _basis_multiplier && !keep_coefficients) ? _basis_multiplier : 1;
+
+}
+
+void GMLS::setupBatches(const int number_of_batches, const std::vector<int>& target_indices) {
+
+    const global_index_type num_targets = _target_coordinates.extent(0);
+    _batch_offsets.clear();
+    _batch_max_num_neighbors.clear();
+    _batch_offsets.push_back(0);
+
+    // target sites to be batched (all target sites if target_indices is empty)
+    const bool all_targets = target_indices.empty();
+    const global_index_type num_scheduled_targets = (all_targets) ? num_targets : TO_GLOBAL(target_indices.size());
+
+    // target sites in Morton order, if requested, which bucketing keeps within each bucket
+    std::vector<int> curve_ordered_target_indices;
+    if (_order_targets_along_curve && num_targets > 0) {
+        if (TO_GLOBAL(_target_curve_order.size()) != num_targets) {
+            auto host_target_coordinates = Kokkos::create_mirror_view(_target_coordinates);
+            Kokkos::deep_copy(host_target_coordinates, _target_coordinates);
+            Kokkos::fence();
+            _target_curve_order = getMortonOrder(host_target_coordinates, _global_dimensions);
+        }
+        if (all_targets) {
+            curve_ordered_target_indices = _target_curve_order;
+        } else {
+            // position of each target site along the curve, used to order the target sites requested
+            std::vector<int> position_on_curve(num_targets);
+            for (global_index_type i=0; i<num_targets; ++i) position_on_curve[_target_curve_order[i]] = i;
+            curve_ordered_target_indices = target_indices;
+            std::sort(curve_ordered_target_indices.begin(), curve_ordered_target_indices.end(), 
+                    [&](const int a, const int b) { return position_on_curve[a] < position_on_curve[b]; });
+        }
+    }
+    const bool curve_ordered = !curve_ordered_target_indices.empty();
+
+    auto scheduled_target_index = [&](const global_index_type i) {
+        return (curve_ordered) ? curve_ordered_target_indices[i] : ((all_targets) ? (int)i : target_indices[i]);
+    };
+
+    if ((_number_of_neighbor_buckets < 2 && all_targets && !curve_ordered) || num_targets == 0) {
+
+        // batches are contiguous ranges of target sites, all sized by the maximum number of neighbors
+        _batch_target_indices = decltype(_batch_target_indices)();
+        const global_index_type max_batch_size = (num_targets + TO_GLOBAL(number_of_batches) - 1) / TO_GLOBAL(number_of_batches);
+        for (int batch_num=0; batch_num<number_of_batches; ++batch_num) {
+            const global_index_type this_batch_size = std::min(num_targets - _batch_offsets.back(), max_batch_size);
+            _batch_offsets.push_back(_batch_offsets.back() + this_batch_size);
+            _batch_max_num_neighbors.push_back(_max_num_neighbors);
+            if (_batch_offsets.back() == num_targets) break;
+        }
+
+    } else {
+
+        // without bucketing, the scheduled target sites are a single bucket
+        const int number_of_buckets = std::max(_number_of_neighbor_buckets, 1);
+
+        // buckets have equal width in number of neighbors, between the fewest and most neighbors of any target site
+        int min_num_neighbors = _max_num_neighbors;
+        for (global_index_type i=0; i<num_scheduled_targets; ++i) {
+            min_num_neighbors = std::min(min_num_neighbors, _neighbor_lists.getNumberOfNeighborsHost(scheduled_target_index(i)));
+        }
+        const int bucket_width = (_max_num_neighbors - min_num_neighbors + number_of_buckets) 
+            / number_of_buckets;
+
+        // counting sort of target sites by bucket (stable, so target sites keep their order within a bucket)
+        std::vector<global_index_type> bucket_offsets(number_of_buckets+1, 0);
+        std::vector<int> bucket_max_num_neighbors(number_of_buckets, 0);
+        for (global_index_type i=0; i<num_scheduled_targets; ++i) {
+            const int num_neighbors = _neighbor_lists.getNumberOfNeighborsHost(scheduled_target_index(i));
+            const int bucket_num = (num_neighbors - min_num_neighbors) / bucket_width;
+            bucket_offsets[bucket_num+1]++;
+            bucket_max_num_neighbors[bucket_num] = std::max(bucket_max_num_neighbors[bucket_num], num_neighbors);
+        }
+        for (int bucket_num=0; bucket_num<number_of_buckets; ++bucket_num) {
+            bucket_offsets[bucket_num+1] += bucket_offsets[bucket_num];
+        }
+        _batch_target_indices = decltype(_batch_target_indices)("batch target indices", num_scheduled_targets);
+        auto host_batch_target_indices = Kokkos::create_mirror_view(_batch_target_indices);
+        std::vector<global_index_type> bucket_fill(bucket_offsets.begin(), bucket_offsets.end()-1);
+        for (global_index_type i=0; i<num_scheduled_targets; ++i) {
+            const int target_index = scheduled_target_index(i);
+            const int bucket_num = (_neighbor_lists.getNumberOfNeighborsHost(target_index) - min_num_neighbors) / bucket_width;
+            host_batch_target_indices(bucket_fill[bucket_num]++) = target_index;
+        }
+        Kokkos::deep_copy(_batch_target_indices, host_batch_target_indices);
+
+        // each non-empty bucket is broken up into number_of_batches batches
+        for (int bucket_num=0; bucket_num<number_of_buckets; ++bucket_num) {
+            const global_index_type bucket_size = bucket_offsets[bucket_num+1] - bucket_offsets[bucket_num];
+            const global_index_type max_batch_size = (bucket_size + TO_GLOBAL(number_of_batches) - 1) / TO_GLOBAL(number_of_batches);
+            while (_batch_offsets.back() < bucket_offsets[bucket_num+1]) {
+                const global_index_type this_batch_size = std::min(bucket_offsets[bucket_num+1] - _batch_offsets.back(), max_batch_size);
+                _batch_offsets.push_back(_batch_offsets.back() + this_batch_size);
+                _batch_max_num_neighbors.push_back(bucket_max_num_neighbors[bucket_num]);
+            }
+        }
+
+    }
+}
+
+void GMLS::getPrestencilWeightsDims(size_t (&prestencil_dims)[5]) const {
+
+    auto sro = _data_sampling_functional;
+    prestencil_dims[0] = (size_t)std::pow(2,sro.use_target_site_weights);
+    prestencil_dims[1] = (sro.transform_type==DifferentEachTarget 
+                    || sro.transform_type==DifferentEachNeighbor) ?
+                (size_t)_neighbor_lists.getNumberOfTargets() : 1;
+    prestencil_dims[2] = (sro.transform_type==DifferentEachNeighbor) ?
+                (size_t)_max_num_neighbors : 1;
+    prestencil_dims[3] = (sro.output_rank>0) ?
+                (size_t)_local_dimensions : 1;
+    prestencil_dims[4] = (sro.input_rank>0) ?
+                (size_t)_global_dimensions : 1;
+
+}
+
+global_index_type GMLS::getAlphasSize(const global_index_type first_target_index, 
+        const global_index_type end_target_index) const {
+
+    // total neighbors over target sites before target_index
+    auto neighbors_before = [&](const global_index_type target_index) {
+        return (target_index == TO_GLOBAL(_neighbor_lists.getNumberOfTargets())) ?
+            _neighbor_lists.getTotalNeighborsOverAllListsHost() : _neighbor_lists.getRowOffsetHost(target_index);
+    };
+    global_index_type total_neighbors = neighbors_before(end_target_index) - neighbors_before(first_target_index);
+    global_index_type total_added_alphas = (end_target_index - first_target_index)
+        *TO_GLOBAL(getAdditionalAlphaSizeFromConstraint(_dense_solver_type, _constraint_type));
+    return (total_neighbors + total_added_alphas)
+                *TO_GLOBAL(_d_ss._total_stored_alpha_values)*TO_GLOBAL(_d_ss._max_evaluation_sites_per_target);
+
+}
+
+global_index_type GMLS::getMaxBatchAlphasSize() const {
+
+    global_index_type max_batch_alphas_size = 0;
+    for (size_t batch_num=0; batch_num<_batch_max_num_neighbors.size(); ++batch_num) {
+        max_batch_alphas_size = std::max(max_batch_alphas_size, 
+                this->getAlphasSize(_batch_offsets[batch_num], _batch_offsets[batch_num+1]));
+    }
+    return max_batch_alphas_size;
+
+}
+
+void GMLS::getBatchStorageSizes(global_index_type& RHS_size, global_index_type& P_size, 
+        global_index_type& w_size, global_index_type& Z_size) const {
+
+    int this_num_cols = _basis_multiplier*_NP;
+    if (_problem_type == ProblemType::MANIFOLD) {
+        const int manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
+        const int max_manifold_NP = (manifold_NP > _NP) ? manifold_NP : _NP;
+        this_num_cols = _basis_multiplier*max_manifold_NP;
+    }
+
+    // target evaluations are not stored when they are known analytically
+    const global_index_type Z_dim = (this->usesAnalyticTargetRows()) ? 0 
+        : TO_GLOBAL(_d_ss._total_alpha_values*_d_ss._max_evaluation_sites_per_target*this_num_cols);
+    // only one of the identical diagonal blocks of P is solved for
+    const int solve_num_cols = this_num_cols/_number_of_diagonal_blocks;
+    RHS_size = 0; P_size = 0; w_size = 0; Z_size = 0;
+    for (size_t batch_num=0; batch_num<_batch_max_num_neighbors.size(); ++batch_num) {
+        const global_index_type this_batch_size = _batch_offsets[batch_num+1] - _batch_offsets[batch_num];
+        const int batch_max_num_rows = (_sampling_multiplier/_number_of_diagonal_blocks)*_batch_max_num_neighbors[batch_num];
+        int batch_RHS_dim_0, batch_RHS_dim_1;
+        getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, batch_max_num_rows, solve_num_cols, batch_RHS_dim_0, batch_RHS_dim_1);
+        int batch_P_dim_0, batch_P_dim_1;
+        getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, batch_max_num_rows, solve_num_cols, batch_P_dim_0, batch_P_dim_1);
+        RHS_size = std::max(RHS_size, this_batch_size*TO_GLOBAL(batch_RHS_dim_0)*TO_GLOBAL(batch_RHS_dim_1));
+        P_size = std::max(P_size, this_batch_size*TO_GLOBAL(batch_P_dim_0)*TO_GLOBAL(batch_P_dim_1));
+        w_size = std::max(w_size, this_batch_size*TO_GLOBAL(batch_max_num_rows));
+        Z_size = std::max(Z_size, this_batch_size*Z_dim);
+    }
+
+}
+
+std::size_t GMLS::getAvailableMemory() {
+
+#ifdef COMPADRE_USE_CUDA
+    size_t free_bytes, total_bytes;
+    cudaMemGetInfo(&free_bytes, &total_bytes);
+    return free_bytes;
+#elif defined(_SC_AVPHYS_PAGES)
+    return (std::size_t)sysconf(_SC_AVPHYS_PAGES)*(std::size_t)sysconf(_SC_PAGE_SIZE);
+#else
+    compadre_assert_release(false && "Free memory can not be queried on this platform, so a memory budget must be given.");
+    return 0;
+#endif
+
+}
+
+void GMLS::allocatePolynomialCoefficientsStorage(const int number_of_batches, const int max_num_neighbors, 
+        const global_index_type max_num_targets, const int number_of_buffers, const AlphasMode alphas_mode) {
+
     // check that if any target sites added, that neighbors_lists has equal rows
     compadre_assert_release(((size_t)_neighbor_lists.getNumberOfTargets()==_target_coordinates.extent(0)) 
             && "Neighbor lists not set in GMLS class before calling generatePolynomialCoefficients.");
@@ -54,21 +423,55 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     compadre_assert_release( (!(_dense_solver_type==DenseSolverType::QR
                 && _constraint_type==ConstraintType::NEUMANN_GRAD_SCALAR))
             && "Cannot solve GMLS problems with the NEUMANN_GRAD_SCALAR constraint using QR Factorization.");
+    compadre_assert_release( (!(_dense_solver_type==DenseSolverType::CHOLESKY
+                && (_constraint_type!=ConstraintType::NO_CONSTRAINT || _problem_type==ProblemType::MANIFOLD)))
+            && "Cholesky Factorization is only available for STANDARD problems without constraints.");
+    compadre_assert_release( (!_pack_targets_for_simd || (_dense_solver_type==DenseSolverType::CHOLESKY
+                && Kokkos::SpaceAccessibility<host_execution_space, device_memory_space>::accessible))
+            && "Packing target sites for SIMD requires the CHOLESKY dense solver and host accessible device memory.");
 
     // calculate the additional size for different constraint problems
     _d_ss._added_alpha_size = getAdditionalAlphaSizeFromConstraint(_dense_solver_type, _constraint_type);
-    const int added_coeff_size = getAdditionalCoeffSizeFromConstraintAndSpace(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions);
+
+    // storage is sized for at least the current problem
+    const int storage_num_neighbors = (max_num_neighbors > _max_num_neighbors) ? max_num_neighbors : _max_num_neighbors;
+    const global_index_type num_targets = _target_coordinates.extent(0);
+    const global_index_type storage_num_targets = (max_num_targets > num_targets) ? max_num_targets : num_targets;
 
     // initialize all alpha values to be used for taking the dot product with data to get a reconstruction 
     try {
-        global_index_type total_neighbors = _neighbor_lists.getTotalNeighborsOverAllListsHost();
-        int total_added_alphas = _target_coordinates.extent(0)*_d_ss._added_alpha_size;
-        _d_ss._alphas = 
-            decltype(_d_ss._alphas)("alphas", (total_neighbors + TO_GLOBAL(total_added_alphas))
-                    *TO_GLOBAL(_d_ss._total_alpha_values)*TO_GLOBAL(_d_ss._max_evaluation_sites_per_target));
-        // this deep copy writes to all theoretically allocated memory,
-        // ensuring that allocation attempted was successful
-        Kokkos::deep_copy(_d_ss._alphas, 0.0);
+        if (alphas_mode != PatchAlphas) {
+            // alphas kept from an earlier call may still be referenced by a copy of the solution set 
+            // (or a view from getAlphas), in which case new storage is allocated rather than overwriting them
+            _d_ss._alphas = decltype(_d_ss._alphas)();
+            if (_alphas_storage.use_count() > 1) _alphas_storage = decltype(_alphas_storage)();
+        }
+        if (alphas_mode == PatchAlphas) {
+            // alphas of target sites not being solved for are kept as they are
+            compadre_assert_release((_d_ss._alpha_index_offset == 0 && _d_ss._alphas.extent(0) >= this->getAlphasSize(0, num_targets))
+                    && "Alphas for all target sites must already be stored in order to patch them.");
+        } else if (alphas_mode == ApplyToData) {
+            // target operations are applied directly to data, so only target outputs are stored
+            int total_output_values = 0;
+            for (size_t j=0; j<_h_ss._lro_output_tile_size.extent(0); ++j) {
+                total_output_values += _h_ss._lro_output_tile_size(j);
+            }
+            _target_output = decltype(_target_output)("target output", num_targets, 
+                    total_output_values*_d_ss._max_evaluation_sites_per_target);
+            _d_ss._alphas = decltype(_d_ss._alphas)();
+            _d_ss._alpha_index_offset = 0;
+        } else if (alphas_mode == StreamAlphas) {
+            // only storage for the largest batch (for each buffer) is needed, and windows
+            // into it are zeroed as each batch is launched
+            getViewFromStorage(_alphas_storage, "alphas", TO_GLOBAL(number_of_buffers)*this->getMaxBatchAlphasSize());
+            _d_ss._alphas = decltype(_d_ss._alphas)();
+        } else {
+            _d_ss._alphas = getViewFromStorage(_alphas_storage, "alphas", this->getAlphasSize(0, num_targets));
+            _d_ss._alpha_index_offset = 0;
+            // this deep copy writes to all theoretically allocated memory,
+            // ensuring that allocation attempted was successful
+            Kokkos::deep_copy(_d_ss._alphas, 0.0);
+        }
     } catch(std::exception &e) {
        printf("Insufficient memory to store alphas: \n\n%s", e.what()); 
        throw e;
@@ -76,46 +479,24 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
 
     // initialize the prestencil weights that are applied to sampling data to put it into a form 
     // that the GMLS operator will be able to operate on
-    auto sro = _data_sampling_functional;
     try {
-        _prestencil_weights = decltype(_prestencil_weights)("Prestencil weights",
-                std::pow(2,sro.use_target_site_weights), 
-                (sro.transform_type==DifferentEachTarget 
-                        || sro.transform_type==DifferentEachNeighbor) ?
-                    _neighbor_lists.getNumberOfTargets() : 1,
-                (sro.transform_type==DifferentEachNeighbor) ?
-                    _max_num_neighbors : 1,
-                (sro.output_rank>0) ?
-                    _local_dimensions : 1,
-                (sro.input_rank>0) ?
-                    _global_dimensions : 1);
+        size_t prestencil_dims[5];
+        this->getPrestencilWeightsDims(prestencil_dims);
+        // reuse previous prestencil weights if they are the same size
+        if (_prestencil_weights.extent(0)!=prestencil_dims[0] || _prestencil_weights.extent(1)!=prestencil_dims[1]
+                || _prestencil_weights.extent(2)!=prestencil_dims[2] || _prestencil_weights.extent(3)!=prestencil_dims[3]
+                || _prestencil_weights.extent(4)!=prestencil_dims[4]) {
+            _prestencil_weights = decltype(_prestencil_weights)("Prestencil weights", prestencil_dims[0],
+                    prestencil_dims[1], prestencil_dims[2], prestencil_dims[3], prestencil_dims[4]);
+        } else if (alphas_mode != PatchAlphas) {
+            Kokkos::deep_copy(_prestencil_weights, 0.0);
+        }
     } catch(std::exception &e) {
        printf("Insufficient memory to store prestencil weights: \n\n%s", e.what()); 
        throw e;
     }
     Kokkos::fence();
 
-    /*
-     *    Determine if Nonstandard Sampling Dimension or Basis Component Dimension
-     */
-
-    // calculate the dimension of the basis (a vector space on a manifold requires two components, for example)
-    _basis_multiplier = calculateBasisMultiplier(_reconstruction_space, _local_dimensions);
-
-    // calculate sampling dimension 
-    _sampling_multiplier = calculateSamplingMultiplier(_reconstruction_space, _data_sampling_functional, _local_dimensions);
-
-    // effective number of components in the basis
-    _data_sampling_multiplier = getOutputDimensionOfSampling(_data_sampling_functional, _local_dimensions);
-
-    // special case for using a higher order for sampling from a polynomial space that are gradients of a scalar polynomial
-    if (_polynomial_sampling_functional == StaggeredEdgeAnalyticGradientIntegralSample) {
-        // if the reconstruction is being made with a gradient of a basis, then we want that basis to be one order higher so that
-        // the gradient is consistent with the convergence order expected.
-        _poly_order += 1;
-        _NP = this->getNP(_poly_order, _dimensions, _reconstruction_space);
-    }
-
     /*
      *    Dimensions
      */
@@ -128,15 +509,13 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
     int thread_scratch_size_a = 0;
     int thread_scratch_size_b = 0;
 
-    // dimensions that are relevant for each subproblem
-    int max_num_rows = _sampling_multiplier*_max_num_neighbors;
+    // dimensions that are relevant for each subproblem (rows are for one of the identical diagonal blocks of P)
+    int max_num_rows = (_sampling_multiplier/_number_of_diagonal_blocks)*storage_num_neighbors;
     int this_num_cols = _basis_multiplier*_NP;
-    int manifold_NP = 0;
 
     if (_problem_type == ProblemType::MANIFOLD) {
         // these dimensions already calculated differ in the case of manifolds
-        manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
-        _NP = this->getNP(_poly_order, _dimensions-1, _reconstruction_space);
+        const int manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
         const int max_manifold_NP = (manifold_NP > _NP) ? manifold_NP : _NP;
         this_num_cols = _basis_multiplier*max_manifold_NP;
         const int max_poly_order = (_poly_order > _curvature_poly_order) ? _poly_order : _curvature_poly_order;
@@ -157,13 +536,20 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
         }
 
         // allocate data on the device (initialized to zero)
+        // (when patching alphas, the tangent bundle and curvature of other target sites are kept)
         if (!_orthonormal_tangent_space_provided) {
-            _T = Kokkos::View<double*>("tangent approximation",_target_coordinates.extent(0)*_dimensions*_dimensions);
-            Kokkos::deep_copy(_T, 0.0);
+            if (_T.extent(0) != _target_coordinates.extent(0)*_dimensions*_dimensions) {
+                _T = Kokkos::View<double*>("tangent approximation",_target_coordinates.extent(0)*_dimensions*_dimensions);
+            } else if (alphas_mode != PatchAlphas) {
+                Kokkos::deep_copy(_T, 0.0);
+            }
+        }
+        if (_manifold_curvature_coefficients.extent(0) != _target_coordinates.extent(0)*manifold_NP) {
+            _manifold_curvature_coefficients = Kokkos::View<double*>("manifold curvature coefficients",
+                    _target_coordinates.extent(0)*manifold_NP);
+        } else if (alphas_mode != PatchAlphas) {
+            Kokkos::deep_copy(_manifold_curvature_coefficients, 0.0);
         }
-        _manifold_curvature_coefficients = Kokkos::View<double*>("manifold curvature coefficients",
-                _target_coordinates.extent(0)*manifold_NP);
-        Kokkos::deep_copy(_manifold_curvature_coefficients, 0.0);
 
     } else  { // Standard GMLS
 
@@ -184,29 +570,384 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
      *    Calculate the size for matrix P and RHS
      */
 
-    int RHS_dim_0, RHS_dim_1;
-    getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, RHS_dim_0, RHS_dim_1);
+    // sizes needed by the current batches, each sized by its own maximum number of neighbors
+    global_index_type RHS_size, P_size, w_size, Z_size;
+    this->getBatchStorageSizes(RHS_size, P_size, w_size, Z_size);
+    if (_tiled_targets_per_team > 0) {
+        // TiledStandardGMLS keeps these in scratch memory
+        RHS_size = 0; P_size = 0; w_size = 0; Z_size = 0;
+    }
 
-    int P_dim_0, P_dim_1;
-    getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, P_dim_0, P_dim_1);
+    // sizes anticipated by setupPolynomialCoefficients (storage is kept at least this large)
+    global_index_type RHS_storage_size = RHS_size, P_storage_size = P_size, w_storage_size = w_size, Z_storage_size = Z_size;
+    if (max_num_neighbors > 0 || max_num_targets > 0) {
+        const int solve_num_cols = this_num_cols/_number_of_diagonal_blocks;
+        int RHS_dim_0, RHS_dim_1;
+        getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, solve_num_cols, RHS_dim_0, RHS_dim_1);
+        int P_dim_0, P_dim_1;
+        getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, solve_num_cols, P_dim_0, P_dim_1);
+        const global_index_type storage_batch_size = (storage_num_targets + TO_GLOBAL(number_of_batches) - 1) / TO_GLOBAL(number_of_batches);
+        const global_index_type Z_dim = (this->usesAnalyticTargetRows()) ? 0 
+            : TO_GLOBAL(_d_ss._total_alpha_values*_d_ss._max_evaluation_sites_per_target*this_num_cols);
+        RHS_storage_size = std::max(RHS_storage_size, storage_batch_size*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1));
+        P_storage_size = std::max(P_storage_size, storage_batch_size*TO_GLOBAL(P_dim_0)*TO_GLOBAL(P_dim_1));
+        w_storage_size = std::max(w_storage_size, storage_batch_size*TO_GLOBAL(max_num_rows));
+        Z_storage_size = std::max(Z_storage_size, storage_batch_size*Z_dim);
+    }
 
     /*
      *    Allocate Global Device Storage of Data Needed Over Multiple Calls
      */
 
-    global_index_type max_batch_size = (_target_coordinates.extent(0) + TO_GLOBAL(number_of_batches) - 1) / TO_GLOBAL(number_of_batches);
     try {
-        _RHS = Kokkos::View<double*>("RHS", max_batch_size*TO_GLOBAL(RHS_dim_0)*TO_GLOBAL(RHS_dim_1));
-        _P = Kokkos::View<double*>("P", max_batch_size*TO_GLOBAL(P_dim_0)*TO_GLOBAL(P_dim_1));
-        _w = Kokkos::View<double*>("w", max_batch_size*TO_GLOBAL(max_num_rows));
-        _Z = Kokkos::View<double*>("Z", max_batch_size*TO_GLOBAL(_d_ss._total_alpha_values*_d_ss._max_evaluation_sites_per_target*this_num_cols));
+        // grow storage to largest size anticipated (for each buffer)
+        // (P and RHS are stored in the scalar type of the dense solve, and the other pair is left empty)
+        const global_index_type buffers = TO_GLOBAL(number_of_buffers);
+        if (_single_precision_solve) {
+            getViewFromStorage(_RHS_float_storage, "RHS", buffers*RHS_storage_size);
+            getViewFromStorage(_P_float_storage, "P", buffers*P_storage_size);
+        } else {
+            getViewFromStorage(_RHS_storage, "RHS", buffers*RHS_storage_size);
+            getViewFromStorage(_P_storage, "P", buffers*P_storage_size);
+        }
+        getViewFromStorage(_w_storage, "w", buffers*w_storage_size);
+        getViewFromStorage(_Z_storage, "Z", buffers*Z_storage_size);
+
+        // views used by the current problem (first buffer)
+        _RHS = getViewFromStorage(_RHS_storage, "RHS", (_single_precision_solve) ? 0 : RHS_size);
+        _P = getViewFromStorage(_P_storage, "P", (_single_precision_solve) ? 0 : P_size);
+        _RHS_float = getViewFromStorage(_RHS_float_storage, "RHS", (_single_precision_solve) ? RHS_size : 0);
+        _P_float = getViewFromStorage(_P_float_storage, "P", (_single_precision_solve) ? P_size : 0);
+        _w = getViewFromStorage(_w_storage, "w", w_size);
+        _Z = getViewFromStorage(_Z_storage, "Z", Z_size);
 
     } catch (std::exception &e) {
-        printf("Failed to allocate space for RHS, P, and w. Consider increasing number_of_batches: \n\n%s", e.what());
+        printf("Failed to allocate space for RHS, P, and w. Consider increasing number_of_batches (see selectNumberOfBatches): \n\n%s", e.what());
         throw e;
     }
     Kokkos::fence();
-    
+}
+
+void GMLS::setupPolynomialCoefficients(const int number_of_batches, const int max_num_neighbors, 
+        const int max_num_targets, const bool keep_coefficients) {
+
+    _keep_plan_storage = true;
+    _tiled_targets_per_team = 0;
+    _tiled_threads_per_team = 0;
+    this->setupPolynomialCoefficientsPlan(keep_coefficients);
+    this->setupBatches(number_of_batches);
+    this->allocatePolynomialCoefficientsStorage(number_of_batches, max_num_neighbors, TO_GLOBAL(max_num_targets));
+
+}
+
+std::size_t GMLS::estimateMemoryFootprint(const int number_of_batches, const bool overlap_batches, 
+        const bool stream_alphas, const bool keep_coefficients) {
+
+    compadre_assert_release((number_of_batches > 0) && "number_of_batches must be positive.");
+
+    this->setupPolynomialCoefficientsPlan(keep_coefficients);
+    this->setupBatches(number_of_batches);
+
+    // matches the conditions for overlapping batches in generatePolynomialCoefficients
+    const int number_of_buffers = (overlap_batches && _batch_max_num_neighbors.size() > 1 
+            && _problem_type != ProblemType::MANIFOLD) ? 2 : 1;
+
+    global_index_type RHS_size, P_size, w_size, Z_size;
+    this->getBatchStorageSizes(RHS_size, P_size, w_size, Z_size);
+
+    size_t prestencil_dims[5];
+    this->getPrestencilWeightsDims(prestencil_dims);
+
+    const global_index_type alphas_size = (stream_alphas) ? 
+        TO_GLOBAL(number_of_buffers)*this->getMaxBatchAlphasSize() : this->getAlphasSize(0, _target_coordinates.extent(0));
+
+    std::size_t num_doubles = alphas_size
+        + prestencil_dims[0]*prestencil_dims[1]*prestencil_dims[2]*prestencil_dims[3]*prestencil_dims[4]
+        + number_of_buffers*(w_size + Z_size);
+
+    // P and RHS are stored in the scalar type of the dense solve
+    const std::size_t solve_bytes = number_of_buffers*(RHS_size + P_size)*this->getSolveScalarSize();
+
+    if (_problem_type == ProblemType::MANIFOLD) {
+        const std::size_t num_targets = _target_coordinates.extent(0);
+        const int manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
+        if (!_orthonormal_tangent_space_provided) num_doubles += num_targets*_dimensions*_dimensions;
+        num_doubles += num_targets*manifold_NP;
+    }
+
+    return num_doubles*sizeof(double) + solve_bytes + _batch_target_indices.extent(0)*sizeof(int);
+
+}
+
+int GMLS::selectNumberOfBatches(const std::size_t memory_budget, const bool overlap_batches, 
+        const bool stream_alphas, const bool keep_coefficients) {
+
+    const std::size_t budget = (memory_budget > 0) ? memory_budget : getAvailableMemory();
+    const int max_number_of_batches = std::max(1, (int)_target_coordinates.extent(0));
+
+    compadre_assert_release((this->estimateMemoryFootprint(max_number_of_batches, overlap_batches, stream_alphas, 
+                keep_coefficients) <= budget)
+            && "Memory budget is too small for GMLS problem, even with one target site per batch.");
+
+    // footprint decreases as the number of batches increases, so bisect for the smallest that fits
+    int lower = 1, upper = max_number_of_batches;
+    while (lower < upper) {
+        const int middle = lower + (upper - lower)/2;
+        if (this->estimateMemoryFootprint(middle, overlap_batches, stream_alphas, keep_coefficients) <= budget) {
+            upper = middle;
+        } else {
+            lower = middle + 1;
+        }
+    }
+    return lower;
+
+}
+
+void GMLS::generatePolynomialCoefficients(const int number_of_batches, const bool keep_coefficients, 
+        const bool overlap_batches) {
+
+    this->generatePolynomialCoefficientsInBatches(number_of_batches, keep_coefficients, overlap_batches, StoreAlphas);
+
+}
+
+void GMLS::generatePolynomialCoefficients(const alphas_consumer_type& alphas_consumer, const int number_of_batches, 
+        const bool overlap_batches) {
+
+    compadre_assert_release(alphas_consumer && "alphas_consumer must be callable to stream alphas.");
+    this->generatePolynomialCoefficientsInBatches(number_of_batches, false, overlap_batches, StreamAlphas, alphas_consumer);
+
+}
+
+template <typename solve_scalar_type>
+void GMLS::solveStandardBatch(const int this_batch_size, const bool use_overlap) {
+
+    const int added_coeff_size = getAdditionalCoeffSizeFromConstraintAndSpace(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions);
+    // only one of the identical diagonal blocks of P is solved for
+    const int max_num_rows = (_sampling_multiplier/_number_of_diagonal_blocks)*_max_num_neighbors;
+    const int this_num_cols = (_basis_multiplier/_number_of_diagonal_blocks)*_NP;
+    int RHS_dim_0, RHS_dim_1, P_dim_0, P_dim_1;
+    getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, RHS_dim_0, RHS_dim_1);
+    getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, P_dim_0, P_dim_1);
+
+    auto gmls_basis_data = createGMLSBasisData<solve_scalar_type>(*this);
+    auto RHS_data = gmls_basis_data.RHS_data;
+    auto P_data = gmls_basis_data.P_data;
+
+    // even kernels that should run on other # of vector lanes do not (on GPU)
+    auto tp = _pm.TeamPolicyThreadsAndVectors(this_batch_size, _pm._default_threads, 1);
+
+    // assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity
+    auto functor_assemble_standard_psqrtw = AssembleStandardPsqrtW<solve_scalar_type>(
+            (_number_of_diagonal_blocks > 1) ? createDiagonalBlockBasisData(gmls_basis_data) : gmls_basis_data);
+    Kokkos::parallel_for(tp, functor_assemble_standard_psqrtw, "AssembleStandardPsqrtW");
+    if (!use_overlap) Kokkos::fence();
+
+    // solves P*sqrt(weights) against sqrt(weights)*Identity, stored in RHS
+    if (_dense_solver_type == DenseSolverType::CHOLESKY) {
+            Kokkos::Profiling::pushRegion("Cholesky Factorization");
+            GMLS_LinearAlgebra::batchCholeskySolve<layout_right,layout_left>(_pm, RHS_data, RHS_dim_0, RHS_dim_1, P_data, P_dim_1, P_dim_0, this_num_cols, max_num_rows, this_batch_size, _pack_targets_for_simd);
+            Kokkos::Profiling::popRegion();
+    } else if (_dense_solver_type == DenseSolverType::LU) {
+            Kokkos::Profiling::pushRegion("LU Factorization");
+            GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_left,layout_right>(_pm, RHS_data, RHS_dim_0, RHS_dim_1, P_data, P_dim_1, P_dim_0, this_num_cols + added_coeff_size, this_num_cols + added_coeff_size, max_num_rows + _d_ss._added_alpha_size, this_batch_size);
+            Kokkos::Profiling::popRegion();
+    } else {
+        Kokkos::Profiling::pushRegion("QR+Pivoting Factorization");
+        if (_constraint_type != ConstraintType::NO_CONSTRAINT) {
+             GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(_pm, RHS_data, RHS_dim_0, RHS_dim_1, P_data, P_dim_1, P_dim_0, this_num_cols + added_coeff_size, this_num_cols + added_coeff_size, max_num_rows + _d_ss._added_alpha_size, this_batch_size);
+        } else {
+            // large neighborhoods (high order in 3D) use the blocked factorization
+            const int qr_block_size = GMLS_LinearAlgebra::getQRPivotingBlockSize(max_num_rows, this_num_cols);
+            GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(_pm, P_data, P_dim_0, P_dim_1, RHS_data, RHS_dim_0, RHS_dim_1, max_num_rows, this_num_cols, max_num_rows, this_batch_size, qr_block_size);
+        }
+        Kokkos::Profiling::popRegion();
+    }
+
+    auto functor_compute_prestencil_weights = ComputePrestencilWeights<solve_scalar_type>(gmls_basis_data);
+    Kokkos::parallel_for(tp, functor_compute_prestencil_weights, "ComputePrestencilWeights");
+    if (!use_overlap) Kokkos::fence();
+
+    // evaluates targets, applies target evaluation to polynomial coefficients to store in _alphas
+    // (target evaluations known analytically are applied directly by applyTargetsToBatch)
+    if (!this->usesAnalyticTargetRows()) {
+        auto functor_evaluate_standard_targets = EvaluateStandardTargets<solve_scalar_type>(gmls_basis_data);
+        Kokkos::parallel_for(tp, functor_evaluate_standard_targets, "EvaluateStandardTargets");
+    }
+
+}
+
+template <typename solve_scalar_type>
+void GMLS::applyTargetsToBatch(const int this_batch_size, const bool apply_to_data) {
+
+    auto gmls_solution_data = createGMLSSolutionData<solve_scalar_type>(*this);
+
+    // fine grain control over applying target (most expensive part after QR solve)
+    ParallelManager pm;
+    pm.setExecutionSpace(_pm.getExecutionSpace());
+    auto tp = pm.TeamPolicyThreadsAndVectors(this_batch_size, pm._default_threads, pm._default_vector_lanes);
+    const auto work_item_property = Kokkos::Experimental::WorkItemProperty::HintLightWeight;
+    const auto tp2 = Kokkos::Experimental::require(tp, work_item_property);
+    if (apply_to_data) {
+        auto functor_apply_targets_to_data = ApplyTargetsToData<solve_scalar_type>(gmls_solution_data);
+        Kokkos::parallel_for(tp2, functor_apply_targets_to_data, "ApplyTargetsToData");
+    } else {
+        auto functor_apply_targets = ApplyTargets<solve_scalar_type>(gmls_solution_data);
+        //printf("size of apply: %lu\n",  sizeof(functor_apply_targets));
+        Kokkos::parallel_for(tp2, functor_apply_targets, "ApplyTargets");
+    }
+
+}
+
+void GMLS::getTiledKernelTiling(const bool keep_coefficients, int& targets_per_team, int& threads_per_team) const {
+
+    targets_per_team = 0;
+    threads_per_team = 0;
+
+    // polynomial coefficients never leave scratch memory, and prestencil weights are not computed
+    if (_targets_per_team == 1 || keep_coefficients || _problem_type != ProblemType::STANDARD 
+            || _constraint_type != ConstraintType::NO_CONSTRAINT || _dense_solver_type != DenseSolverType::QR
+            || _data_sampling_functional == StaggeredEdgeAnalyticGradientIntegralSample) {
+        return;
+    }
+
+    // each thread evaluates a basis compiled for the dimension and polynomial order (up to 2), and forms alphas
+    // from analytic target evaluations (see launchTiledStandardGMLS)
+    if (!this->usesAnalyticTargetRows() || _poly_order > 2 || _dimensions > 3) return;
+
+    // low order stencils leave most of a team idle when it solves a single problem
+    if (_targets_per_team == 0 && _NP > 6) return;
+    const int requested_targets_per_team = (_targets_per_team == 0) ? 32 : _targets_per_team;
+
+    // a problem for each thread of a team must fit in the fastest level of scratch memory, so a team has fewer
+    // threads than target sites when neighborhoods are large (each thread then solves for several target sites)
+    int max_num_neighbors = 0;
+    for (size_t batch_num=0; batch_num<_batch_max_num_neighbors.size(); ++batch_num) {
+        max_num_neighbors = std::max(max_num_neighbors, _batch_max_num_neighbors[batch_num]);
+    }
+    const int thread_scratch_size = (_single_precision_solve) ? 
+        getTiledStandardGMLSScratchSize<float>(max_num_neighbors, _NP) 
+        : getTiledStandardGMLSScratchSize<double>(max_num_neighbors, _NP);
+    int threads = std::min(requested_targets_per_team, _pm._default_threads*_pm._default_vector_lanes);
+    while (threads > 1 && !_pm.fitsInFastestScratch(0, thread_scratch_size, threads)) threads /= 2;
+    if (!_pm.fitsInFastestScratch(0, thread_scratch_size, threads)) return;
+
+    targets_per_team = requested_targets_per_team;
+    threads_per_team = threads;
+
+}
+
+template <typename solve_scalar_type>
+void GMLS::solveTiledStandardBatch(const int this_batch_size, const bool apply_to_data) {
+
+    auto gmls_basis_data = createGMLSBasisData<solve_scalar_type>(*this);
+    auto gmls_solution_data = createGMLSSolutionData<solve_scalar_type>(*this);
+
+    // a problem for each thread is held in the fastest level of thread scratch
+    ParallelManager pm = _pm;
+    pm.clearScratchSizes();
+    pm.setThreadScratchSize(0, getTiledStandardGMLSScratchSize<solve_scalar_type>(_max_num_neighbors, _NP));
+    const int number_of_teams = (this_batch_size + _tiled_targets_per_team - 1)/_tiled_targets_per_team;
+    auto tp = pm.TeamPolicyThreadsAndVectors(number_of_teams, _tiled_threads_per_team, 1);
+
+    // (getTiledKernelTiling only tiles bases that launchTiledStandardGMLS compiles for)
+    launchTiledStandardGMLS<2>(tp, gmls_basis_data, 
+            gmls_basis_data, gmls_solution_data, this_batch_size, _tiled_targets_per_team, apply_to_data);
+
+}
+
+void GMLS::generatePolynomialCoefficientsInBatches(const int number_of_batches, const bool keep_coefficients, 
+        const bool overlap_batches, const AlphasMode alphas_mode, const alphas_consumer_type& alphas_consumer, 
+        const std::vector<int>& target_indices) {
+
+    compadre_assert_release( (keep_coefficients==false || number_of_batches==1)
+                && "keep_coefficients is set to true, but number of batches exceeds 1.");
+    compadre_assert_release( (!_single_precision_solve || (keep_coefficients==false 
+                && _problem_type != ProblemType::MANIFOLD))
+                && "Single precision solve is only available for STANDARD problems without keeping polynomial coefficients.");
+
+    /*
+     *    Quadrature, Operations, and Multipliers (reused if unchanged)
+     */
+    this->setupPolynomialCoefficientsPlan(keep_coefficients);
+
+    /*
+     *    Target Sites in Each Batch (bucketed by number of neighbors if requested)
+     */
+    this->setupBatches(number_of_batches, target_indices);
+    const int number_of_scheduled_batches = _batch_max_num_neighbors.size();
+    compadre_assert_release( (keep_coefficients==false || number_of_scheduled_batches==1)
+                && "keep_coefficients is set to true, but target sites are split among more than one neighbor bucket.");
+    compadre_assert_release( (keep_coefficients==false || !_order_targets_along_curve)
+                && "keep_coefficients is set to true, but target sites are ordered along a curve.");
+
+    // alphas for each batch are handed to alphas_consumer rather than stored for all target sites,
+    // which requires each batch to be a contiguous range of target sites
+    const bool stream_alphas = (alphas_mode == StreamAlphas);
+    const bool apply_to_data = (alphas_mode == ApplyToData);
+    compadre_assert_release( (!stream_alphas || _batch_target_indices.extent(0)==0)
+                && "Alphas can not be streamed when target sites are bucketed by number of neighbors or ordered along a curve.");
+
+    // target operations applied directly to data are not transformed by a sampling functional before or
+    // mapped to ambient space after, so only standard problems with untransformed data are supported
+    compadre_assert_release( (!apply_to_data || (_problem_type != ProblemType::MANIFOLD
+                && _data_sampling_functional.transform_type == Identity))
+                && "Target outputs can only be generated directly from data for standard problems with a data sampling functional that does not transform data.");
+    compadre_assert_release( (!apply_to_data || _sampling_data.extent(0) > 0 || _target_coordinates.extent(0) == 0)
+                && "Sampling data not set before generating target outputs.");
+
+    // batches are only overlapped if there is more than one of them, and not for manifold problems
+    // (which copy the tangent bundle back to the host and fence between kernels)
+    const bool use_overlap = overlap_batches && number_of_scheduled_batches > 1 && _problem_type != ProblemType::MANIFOLD;
+    const int number_of_buffers = (use_overlap) ? 2 : 1;
+
+    // low order stencils are solved by a single kernel for each batch, with a tile of target sites for each team 
+    // (one per thread), which keeps P, RHS, w, and Z in scratch memory
+    this->getTiledKernelTiling(keep_coefficients, _tiled_targets_per_team, _tiled_threads_per_team);
+
+    /*
+     *    Allocate Alphas, Prestencil Weights, P, RHS, w, and Z (reused if large enough)
+     */
+    this->allocatePolynomialCoefficientsStorage(number_of_batches, 0, 0, number_of_buffers, alphas_mode);
+
+    if (alphas_mode == PatchAlphas) {
+        // alphas of target sites being solved for are cleared, since a target site whose number of 
+        // neighbors shrank does not overwrite all of the alphas it previously had
+        auto d_ss = _d_ss;
+        auto batch_target_indices = _batch_target_indices;
+        const int added_alpha_size = _d_ss._added_alpha_size;
+        const global_index_type alphas_per_neighbor = TO_GLOBAL(_d_ss._total_stored_alpha_values)*TO_GLOBAL(_d_ss._max_evaluation_sites_per_target);
+        Kokkos::parallel_for("clear patched alphas", Kokkos::RangePolicy<device_execution_space>(0, batch_target_indices.extent(0)), 
+                KOKKOS_LAMBDA(const int i) {
+            const int target_index = batch_target_indices(i);
+            const global_index_type first_alpha_index = d_ss.getAlphaIndex(target_index, 0);
+            const global_index_type num_alphas = TO_GLOBAL(d_ss._neighbor_lists.getNumberOfNeighborsDevice(target_index) 
+                    + added_alpha_size)*alphas_per_neighbor;
+            for (global_index_type j=0; j<num_alphas; ++j) {
+                d_ss._alphas(first_alpha_index + j) = 0.0;
+            }
+        });
+        Kokkos::fence();
+    }
+
+    /*
+     *    Dimensions
+     */
+
+    // dimensions that are relevant for each subproblem (rows depend on each batch's maximum number of neighbors)
+    int max_num_rows = 0;
+    int this_num_cols = _basis_multiplier*_NP;
+    int manifold_NP = 0;
+
+    if (_problem_type == ProblemType::MANIFOLD) {
+        // these dimensions already calculated differ in the case of manifolds
+        manifold_NP = this->getNP(_curvature_poly_order, _dimensions-1, ReconstructionSpace::ScalarTaylorPolynomial);
+        const int max_manifold_NP = (manifold_NP > _NP) ? manifold_NP : _NP;
+        this_num_cols = _basis_multiplier*max_manifold_NP;
+    }
+
+    int RHS_dim_0, RHS_dim_1;
+    int P_dim_0, P_dim_1;
+
     /*
      *    Calculate Optimal Threads Based On Levels of Parallelism
      */
@@ -216,19 +957,117 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
                 && "Normal vectors are required for solving GMLS problems with the NEUMANN_GRAD_SCALAR constraint.");
     }
 
-    _initial_index_for_batch = 0;
-    for (int batch_num=0; batch_num<number_of_batches; ++batch_num) {
+    /*
+     *    Buffers and Execution Space Instances
+     */
 
-        auto this_batch_size = std::min(_target_coordinates.extent(0)-_initial_index_for_batch, max_batch_size);
-        Kokkos::deep_copy(_RHS, 0.0);
-        Kokkos::deep_copy(_P, 0.0);
-        Kokkos::deep_copy(_w, 0.0);
-        Kokkos::deep_copy(_Z, 0.0);
+    // each buffer has its own _w, _P, _RHS, and _Z, stored back to back, and its own execution space instance
+    // so that a batch launched on one buffer does not wait on work still queued for the other buffer
+    const device_execution_space default_space = _pm.getExecutionSpace();
+    std::vector<device_execution_space> buffer_spaces(number_of_buffers, default_space);
+    std::vector<Kokkos::View<double*> > w_buffers(number_of_buffers), P_buffers(number_of_buffers), 
+        RHS_buffers(number_of_buffers), Z_buffers(number_of_buffers);
+    std::vector<Kokkos::View<float*> > P_float_buffers(number_of_buffers), RHS_float_buffers(number_of_buffers);
+#ifdef COMPADRE_USE_CUDA
+    std::vector<cudaStream_t> buffer_streams(number_of_buffers);
+#endif
+    for (int buffer_num=0; buffer_num<number_of_buffers; ++buffer_num) {
+        w_buffers[buffer_num] = Kokkos::subview(_w_storage, 
+                Kokkos::make_pair(buffer_num*_w.extent(0), (buffer_num+1)*_w.extent(0)));
+        P_buffers[buffer_num] = Kokkos::subview(_P_storage, 
+                Kokkos::make_pair(buffer_num*_P.extent(0), (buffer_num+1)*_P.extent(0)));
+        RHS_buffers[buffer_num] = Kokkos::subview(_RHS_storage, 
+                Kokkos::make_pair(buffer_num*_RHS.extent(0), (buffer_num+1)*_RHS.extent(0)));
+        P_float_buffers[buffer_num] = Kokkos::subview(_P_float_storage, 
+                Kokkos::make_pair(buffer_num*_P_float.extent(0), (buffer_num+1)*_P_float.extent(0)));
+        RHS_float_buffers[buffer_num] = Kokkos::subview(_RHS_float_storage, 
+                Kokkos::make_pair(buffer_num*_RHS_float.extent(0), (buffer_num+1)*_RHS_float.extent(0)));
+        Z_buffers[buffer_num] = Kokkos::subview(_Z_storage, 
+                Kokkos::make_pair(buffer_num*_Z.extent(0), (buffer_num+1)*_Z.extent(0)));
+#ifdef COMPADRE_USE_CUDA
+        if (use_overlap) {
+            cudaStreamCreate(&buffer_streams[buffer_num]);
+            buffer_spaces[buffer_num] = device_execution_space(buffer_streams[buffer_num]);
+        }
+#endif
+    }
 
-        auto gmls_basis_data = createGMLSBasisData(*this);
-        auto gmls_solution_data = createGMLSSolutionData(*this);
+    // when streaming, each buffer also has its own window of alphas storage and the solution set describing it
+    const global_index_type max_batch_alphas_size = (stream_alphas) ? this->getMaxBatchAlphasSize() : 0;
+    std::vector<SolutionSet<device_memory_space> > buffer_solution_sets(number_of_buffers);
+
+    // batch currently occupying each buffer (-1 if none), and when each batch was launched
+    std::vector<int> batch_in_buffer(number_of_buffers, -1);
+    std::vector<double> batch_start_times(number_of_scheduled_batches, 0.0);
+    _batch_times.assign(number_of_scheduled_batches, 0.0);
+    Kokkos::Timer timer;
+
+    // waits on the batch occupying a buffer, records its time, and hands its alphas to alphas_consumer
+    auto complete_batch = [&](const int buffer_num) {
+        buffer_spaces[buffer_num].fence();
+        const int completed_batch_num = batch_in_buffer[buffer_num];
+        if (completed_batch_num >= 0) {
+            _batch_times[completed_batch_num] = timer.seconds() - batch_start_times[completed_batch_num];
+            if (stream_alphas) {
+                alphas_consumer(buffer_solution_sets[buffer_num], (int)_batch_offsets[completed_batch_num], 
+                        (int)_batch_offsets[completed_batch_num+1]);
+            }
+        }
+        batch_in_buffer[buffer_num] = -1;
+    };
+
+    for (int batch_num=0; batch_num<number_of_scheduled_batches; ++batch_num) {
+
+        // the batch previously using this buffer must complete before its buffer is reused
+        const int buffer_num = batch_num % number_of_buffers;
+        complete_batch(buffer_num);
+        batch_in_buffer[buffer_num] = batch_num;
+        batch_start_times[batch_num] = timer.seconds();
+
+        _pm.setExecutionSpace(buffer_spaces[buffer_num]);
+        _w = w_buffers[buffer_num];
+        _P = P_buffers[buffer_num];
+        _RHS = RHS_buffers[buffer_num];
+        _P_float = P_float_buffers[buffer_num];
+        _RHS_float = RHS_float_buffers[buffer_num];
+        _Z = Z_buffers[buffer_num];
+
+        // matrices for this batch are sized by the maximum number of neighbors of its target sites
+        _initial_index_for_batch = _batch_offsets[batch_num];
+        _max_num_neighbors = _batch_max_num_neighbors[batch_num];
+        auto this_batch_size = _batch_offsets[batch_num+1] - _batch_offsets[batch_num];
+        max_num_rows = _sampling_multiplier*_max_num_neighbors;
+        getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, RHS_dim_0, RHS_dim_1);
+        getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, max_num_rows, this_num_cols, P_dim_0, P_dim_1);
+
+        if (stream_alphas) {
+            // alphas for this batch's range of target sites are written to this buffer's window of storage
+            const global_index_type alphas_window_start = TO_GLOBAL(buffer_num)*max_batch_alphas_size;
+            _d_ss._alphas = Kokkos::subview(_alphas_storage, Kokkos::make_pair(alphas_window_start, 
+                        alphas_window_start + this->getAlphasSize(_batch_offsets[batch_num], _batch_offsets[batch_num+1])));
+            _d_ss._alpha_index_offset = this->getAlphasSize(0, _batch_offsets[batch_num]);
+            buffer_solution_sets[buffer_num] = _d_ss;
+        }
+
+        if (use_overlap) {
+            // deep_copy fences globally, so zero buffers with kernels on this buffer's execution space instance
+            zeroOnExecutionSpace(buffer_spaces[buffer_num], _RHS);
+            zeroOnExecutionSpace(buffer_spaces[buffer_num], _P);
+            zeroOnExecutionSpace(buffer_spaces[buffer_num], _RHS_float);
+            zeroOnExecutionSpace(buffer_spaces[buffer_num], _P_float);
+            zeroOnExecutionSpace(buffer_spaces[buffer_num], _w);
+            zeroOnExecutionSpace(buffer_spaces[buffer_num], _Z);
+            if (stream_alphas) zeroOnExecutionSpace(buffer_spaces[buffer_num], _d_ss._alphas);
+        } else {
+            Kokkos::deep_copy(_RHS, 0.0);
+            Kokkos::deep_copy(_P, 0.0);
+            Kokkos::deep_copy(_RHS_float, 0.0f);
+            Kokkos::deep_copy(_P_float, 0.0f);
+            Kokkos::deep_copy(_w, 0.0);
+            Kokkos::deep_copy(_Z, 0.0);
+            if (stream_alphas) Kokkos::deep_copy(_d_ss._alphas, 0.0);
+        }
 
-        
         // even kernels that should run on other # of vector lanes do not (on GPU)
         auto tp = _pm.TeamPolicyThreadsAndVectors(this_batch_size, _pm._default_threads, 1);
         //auto tp = _pm.TeamPolicyThreadsAndVectors(this_batch_size, _pm._default_threads, _pm._default_vector_lanes);
@@ -241,6 +1080,8 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
              *    MANIFOLD Problems
              */
 
+            auto gmls_basis_data = createGMLSBasisData<double>(*this);
+
             //auto functor_name = Name(gmls_basis_data);
             //Kokkos::parallel_for(tp, functor_name, "Name");
             if (!_orthonormal_tangent_space_provided) { // user did not specify orthonormal tangent directions, so we approximate them first
@@ -283,7 +1124,7 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
                 // Due to converting layout, entries that are assumed zeros may become non-zeros.
                 Kokkos::deep_copy(_P, 0.0);
 
-                if (batch_num==number_of_batches-1) {
+                if (batch_num==number_of_scheduled_batches-1) {
                     // copy tangent bundle from device back to host
                     _host_T = Kokkos::create_mirror_view(_T);
                     Kokkos::deep_copy(_host_T, _T);
@@ -316,7 +1157,7 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             // precedes polynomial reconstruction from data (replaces contents of _RHS) 
             // follows reconstruction of geometry
             // calculate prestencil weights
-            auto functor_compute_prestencil_weights = ComputePrestencilWeights(gmls_basis_data);
+            auto functor_compute_prestencil_weights = ComputePrestencilWeights<double>(gmls_basis_data);
             Kokkos::parallel_for(tp, functor_compute_prestencil_weights, "ComputePrestencilWeights");
 
             // Due to converting layout, entried that are assumed zeros may become non-zeros.
@@ -338,83 +1179,85 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             }
             Kokkos::fence();
 
-        } else {
+
+            // evaluates targets, applies target evaluation to polynomial coefficients to store in _alphas
+            auto functor_evaluate_manifold_targets = EvaluateManifoldTargets(gmls_basis_data);
+            Kokkos::parallel_for(tp, functor_evaluate_manifold_targets, "EvaluateManifoldTargets");
+
+        } else if (_tiled_targets_per_team > 0) {
 
             /*
-             *    STANDARD GMLS Problems
+             *    Low Order STANDARD GMLS Problems (a tile of target sites per team, one per thread)
              */
 
-            // assembles the P*sqrt(weights) matrix and constructs sqrt(weights)*Identity
-            auto functor_assemble_standard_psqrtw = AssembleStandardPsqrtW(gmls_basis_data);
-            //printf("size of assemble: %lu\n",  sizeof(functor_assemble_standard_psqrtw));
-            Kokkos::parallel_for(tp, functor_assemble_standard_psqrtw, "AssembleStandardPsqrtW");
-            Kokkos::fence();
-
-            // solves P*sqrt(weights) against sqrt(weights)*Identity, stored in RHS
-            if (_dense_solver_type == DenseSolverType::LU) {
-                    Kokkos::Profiling::pushRegion("LU Factorization");
-                    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_left,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, this_num_cols + added_coeff_size, this_num_cols + added_coeff_size, max_num_rows + _d_ss._added_alpha_size, this_batch_size);
-                    Kokkos::Profiling::popRegion();
+            if (_single_precision_solve) {
+                this->solveTiledStandardBatch<float>(this_batch_size, apply_to_data);
             } else {
-                Kokkos::Profiling::pushRegion("QR+Pivoting Factorization");
-                if (_constraint_type != ConstraintType::NO_CONSTRAINT) {
-                     GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(_pm, _RHS.data(), RHS_dim_0, RHS_dim_1, _P.data(), P_dim_1, P_dim_0, this_num_cols + added_coeff_size, this_num_cols + added_coeff_size, max_num_rows + _d_ss._added_alpha_size, this_batch_size);
-                } else {
-                    GMLS_LinearAlgebra::batchQRPivotingSolve<layout_right,layout_right,layout_right>(_pm, _P.data(), P_dim_0, P_dim_1, _RHS.data(), RHS_dim_0, RHS_dim_1, max_num_rows, this_num_cols, max_num_rows, this_batch_size);
-                }
-                Kokkos::Profiling::popRegion();
+                this->solveTiledStandardBatch<double>(this_batch_size, apply_to_data);
             }
 
-            auto functor_compute_prestencil_weights = ComputePrestencilWeights(gmls_basis_data);
-            Kokkos::parallel_for(tp, functor_compute_prestencil_weights, "ComputePrestencilWeights");
-            Kokkos::fence();
-        }
-
-        /*
-         *    Calculate Optimal Threads Based On Levels of Parallelism
-         */
-
-
-        if (_problem_type == ProblemType::MANIFOLD) {
+        } else if (_single_precision_solve) {
 
             /*
-             *    MANIFOLD Problems
+             *    STANDARD GMLS Problems
              */
 
-            // evaluates targets, applies target evaluation to polynomial coefficients to store in _alphas
-            auto functor_evaluate_manifold_targets = EvaluateManifoldTargets(gmls_basis_data);
-            Kokkos::parallel_for(tp, functor_evaluate_manifold_targets, "EvaluateManifoldTargets");
+            this->solveStandardBatch<float>(this_batch_size, use_overlap);
 
         } else {
 
-            /*
-             *    STANDARD GMLS Problems
-             */
+            this->solveStandardBatch<double>(this_batch_size, use_overlap);
 
-            // evaluates targets, applies target evaluation to polynomial coefficients to store in _alphas
-            auto functor_evaluate_standard_targets = EvaluateStandardTargets(gmls_basis_data);
-            Kokkos::parallel_for(tp, functor_evaluate_standard_targets, "EvaluateStandardTargets");
         }
 
-            
-        // fine grain control over applying target (most expensive part after QR solve)
-        ParallelManager pm;
-        tp = pm.TeamPolicyThreadsAndVectors(this_batch_size, pm._default_threads, pm._default_vector_lanes);
-        const auto work_item_property = Kokkos::Experimental::WorkItemProperty::HintLightWeight;
-        const auto tp2 = Kokkos::Experimental::require(tp, work_item_property);
-        auto functor_apply_targets = ApplyTargets(gmls_solution_data);
-        //printf("size of apply: %lu\n",  sizeof(functor_apply_targets));
-        Kokkos::parallel_for(tp2, functor_apply_targets, "ApplyTargets");
-
+        if (_tiled_targets_per_team > 0) {
+            // targets were applied by TiledStandardGMLS
+        } else if (_single_precision_solve) {
+            this->applyTargetsToBatch<float>(this_batch_size, apply_to_data);
+        } else {
+            this->applyTargetsToBatch<double>(this_batch_size, apply_to_data);
+        }
 
-        _initial_index_for_batch += this_batch_size;
-        if ((size_t)_initial_index_for_batch == _target_coordinates.extent(0)) break;
     } // end of batch loops
+    _max_num_neighbors = _neighbor_lists.getMaxNumNeighbors();
+
+    // wait on batches still in flight, oldest first
+    for (int buffer_num=0; buffer_num<number_of_buffers; ++buffer_num) {
+        complete_batch((number_of_scheduled_batches + buffer_num) % number_of_buffers);
+    }
+    if (stream_alphas) {
+        // alphas for all target sites were never stored
+        _d_ss._alphas = decltype(_d_ss._alphas)();
+        _d_ss._alpha_index_offset = 0;
+    }
+    _pm.setExecutionSpace(default_space);
+    buffer_spaces.clear();
+#ifdef COMPADRE_USE_CUDA
+    if (use_overlap) {
+        for (int buffer_num=0; buffer_num<number_of_buffers; ++buffer_num) {
+            cudaStreamDestroy(buffer_streams[buffer_num]);
+        }
+    }
+#endif
+
+    if (!_keep_plan_storage) {
+        // storage is not kept between calls, so release it
+        // (views still referencing it below keep it alive as needed)
+        _w_storage = decltype(_w_storage)();
+        _P_storage = decltype(_P_storage)();
+        _RHS_storage = decltype(_RHS_storage)();
+        _P_float_storage = decltype(_P_float_storage)();
+        _RHS_float_storage = decltype(_RHS_float_storage)();
+        _Z_storage = decltype(_Z_storage)();
+        _alphas_storage = decltype(_alphas_storage)();
+    }
 
-    // deallocate _P and _w
+    // deallocate _P and _w (polynomial coefficients are never kept from a single precision solve)
     _w = Kokkos::View<double*>("w",0);
     _Z = Kokkos::View<double*>("Z",0);
-    if (number_of_batches > 1) { // no reason to keep coefficients if they aren't all in memory
+    _P_float = Kokkos::View<float*>("P",0);
+    _RHS_float = Kokkos::View<float*>("RHS",0);
+    if (number_of_scheduled_batches > 1 || alphas_mode == PatchAlphas) { // no reason to keep coefficients if they aren't all in memory
         _RHS = Kokkos::View<double*>("RHS",0);
         _P = Kokkos::View<double*>("P",0);
         _entire_batch_computed_at_once = false;
@@ -423,7 +1266,7 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
             _RHS = Kokkos::View<double*>("RHS", 0);
             if (!keep_coefficients) _P = Kokkos::View<double*>("P", 0);
         } else {
-            if (_dense_solver_type != DenseSolverType::LU) {
+            if (!solvesNormalEquations(_dense_solver_type)) {
                 _P = Kokkos::View<double*>("P", 0);
                 if (!keep_coefficients) _RHS = Kokkos::View<double*>("RHS", 0);
             } else {
@@ -446,9 +1289,176 @@ void GMLS::generatePolynomialCoefficients(const int number_of_batches, const boo
 
 }
 
-void GMLS::generateAlphas(const int number_of_batches, const bool keep_coefficients) {
+void GMLS::generateAlphas(const int number_of_batches, const bool keep_coefficients, const bool overlap_batches) {
+
+    this->generatePolynomialCoefficients(number_of_batches, keep_coefficients, overlap_batches);
+
+}
+
+void GMLS::patchNeighborLists(host_managed_local_index_type cr_neighbor_lists, 
+        host_managed_local_index_type number_of_neighbors_list, std::vector<int>& changed_target_indices) {
+
+    const int num_targets = _neighbor_lists.getNumberOfTargets();
+    compadre_assert_release((_plan_is_current && _d_ss._alpha_index_offset == 0 
+                && _d_ss._alphas.extent(0) >= this->getAlphasSize(0, num_targets))
+            && "Alphas for all target sites must be generated by generatePolynomialCoefficients before they are regenerated for changed target sites.");
+    compadre_assert_release((number_of_neighbors_list.extent(0) == (size_t)num_targets)
+            && "number_of_neighbors_list must have an entry for every target site.");
+
+    // row offsets of the new neighbor lists (compressed row, so rows are back to back)
+    std::vector<global_index_type> new_row_offsets(num_targets+1, 0);
+    for (int i=0; i<num_targets; ++i) {
+        new_row_offsets[i+1] = new_row_offsets[i] + TO_GLOBAL(number_of_neighbors_list(i));
+    }
+    compadre_assert_release((new_row_offsets[num_targets] <= TO_GLOBAL(cr_neighbor_lists.extent(0)))
+            && "cr_neighbor_lists is not large enough to store all neighbors.");
+
+    // target sites whose number of neighbors changed are treated as changed, even if not listed
+    std::vector<bool> is_changed(num_targets, false);
+    for (size_t i=0; i<changed_target_indices.size(); ++i) {
+        compadre_assert_release((changed_target_indices[i] >= 0 && changed_target_indices[i] < num_targets)
+                && "Changed target index is out of range.");
+        is_changed[changed_target_indices[i]] = true;
+    }
+    for (int i=0; i<num_targets; ++i) {
+        if (!is_changed[i] && number_of_neighbors_list(i) != _neighbor_lists.getNumberOfNeighborsHost(i)) {
+            is_changed[i] = true;
+            changed_target_indices.push_back(i);
+        }
+    }
+
+    // each row can grow up to the next row's offset (or the end of neighbor lists and alphas for the last row)
+    const int added_alpha_size = _d_ss._added_alpha_size;
+    const global_index_type alphas_per_neighbor = TO_GLOBAL(_d_ss._total_stored_alpha_values)*TO_GLOBAL(_d_ss._max_evaluation_sites_per_target);
+    const global_index_type last_row_end = std::min(TO_GLOBAL(_neighbor_lists._cr_neighbor_lists.extent(0)), 
+            TO_GLOBAL(_d_ss._alphas.extent(0))/alphas_per_neighbor - TO_GLOBAL(num_targets)*TO_GLOBAL(added_alpha_size));
+    bool rows_fit = true;
+    for (int i=0; i<num_targets; ++i) {
+        if (!is_changed[i]) continue;
+        const global_index_type row_end = (i+1 < num_targets) ? _neighbor_lists.getRowOffsetHost(i+1) : last_row_end;
+        if (_neighbor_lists.getRowOffsetHost(i) + TO_GLOBAL(number_of_neighbors_list(i)) > row_end) {
+            rows_fit = false;
+            break;
+        }
+    }
+
+    typedef decltype(_neighbor_lists)::internal_view_type gmls_view_type;
+    gmls_view_type d_number_of_neighbors_list("number of neighbors list", num_targets);
+    auto h_number_of_neighbors_list = Kokkos::create_mirror_view(d_number_of_neighbors_list);
+    Kokkos::deep_copy(h_number_of_neighbors_list, number_of_neighbors_list);
+    Kokkos::deep_copy(d_number_of_neighbors_list, h_number_of_neighbors_list);
+
+    // neighbor lists are copied rather than modified, since they may be views given by the user
+    _neighbor_lists.copyDeviceDataToHost();
+    decltype(_neighbor_lists) new_neighbor_lists;
+    if (rows_fit) {
+
+        // all rows keep their offsets, so only rows of changed target sites are rewritten
+        gmls_view_type d_cr_neighbor_lists("compressed row neighbor lists data", _neighbor_lists._cr_neighbor_lists.extent(0));
+        auto h_cr_neighbor_lists = Kokkos::create_mirror_view(d_cr_neighbor_lists);
+        Kokkos::deep_copy(h_cr_neighbor_lists, _neighbor_lists._host_cr_neighbor_lists);
+        for (int i=0; i<num_targets; ++i) {
+            if (!is_changed[i]) continue;
+            for (int j=0; j<number_of_neighbors_list(i); ++j) {
+                h_cr_neighbor_lists(_neighbor_lists.getRowOffsetHost(i) + j) = cr_neighbor_lists(new_row_offsets[i] + j);
+            }
+        }
+        Kokkos::deep_copy(d_cr_neighbor_lists, h_cr_neighbor_lists);
+        new_neighbor_lists = decltype(_neighbor_lists)(d_cr_neighbor_lists, d_number_of_neighbors_list, 
+                _neighbor_lists._row_offsets);
+
+    } else {
+
+        // reflow: rows are put back to back (row offsets recomputed), taking unchanged rows from the current
+        // neighbor lists and changed rows from cr_neighbor_lists
+        gmls_view_type d_cr_neighbor_lists("compressed row neighbor lists data", new_row_offsets[num_targets]);
+        auto h_cr_neighbor_lists = Kokkos::create_mirror_view(d_cr_neighbor_lists);
+        for (int i=0; i<num_targets; ++i) {
+            for (int j=0; j<number_of_neighbors_list(i); ++j) {
+                h_cr_neighbor_lists(new_row_offsets[i] + j) = (is_changed[i]) ? 
+                    cr_neighbor_lists(new_row_offsets[i] + j) : _neighbor_lists.getNeighborHost(i, j);
+            }
+        }
+        Kokkos::deep_copy(d_cr_neighbor_lists, h_cr_neighbor_lists);
+        new_neighbor_lists = decltype(_neighbor_lists)(d_cr_neighbor_lists, d_number_of_neighbors_list);
+
+        // alphas of unchanged target sites are moved to where their rows now are
+        Kokkos::View<int*> d_is_changed("changed target sites", num_targets);
+        auto h_is_changed = Kokkos::create_mirror_view(d_is_changed);
+        for (int i=0; i<num_targets; ++i) h_is_changed(i) = is_changed[i];
+        Kokkos::deep_copy(d_is_changed, h_is_changed);
+
+        decltype(_d_ss._alphas) new_alphas;
+        try {
+            new_alphas = decltype(_d_ss._alphas)("alphas", (new_row_offsets[num_targets] 
+                        + TO_GLOBAL(num_targets)*TO_GLOBAL(added_alpha_size))*alphas_per_neighbor);
+        } catch(std::exception &e) {
+           printf("Insufficient memory to store alphas: \n\n%s", e.what()); 
+           throw e;
+        }
+        auto old_d_ss = _d_ss;
+        auto new_row_offsets_device = new_neighbor_lists._row_offsets;
+        Kokkos::parallel_for("move unchanged alphas", Kokkos::RangePolicy<device_execution_space>(0, num_targets), 
+                KOKKOS_LAMBDA(const int i) {
+            if (d_is_changed(i)) return;
+            const global_index_type old_alpha_index = old_d_ss.getAlphaIndex(i, 0);
+            const global_index_type new_alpha_index = (new_row_offsets_device(i) + TO_GLOBAL(i*added_alpha_size))*alphas_per_neighbor;
+            const global_index_type num_alphas = TO_GLOBAL(old_d_ss._neighbor_lists.getNumberOfNeighborsDevice(i) 
+                    + added_alpha_size)*alphas_per_neighbor;
+            for (global_index_type j=0; j<num_alphas; ++j) {
+                new_alphas(new_alpha_index + j) = old_d_ss._alphas(old_alpha_index + j);
+            }
+        });
+        Kokkos::fence();
+        _d_ss._alphas = new_alphas;
+        if (_keep_plan_storage) _alphas_storage = new_alphas;
+
+    }
+
+    _neighbor_lists = new_neighbor_lists;
+    _max_num_neighbors = _neighbor_lists.getMaxNumNeighbors();
+    _host_number_of_neighbors_list = decltype(_host_number_of_neighbors_list)("host number of neighbors list", num_targets);
+    Kokkos::deep_copy(_host_number_of_neighbors_list, number_of_neighbors_list);
+
+    if (_source_coordinates.extent(0)>0 && _target_coordinates.extent(0)>0) {
+        _pc = point_connections_type(_target_coordinates, _source_coordinates, _neighbor_lists);
+        _additional_pc = point_connections_type(_target_coordinates, _additional_evaluation_coordinates, _additional_evaluation_indices);
+    }
+    _h_ss._neighbor_lists = _neighbor_lists;
+    _d_ss._neighbor_lists = _neighbor_lists;
+
+}
+
+void GMLS::regeneratePolynomialCoefficientsInPlace(const std::vector<int>& changed_target_indices, 
+        const int number_of_batches) {
+
+    // each target site is solved for once, in order of target index
+    std::vector<int> target_indices(changed_target_indices);
+    std::sort(target_indices.begin(), target_indices.end());
+    target_indices.erase(std::unique(target_indices.begin(), target_indices.end()), target_indices.end());
+
+    const int num_targets = _target_coordinates.extent(0);
+    compadre_assert_release((target_indices.empty() || (target_indices.front() >= 0 && target_indices.back() < num_targets))
+            && "Changed target index is out of range.");
+    compadre_assert_release((_plan_is_current && _d_ss._alpha_index_offset == 0 
+                && _d_ss._alphas.extent(0) >= this->getAlphasSize(0, num_targets))
+            && "Alphas for all target sites must be generated by generatePolynomialCoefficients before they are regenerated for changed target sites.");
+
+    if (target_indices.empty()) return;
+
+    // prestencil weights are sized by the maximum number of neighbors for some sampling functionals,
+    // so if that changed, weights and alphas of all target sites are regenerated
+    size_t prestencil_dims[5];
+    this->getPrestencilWeightsDims(prestencil_dims);
+    for (int i=0; i<5; ++i) {
+        if (_prestencil_weights.extent(i) != prestencil_dims[i]) {
+            this->generatePolynomialCoefficients(number_of_batches);
+            return;
+        }
+    }
 
-    this->generatePolynomialCoefficients(number_of_batches, keep_coefficients);
+    this->generatePolynomialCoefficientsInBatches(number_of_batches, false /* keep_coefficients */, 
+            false /* overlap_batches */, PatchAlphas, alphas_consumer_type(), target_indices);
 
 }
 
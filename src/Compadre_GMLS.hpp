@@ -18,8 +18,8 @@
 namespace Compadre {
 
 class  Evaluator;
-struct GMLSBasisData;
-struct GMLSSolutionData;
+template <typename solve_scalar_type> struct GMLSBasisData;
+template <typename solve_scalar_type> struct GMLSSolutionData;
 
 //!  Generalized Moving Least Squares (GMLS)
 /*!
@@ -31,8 +31,10 @@ struct GMLSSolutionData;
 class GMLS {
 
 friend class Evaluator;
-friend const GMLSBasisData createGMLSBasisData(const GMLS& gmls);
-friend const GMLSSolutionData createGMLSSolutionData(const GMLS& gmls);
+template <typename solve_scalar_type>
+friend const GMLSBasisData<solve_scalar_type> createGMLSBasisData(const GMLS& gmls);
+template <typename solve_scalar_type>
+friend const GMLSSolutionData<solve_scalar_type> createGMLSSolutionData(const GMLS& gmls);
 
 public:
 
@@ -41,6 +43,12 @@ public:
             NeighborLists<Kokkos::View<int*> > > 
                 point_connections_type;
 
+    //! Receives alphas for a finished batch of target sites [first_target_index, end_target_index) when streaming
+    //! alphas. Alphas are accessed through the SolutionSet using target indices in that range, and are only 
+    //! valid until the consumer returns (after which their storage is reused for another batch).
+    typedef std::function<void(const SolutionSet<device_memory_space>& batch_solution_set, 
+            const int first_target_index, const int end_target_index)> alphas_consumer_type;
+
 private:
 
     // matrices that may be needed for matrix factorization on the device
@@ -49,15 +57,28 @@ private:
     //! contains weights for all problems
     Kokkos::View<double*> _w; 
 
-    //! P*sqrt(w) matrix for all problems
+    //! P*sqrt(w) matrix for all problems (empty if _single_precision_solve)
     Kokkos::View<double*> _P;
 
     //! sqrt(w)*Identity matrix for all problems, later holds polynomial coefficients for all problems
+    //! (empty if _single_precision_solve)
     Kokkos::View<double*> _RHS;
 
+    //! _P in single precision (only used if _single_precision_solve)
+    Kokkos::View<float*> _P_float;
+
+    //! _RHS in single precision (only used if _single_precision_solve)
+    Kokkos::View<float*> _RHS_float;
+
     //! stores evaluations of targets applied to basis
     Kokkos::View<double*> _Z;
 
+    //! target evaluations of a ScalarTaylorPolynomial basis at the target site, known without evaluating 
+    //! the basis. Row r describes row r of the target evaluations for one target: (r,0) entries are 
+    //! nonzero, each equal to epsilon^-(r,1), in the basis columns (r,2), (r,3), ... (empty unless every 
+    //! target operation has such a row, see usesAnalyticTargetRows)
+    Kokkos::View<int**, layout_right> _analytic_target_rows;
+
     //! Rank 3 tensor for high order approximation of tangent vectors for all problems. First rank is
     //! for the target index, the second is for the local direction to the manifolds 0..(_dimensions-1)
     //! are tangent, _dimensions is the normal, and the third is for the spatial dimension (_dimensions)
@@ -215,6 +236,12 @@ private:
     //! e.g. in 3D, a scalar will be 1, a vector will be 3, and a vector of reused scalars will be 3
     int _data_sampling_multiplier;
 
+    //! number of identical blocks on the diagonal of P, e.g. one for each component of a VectorTaylorPolynomial 
+    //! basis sampled with VectorPointSample. Only one block is assembled and solved for, so the dense solve 
+    //! has _sampling_multiplier/_number_of_diagonal_blocks rows per neighbor and _basis_multiplier/_number_of_diagonal_blocks
+    //! columns per member of the polynomial basis
+    int _number_of_diagonal_blocks;
+
     //! whether or not the orthonormal tangent directions were provided by the user. If they are not,
     //! then for the case of calculations on manifolds, a GMLS approximation of the tangent space will
     //! be made and stored for use.
@@ -240,6 +267,42 @@ private:
     //! maximum number of neighbors over all target sites
     int _max_num_neighbors;
 
+    //! number of buckets target sites are grouped into by number of neighbors (0 or 1 disables bucketing)
+    int _number_of_neighbor_buckets;
+
+    //! whether target sites are batched in Morton order rather than in the order given (see setOrderTargetsAlongCurve)
+    bool _order_targets_along_curve;
+
+    //! all target sites in Morton order, computed when first needed after target sites are set
+    std::vector<int> _target_curve_order;
+
+    //! whether P, RHS, and polynomial coefficients are stored and solved for in single precision
+    bool _single_precision_solve;
+
+    //! whether the Cholesky solve interleaves groups of target sites, one per SIMD lane (host only)
+    bool _pack_targets_for_simd;
+
+    //! number of target sites solved for by each team of TiledStandardGMLS, with a thread for each target site
+    //! (see setTargetsPerTeam, 0 chooses by a heuristic and 1 does not tile)
+    int _targets_per_team;
+
+    //! targets per team and threads per team of TiledStandardGMLS for the batches of the current call to 
+    //! generatePolynomialCoefficients (0 if they are not solved by TiledStandardGMLS, in which case _P, _RHS, 
+    //! _w, and _Z are needed)
+    int _tiled_targets_per_team, _tiled_threads_per_team;
+
+    //! target indices of the target sites solved for, in the order they are batched (grouped by neighbor bucket
+    //! when bucketing). Empty when all target sites are solved for without bucketing, in which case batches 
+    //! are contiguous ranges of target sites.
+    Kokkos::View<int*> _batch_target_indices;
+
+    //! first index of each batch (into _batch_target_indices if not empty), with one past 
+    //! the last index of the last batch as the final entry
+    std::vector<global_index_type> _batch_offsets;
+
+    //! maximum number of neighbors over target sites in each batch, used to size that batch's matrices
+    std::vector<int> _batch_max_num_neighbors;
+
     //! determines scratch level spaces and is used to call kernels
     ParallelManager _pm;
 
@@ -255,6 +318,46 @@ private:
     //! manages and calculates quadrature
     Quadrature _qm;
 
+    //! whether quadrature, operations on the device, and multipliers set up by a previous call
+    //! to generatePolynomialCoefficients are still valid and can be reused
+    bool _plan_is_current;
+
+    //! whether storage for _w, _P, _RHS, _Z, and alphas is kept after generatePolynomialCoefficients
+    //! returns (set by setupPolynomialCoefficients)
+    bool _keep_plan_storage;
+
+    //! storage backing _w, only reallocated when a larger problem is encountered
+    Kokkos::View<double*> _w_storage;
+
+    //! storage backing _P, only reallocated when a larger problem is encountered
+    Kokkos::View<double*> _P_storage;
+
+    //! storage backing _RHS, only reallocated when a larger problem is encountered
+    Kokkos::View<double*> _RHS_storage;
+
+    //! storage backing _P_float, only reallocated when a larger problem is encountered
+    Kokkos::View<float*> _P_float_storage;
+
+    //! storage backing _RHS_float, only reallocated when a larger problem is encountered
+    Kokkos::View<float*> _RHS_float_storage;
+
+    //! storage backing _Z, only reallocated when a larger problem is encountered
+    Kokkos::View<double*> _Z_storage;
+
+    //! wall time (seconds) spent on each batch in the most recent call to generatePolynomialCoefficients
+    std::vector<double> _batch_times;
+
+    //! storage backing alphas on the device, only reallocated when a larger problem is encountered
+    decltype(_d_ss._alphas) _alphas_storage;
+
+    //! sampling data (#source sites x input components) that target operations are applied to directly 
+    //! by generateTargetOutputs (only set during that call)
+    Kokkos::View<double**, layout_right> _sampling_data;
+
+    //! target outputs from generateTargetOutputs (#target sites x output components of all target operations,
+    //! repeated for each evaluation site)
+    Kokkos::View<double**, layout_right> _target_output;
+
 private:
 
 /** @name Private Modifiers
@@ -358,6 +461,59 @@ private:
 
     }
 
+    //! Sets up quadrature, operations on the device, and basis/sampling multipliers. Only repeated
+    //! if something they depend on has changed since the last call. The number of diagonal blocks
+    //! of P is set for every call, since it depends on keep_coefficients.
+    void setupPolynomialCoefficientsPlan(const bool keep_coefficients = false);
+
+    //! Number of identical blocks on the diagonal of P that the current basis and sampling functionals 
+    //! give (see _number_of_diagonal_blocks), requires the basis/sampling multipliers of the plan
+    int getNumberOfDiagonalBlocks(const bool keep_coefficients) const;
+
+    //! How alphas are provided for target sites by generatePolynomialCoefficientsInBatches
+    enum AlphasMode {
+        //! alphas are stored for all target sites
+        StoreAlphas,
+        //! alphas for each batch are handed to a consumer, and only stored for batches in flight
+        StreamAlphas,
+        //! target operations are applied directly to _sampling_data, and alphas are never formed
+        ApplyToData,
+        //! alphas of the target sites solved for are overwritten in place, and all other alphas are kept
+        PatchAlphas
+    };
+
+    //! Determines which target sites are in each batch and the maximum number of neighbors in each batch.
+    //! When bucketing by number of neighbors, each bucket is broken up into number_of_batches batches.
+    //! Only target sites in target_indices are batched, unless it is empty (all target sites).
+    void setupBatches(const int number_of_batches, const std::vector<int>& target_indices = std::vector<int>());
+
+    //! Sizes scratch space and provides _w, _P, _RHS, _Z, and alphas for the current problem,
+    //! growing their backing storage only if max_num_neighbors or max_num_targets requires it
+    //! (number_of_buffers copies of _w, _P, _RHS, and _Z are kept back to back in storage)
+    //! (alphas are allocated as needed for alphas_mode, e.g. only for the largest batch, for each buffer, 
+    //! when streaming, and data for target sites not being solved for is kept when patching alphas)
+    void allocatePolynomialCoefficientsStorage(const int number_of_batches, const int max_num_neighbors, 
+            const global_index_type max_num_targets, const int number_of_buffers = 1, 
+            const AlphasMode alphas_mode = StoreAlphas);
+
+    //! Generates polynomial coefficients for the target sites in target_indices (all if empty), providing 
+    //! alphas as described by alphas_mode (alphas_consumer is only used when streaming alphas)
+    void generatePolynomialCoefficientsInBatches(const int number_of_batches, const bool keep_coefficients, 
+            const bool overlap_batches, const AlphasMode alphas_mode, 
+            const alphas_consumer_type& alphas_consumer = alphas_consumer_type(),
+            const std::vector<int>& target_indices = std::vector<int>());
+
+    //! Replaces neighborhoods of changed target sites with those in cr_neighbor_lists (compressed row, host) while
+    //! keeping the row offsets of all other target sites, so that their alphas stay in place. Target sites whose 
+    //! number of neighbors changed are added to changed_target_indices. If a neighborhood no longer fits in its 
+    //! row, row offsets are recomputed and alphas of unchanged target sites are moved to their new rows.
+    void patchNeighborLists(host_managed_local_index_type cr_neighbor_lists, 
+            host_managed_local_index_type number_of_neighbors_list, std::vector<int>& changed_target_indices);
+
+    //! Regenerates alphas in place for the (sorted, unique) target sites in changed_target_indices
+    void regeneratePolynomialCoefficientsInPlace(const std::vector<int>& changed_target_indices, 
+            const int number_of_batches);
+
 ///@}
 
 
@@ -366,12 +522,107 @@ private:
  */
 ///@{
 
+    //! Returns target indices from a view of changed target indices, or from a mask if its value type is bool
+    template <typename view_type>
+    std::vector<int> getChangedTargetIndices(view_type changed_targets) const {
+        auto host_changed_targets = Kokkos::create_mirror_view(changed_targets);
+        Kokkos::deep_copy(host_changed_targets, changed_targets);
+        const bool is_mask = std::is_same<typename view_type::non_const_value_type, bool>::value;
+        compadre_assert_release((!is_mask || host_changed_targets.extent(0) == _target_coordinates.extent(0))
+                && "Mask of changed target sites must have an entry for each target site.");
+        std::vector<int> changed_target_indices;
+        for (size_t i=0; i<host_changed_targets.extent(0); ++i) {
+            if (!is_mask) {
+                changed_target_indices.push_back((int)host_changed_targets(i));
+            } else if (host_changed_targets(i)) {
+                changed_target_indices.push_back((int)i);
+            }
+        }
+        return changed_target_indices;
+    }
+
+    //! Returns a view of the given size into storage, reallocating storage only if it is too small
+    template <typename view_type>
+    static view_type getViewFromStorage(view_type& storage, const std::string& label, const global_index_type size) {
+        if (storage.extent(0) < (size_t)size) {
+            // release old storage before allocating larger storage
+            storage = view_type();
+            storage = view_type(Kokkos::view_alloc(Kokkos::WithoutInitializing, label), size);
+        }
+        return Kokkos::subview(storage, Kokkos::make_pair(TO_GLOBAL(0), size));
+    }
+
+    //! Dimensions of prestencil weights for the current data sampling functional and neighbor lists
+    void getPrestencilWeightsDims(size_t (&prestencil_dims)[5]) const;
+
+    //! Number of alpha values needed for target sites [first_target_index, end_target_index)
+    //! (requires setupPolynomialCoefficientsPlan)
+    global_index_type getAlphasSize(const global_index_type first_target_index, const global_index_type end_target_index) const;
+
+    //! Number of alpha values needed by the largest of the batches determined by setupBatches
+    global_index_type getMaxBatchAlphasSize() const;
+
+    //! Whether alphas are formed from _analytic_target_rows and the polynomial coefficients, skipping the 
+    //! evaluation of targets into _Z (requires setupPolynomialCoefficientsPlan)
+    bool usesAnalyticTargetRows() const {
+        return _analytic_target_rows.extent(0) > 0 && _h_ss._max_evaluation_sites_per_target == 1;
+    }
+
+    //! Fills a view with zeros using a kernel launched on an execution space instance
+    //! (deep_copy would fence all execution space instances)
+    template <typename view_type>
+    static void zeroOnExecutionSpace(const device_execution_space& space, view_type view) {
+        Kokkos::parallel_for("Zero View", Kokkos::RangePolicy<device_execution_space>(space, 0, view.extent(0)), 
+                KOKKOS_LAMBDA(const int i) {
+            view(i) = 0.0;
+        });
+    }
+
+    //! Size in bytes of an entry of _P or _RHS (or _P_float or _RHS_float) in the dense solve
+    std::size_t getSolveScalarSize() const {
+        return (_single_precision_solve) ? sizeof(float) : sizeof(double);
+    }
+
+    //! Entries of double_view or float_view (_P and _P_float, or _RHS and _RHS_float), whichever 
+    //! holds the scalar type of the dense solve
+    template <typename solve_scalar_type>
+    solve_scalar_type* getSolveData(const Kokkos::View<double*>& double_view, 
+            const Kokkos::View<float*>& float_view) const;
+
+    //! Assembles and solves for polynomial coefficients of the current batch of a STANDARD problem, 
+    //! then evaluates target operations on the basis, with the dense solve performed in solve_scalar_type
+    template <typename solve_scalar_type>
+    void solveStandardBatch(const int this_batch_size, const bool use_overlap);
+
+    //! Applies target evaluations to polynomial coefficients of the current batch, storing alphas, or target
+    //! outputs if apply_to_data, where polynomial coefficients are stored as solve_scalar_type
+    template <typename solve_scalar_type>
+    void applyTargetsToBatch(const int this_batch_size, const bool apply_to_data);
+
+    //! Assembles, solves, and applies targets for the current batch of a STANDARD problem with TiledStandardGMLS,
+    //! storing alphas, or target outputs if apply_to_data, with the dense solve performed in solve_scalar_type
+    template <typename solve_scalar_type>
+    void solveTiledStandardBatch(const int this_batch_size, const bool apply_to_data);
+
+    //! Targets per team and threads per team with which TiledStandardGMLS solves the batches determined by 
+    //! setupBatches (both 0 if it can not, or should not by the heuristic of setTargetsPerTeam)
+    void getTiledKernelTiling(const bool keep_coefficients, int& targets_per_team, int& threads_per_team) const;
+
+    //! Sizes of _RHS, _P, _w, and _Z needed by the largest of the batches determined by setupBatches
+    void getBatchStorageSizes(global_index_type& RHS_size, global_index_type& P_size, 
+            global_index_type& w_size, global_index_type& Z_size) const;
+
+    //! Bytes of free memory in the device memory space
+    static std::size_t getAvailableMemory();
+
     //! Parses a string to determine solver type
     static DenseSolverType parseSolverType(const std::string& dense_solver_type) {
         std::string solver_type_to_lower = dense_solver_type;
         transform(solver_type_to_lower.begin(), solver_type_to_lower.end(), solver_type_to_lower.begin(), ::tolower);
         if (solver_type_to_lower == "lu") {
             return DenseSolverType::LU;
+        } else if (solver_type_to_lower == "cholesky") {
+            return DenseSolverType::CHOLESKY;
         } else {
             return DenseSolverType::QR;
         }
@@ -462,6 +713,7 @@ public:
 
         _basis_multiplier = 1;
         _sampling_multiplier = 1;
+        _number_of_diagonal_blocks = 1;
 
         _orthonormal_tangent_space_provided = false; 
         _reference_outward_normal_direction_provided = false;
@@ -473,6 +725,18 @@ public:
 
         _max_num_neighbors = 0;
 
+        _number_of_neighbor_buckets = 0;
+
+        _order_targets_along_curve = false;
+
+        _single_precision_solve = false;
+
+        _pack_targets_for_simd = false;
+
+        _targets_per_team = 1;
+        _tiled_targets_per_team = 0;
+        _tiled_threads_per_team = 0;
+
         _global_dimensions = dimensions;
         if (_problem_type == ProblemType::MANIFOLD) {
             _local_dimensions = dimensions-1;
@@ -483,6 +747,9 @@ public:
         _order_of_quadrature_points = 0;
         _dimension_of_quadrature_points = 0;
 
+        _plan_is_current = false;
+        _keep_plan_storage = false;
+
         _h_ss = SolutionSet<host_memory_space>(
                 _data_sampling_functional,
                 _dimensions, 
@@ -631,7 +898,7 @@ public:
         compadre_assert_release(_store_PTWP_inv_PTW
                 && "generateAlphas() called with keep_coefficients set to false.");
         host_managed_local_index_type sizes("sizes", 2);
-        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && !solvesNormalEquations(_dense_solver_type)) {
             getRHSDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, M_by_N[1], M_by_N[0], sizes(0), sizes(1));
         } else {
             getPDims(_dense_solver_type, _constraint_type, _reconstruction_space, _dimensions, M_by_N[1], M_by_N[0], sizes(1), sizes(0));
@@ -639,6 +906,23 @@ public:
         return sizes;
     }
 
+    //! Returns wall time (seconds) spent on each batch in the most recent call to generatePolynomialCoefficients
+    //! (when batches are overlapped, each time spans from launch of the batch until it completes)
+    const std::vector<double>& getBatchTimes() const { return _batch_times; }
+
+    //! Returns target outputs (device) from the most recent call to generateTargetOutputs for a target operation,
+    //! as #target sites x output components of the target operation
+    Kokkos::View<double**, Kokkos::LayoutStride> getTargetOutput(TargetOperation lro, 
+            const int evaluation_site_local_index = 0) const {
+        const int lro_number = _h_ss._lro_lookup.extent(0) > 0 ? _h_ss._lro_lookup[(int)lro] : -1;
+        compadre_assert_release((lro_number >= 0) && "getTargetOutput called for a TargetOperation that was not registered.");
+        compadre_assert_release((_target_output.extent(1) > 0) && "getTargetOutput called before generateTargetOutputs.");
+        int first_column = evaluation_site_local_index*(int)(_target_output.extent(1)/_h_ss._max_evaluation_sites_per_target);
+        for (int j=0; j<lro_number; ++j) first_column += _h_ss._lro_output_tile_size(j);
+        return Kokkos::subview(_target_output, Kokkos::ALL(), 
+                Kokkos::make_pair(first_column, first_column + _h_ss._lro_output_tile_size(lro_number)));
+    }
+
     //! Dimension of the GMLS problem, set only at class instantiation
     int getDimensions() const { return _dimensions; }
 
@@ -693,6 +977,33 @@ public:
     //! Type of quadrature points
     std::string getQuadratureType() const { return _quadrature_type; }
 
+    //! Number of buckets target sites are grouped into by number of neighbors
+    int getNumberOfNeighborBuckets() const { return _number_of_neighbor_buckets; }
+
+    //! Whether target sites are batched in Morton order rather than in the order given
+    bool getOrderTargetsAlongCurve() const { return _order_targets_along_curve; }
+
+    //! Whether P, RHS, and polynomial coefficients are stored and solved for in single precision
+    bool getSinglePrecisionSolve() const { return _single_precision_solve; }
+
+    //! Whether the Cholesky solve interleaves groups of target sites, one per SIMD lane
+    bool getPackTargetsForSIMD() const { return _pack_targets_for_simd; }
+
+    //! Bytes currently held for alphas, prestencil weights, P, RHS, weights, target evaluations, batches of
+    //! target sites, and (for manifold problems) tangent bundle and curvature coefficients, i.e. what 
+    //! estimateMemoryFootprint estimates
+    std::size_t getPolynomialCoefficientsStorageBytes() const {
+        return (_alphas_storage.extent(0) + _prestencil_weights.size() + _w_storage.extent(0) + _Z_storage.extent(0) 
+                + _P_storage.extent(0) + _RHS_storage.extent(0) + ((_orthonormal_tangent_space_provided) ? 0 : _T.extent(0))
+                + _manifold_curvature_coefficients.extent(0))*sizeof(double)
+            + (_P_float_storage.extent(0) + _RHS_float_storage.extent(0))*sizeof(float)
+            + _batch_target_indices.extent(0)*sizeof(int);
+    }
+
+    //! Number of target sites solved for by each team, with a thread for each target site, for low order 
+    //! stencils (0 chooses by a heuristic, 1 does not tile)
+    int getTargetsPerTeam() const { return _targets_per_team; }
+
     //! Get neighbor list accessor
     decltype(_neighbor_lists)* getNeighborLists() { return &_pc._nla; }
 
@@ -747,7 +1058,7 @@ public:
                 && "Entire batch not computed at once, so getFullPolynomialCoefficientsBasis() can not be called.");
         compadre_assert_release(_store_PTWP_inv_PTW
                 && "generateAlphas() called with keep_coefficients set to false.");
-        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && (_dense_solver_type != DenseSolverType::LU)) {
+        if ((_constraint_type == ConstraintType::NO_CONSTRAINT) && !solvesNormalEquations(_dense_solver_type)) {
             return _RHS; 
         } else {
             return _P; 
@@ -787,7 +1098,8 @@ public:
                     output_component, input_component);
     }
 
-    //! Get solution set
+    //! Get solution set. Alphas stay valid after later calls to generatePolynomialCoefficients when
+    //! a copy of the solution set is kept, but may be updated in place by regeneratePolynomialCoefficients.
     decltype(_h_ss)* getSolutionSetHost() { 
         if (_h_ss._alphas.extent(0)==0 && _d_ss._alphas.extent(0)!=0) {
             // solution solved for on device, but now solution
@@ -1001,6 +1313,7 @@ public:
             // switches memory spaces
             Kokkos::deep_copy(_target_coordinates, host_target_coordinates);
         }
+        _target_curve_order.clear();
         _host_number_of_additional_evaluation_indices 
             = decltype(_host_number_of_additional_evaluation_indices)("number of additional evaluation indices", target_coordinates.extent(0));
         if (_additional_evaluation_indices.getNumberOfTargets() != _target_coordinates.extent(0)) {
@@ -1022,6 +1335,7 @@ public:
     void setTargetSites(decltype(_target_coordinates) target_coordinates) {
         // allocate memory on device
         _target_coordinates = target_coordinates;
+        _target_curve_order.clear();
         _host_number_of_additional_evaluation_indices 
             = decltype(_host_number_of_additional_evaluation_indices)("number of additional evaluation indices", target_coordinates.extent(0));
         if (_additional_evaluation_indices.getNumberOfTargets() != _target_coordinates.extent(0)) {
@@ -1232,12 +1546,14 @@ public:
     void setPolynomialOrder(const int poly_order) {
         _poly_order = poly_order;
         _NP = this->getNP(_poly_order, _dimensions, _reconstruction_space);
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
     //! Sets basis order to be used when reoncstructing curvature
     void setCurvaturePolynomialOrder(const int manifold_poly_order) {
         _curvature_poly_order = manifold_poly_order;
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
@@ -1268,36 +1584,99 @@ public:
     //! Number quadrature points to use
     void setOrderOfQuadraturePoints(int order) { 
         _order_of_quadrature_points = order;
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
     //! Dimensions of quadrature points to use
     void setDimensionOfQuadraturePoints(int dim) { 
         _dimension_of_quadrature_points = dim;
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
     //! Type of quadrature points
     void setQuadratureType(std::string quadrature_type) { 
         _quadrature_type = quadrature_type;
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
+    //! Groups target sites into number_of_neighbor_buckets buckets of equal width in number of neighbors.
+    //! Each bucket is assembled and solved with matrices sized by the largest number of neighbors in
+    //! that bucket, rather than the largest number of neighbors over all target sites. Alphas are 
+    //! stored in the same layout either way. (0 or 1 disables bucketing)
+    void setNumberOfNeighborBuckets(const int number_of_neighbor_buckets) { 
+        compadre_assert_release(number_of_neighbor_buckets>=0 && "number_of_neighbor_buckets must be non-negative.");
+        _number_of_neighbor_buckets = number_of_neighbor_buckets;
+        this->resetCoefficientData();
+    }
+
+    //! Batches target sites in Morton order (a Z-order space filling curve over their bounding box), so that
+    //! target sites solved for by consecutive teams are near each other and gather many of the same neighbor
+    //! coordinates. Only the order target sites are solved in changes, so alphas, SolutionSet, and Evaluator 
+    //! remain indexed by target sites as given. Within each bucket of setNumberOfNeighborBuckets, Morton order 
+    //! is kept. Like bucketing, this prevents alphas from being streamed. (default is false)
+    void setOrderTargetsAlongCurve(const bool order_targets_along_curve) { 
+        _order_targets_along_curve = order_targets_along_curve;
+        this->resetCoefficientData();
+    }
+
+    //! Stores P, RHS, and polynomial coefficients in single precision and performs the dense solve in single
+    //! precision, halving memory and bandwidth needed by the solve. Basis evaluation and alphas remain double 
+    //! precision. Intended for low polynomial orders, where single precision is accurate enough. Only 
+    //! available for STANDARD problems, and polynomial coefficients can not be kept.
+    void setSinglePrecisionSolve(const bool single_precision_solve) { 
+        _single_precision_solve = single_precision_solve;
+        this->resetCoefficientData();
+    }
+
+    //! Interleaves the normal equations of groups of target sites (as many as fit in a SIMD register) in a 
+    //! compact layout, so that the CHOLESKY dense solver factors and solves a whole group per instruction 
+    //! rather than one target site at a time. Intended for CPU builds, where each team has a single vector
+    //! lane and small dense problems otherwise run as scalar code. Requires the CHOLESKY dense solver and 
+    //! a device memory space accessible from the host, and is not available in builds with CUDA.
+    void setPackTargetsForSIMD(const bool pack_targets_for_simd) { 
+#if defined(COMPADRE_USE_CUDA)
+        compadre_assert_release(!pack_targets_for_simd 
+                && "Packing target sites for SIMD is only available in builds without CUDA.");
+#endif
+        _pack_targets_for_simd = pack_targets_for_simd;
+    }
+
+    //! Sets the number of target sites solved for by each team of a single kernel that assembles, solves, and
+    //! applies targets in scratch memory, where each thread owns a target site and solves its small problem alone, 
+    //! rather than every thread of a team working on a single problem. Applies to STANDARD problems without 
+    //! constraints, solved with QR, with a ScalarTaylorPolynomial basis sampled with PointSample of polynomial order
+    //! at most 2, and target operations known analytically (point evaluations, first partial derivatives, and 
+    //! Laplacians), when polynomial coefficients are not kept. Takes effect at the next call to 
+    //! generatePolynomialCoefficients.
+    //! 0 - chooses by a heuristic, tiling when the basis has at most 6 functions
+    //! 1 - one target site per team (no tiling, default)
+    //! >1 - tiles of targets_per_team target sites
+    void setTargetsPerTeam(const int targets_per_team) { 
+        compadre_assert_release(targets_per_team >= 0 && "targets_per_team must be non-negative.");
+        _targets_per_team = targets_per_team;
+    }
+
     //! Adds a target to the vector of target functional to be applied to the reconstruction
     void addTargets(TargetOperation lro) {
         _h_ss.addTargets(lro);
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
     //! Adds a vector of target functionals to the vector of target functionals already to be applied to the reconstruction
     void addTargets(std::vector<TargetOperation> lro) {
         _h_ss.addTargets(lro);
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
     //! Empties the vector of target functionals to apply to the reconstruction
     void clearTargets() {
         _h_ss.clearTargets();
+        _plan_is_current = false;
         this->resetCoefficientData();
     }
 
@@ -1307,21 +1686,198 @@ public:
     //! global linear system.
     //! \param number_of_batches    [in] - how many batches to break up the total workload into (for storage)
     //! \param keep_coefficients    [in] - whether to store (P^T W P)^-1 * P^T * W
+    //! \param overlap_batches      [in] - whether to double buffer batches so that assembly of one batch is
+    //!                                   launched on a separate execution space instance while the previous
+    //!                                   batch is solved and applied (only used when number_of_batches>1 and
+    //!                                   not for manifold problems)
+    */
+    void generatePolynomialCoefficients(const int number_of_batches = 1, const bool keep_coefficients = false, 
+            const bool overlap_batches = false);
+
+    /*! \brief Generates polynomial coefficients, streaming alphas for each batch to a consumer
+    //! Alphas are only stored for the batches in flight, so memory needed for alphas scales with the
+    //! batch size rather than with the number of target sites. After each batch completes, alphas_consumer
+    //! is called (in order of target sites) with that batch's alphas and range of target sites, and 
+    //! may apply them to data, compress them, copy them elsewhere, etc. Alphas are not available through 
+    //! getSolutionSetHost/Device afterward. Can not be combined with neighbor bucketing.
+    //! \param alphas_consumer      [in] - called with the alphas of each completed batch
+    //! \param number_of_batches    [in] - how many batches to break up the total workload into
+    //! \param overlap_batches      [in] - whether to overlap consecutive batches (see generatePolynomialCoefficients)
+    */
+    void generatePolynomialCoefficients(const alphas_consumer_type& alphas_consumer, const int number_of_batches = 1, 
+            const bool overlap_batches = false);
+
+    /*! \brief Generates target outputs by applying target operations directly to sampling data (matrix-free)
+    //! For each batch, the target evaluations (P_target_row) and polynomial coefficients (Q) are contracted
+    //! against the data of each target site's neighbors in the same kernel, so alphas are never stored.
+    //! This is preferable to generatePolynomialCoefficients followed by an Evaluator when data is applied to
+    //! only once. Supports standard (not manifold) problems with a data sampling functional that does not
+    //! transform data (e.g. PointSample, VectorPointSample). Outputs are retrieved with getTargetOutput.
+    //! \param sampling_data        [in] - 1D or 2D Kokkos View (#source sites x input components, any memory space).
+    //!                                    A single column (or 1D view) is used for every input component.
+    //! \param number_of_batches    [in] - how many batches to break up the total workload into
+    //! \param overlap_batches      [in] - whether to overlap consecutive batches (see generatePolynomialCoefficients)
+    */
+    template<typename view_type>
+    void generateTargetOutputs(view_type sampling_data, const int number_of_batches = 1, 
+            const bool overlap_batches = false) {
+
+        compadre_assert_release((sampling_data.extent(0) >= _source_coordinates.extent(0))
+                && "sampling_data has fewer rows than there are source sites.");
+
+        // allocate memory on device (a 1D view is stored as a single column)
+        _sampling_data = decltype(_sampling_data)("device sampling data",
+                sampling_data.extent(0), sampling_data.extent(1));
+
+        // copy to the host, then rearrange into the layout used internally
+        // (handles 1D or 2D data and potential layout mismatches)
+        auto host_sampling_data = Kokkos::create_mirror_view(sampling_data);
+        Kokkos::deep_copy(host_sampling_data, sampling_data);
+        auto host_internal_sampling_data = Kokkos::create_mirror_view(_sampling_data);
+        for (size_t i=0; i<_sampling_data.extent(0); ++i) {
+            for (size_t j=0; j<_sampling_data.extent(1); ++j) {
+                host_internal_sampling_data(i,j) = host_sampling_data.access(i,j);
+            }
+        }
+        // switches memory spaces
+        Kokkos::deep_copy(_sampling_data, host_internal_sampling_data);
+
+        this->generatePolynomialCoefficientsInBatches(number_of_batches, false, overlap_batches, ApplyToData);
+
+        // no reason to hold on to data once it has been applied
+        _sampling_data = decltype(_sampling_data)();
+    }
+
+    /*! \brief Regenerates alphas for only the target sites that changed, patching them in place
+    //! Intended for when only a small portion of target sites (or their neighbors) moved since alphas were 
+    //! generated by generatePolynomialCoefficients. Updated coordinates and window sizes should be set first 
+    //! (e.g. with setSourceSites, setTargetSites, and setWindowSizes). Assembly, solve, and target evaluation 
+    //! are only performed for changed target sites, and alphas of all other target sites are left untouched.
+    //! Polynomial coefficients are not kept, even if they were kept when alphas were generated.
+    //! \param changed_targets      [in] - 1D Kokkos View (any memory space) of changed target indices or, 
+    //!                                    if its value type is bool, a mask with an entry for each target site
+    //! \param number_of_batches    [in] - how many batches to break up the changed target sites into
     */
-    void generatePolynomialCoefficients(const int number_of_batches = 1, const bool keep_coefficients = false);
+    template <typename view_type>
+    void regeneratePolynomialCoefficients(view_type changed_targets, const int number_of_batches = 1) {
+        this->regeneratePolynomialCoefficientsInPlace(this->getChangedTargetIndices(changed_targets), number_of_batches);
+    }
+
+    /*! \brief Regenerates alphas for only the target sites that changed, also updating their neighborhoods
+    //! Same as regeneratePolynomialCoefficients(changed_targets, number_of_batches), but also replaces the 
+    //! neighborhoods of changed target sites. Target sites whose number of neighbors changed are regenerated
+    //! even if they are not in changed_targets. Each neighborhood keeps its position in the compressed row 
+    //! neighbor lists (and so in alphas) when it fits, so that only alphas of changed target sites are 
+    //! touched. If a neighborhood grows past the start of the next one, neighbor lists are reflowed (row 
+    //! offsets are recomputed) and alphas of unchanged target sites are moved to their new positions.
+    //! \param changed_targets          [in] - 1D Kokkos View of changed target indices or a mask (see above)
+    //! \param cr_neighbor_lists        [in] - new compressed row neighbor lists for all target sites (only rows
+    //!                                        of changed target sites are used)
+    //! \param number_of_neighbors_list [in] - new number of neighbors for each target site
+    //! \param number_of_batches        [in] - how many batches to break up the changed target sites into
+    */
+    template <typename view_type, typename view_type_1, typename view_type_2>
+    void regeneratePolynomialCoefficients(view_type changed_targets, view_type_1 cr_neighbor_lists, 
+            view_type_2 number_of_neighbors_list, const int number_of_batches = 1) {
+
+        auto changed_target_indices = this->getChangedTargetIndices(changed_targets);
+
+        // copy new neighbor lists to the host, where they are merged with the current neighbor lists
+        auto host_cr_neighbor_lists_mirror = Kokkos::create_mirror_view(cr_neighbor_lists);
+        auto host_number_of_neighbors_list_mirror = Kokkos::create_mirror_view(number_of_neighbors_list);
+        Kokkos::deep_copy(host_cr_neighbor_lists_mirror, cr_neighbor_lists);
+        Kokkos::deep_copy(host_number_of_neighbors_list_mirror, number_of_neighbors_list);
+        host_managed_local_index_type host_cr_neighbor_lists("host neighbor lists", cr_neighbor_lists.extent(0));
+        host_managed_local_index_type host_number_of_neighbors_list("host number of neighbors list", 
+                number_of_neighbors_list.extent(0));
+        Kokkos::deep_copy(host_cr_neighbor_lists, host_cr_neighbor_lists_mirror);
+        Kokkos::deep_copy(host_number_of_neighbors_list, host_number_of_neighbors_list_mirror);
+
+        this->patchNeighborLists(host_cr_neighbor_lists, host_number_of_neighbors_list, changed_target_indices);
+        this->regeneratePolynomialCoefficientsInPlace(changed_target_indices, number_of_batches);
+    }
+
+    /*! \brief Sets up and allocates everything needed by generatePolynomialCoefficients ahead of time
+        Quadrature, target operations, and multipliers are set up once, and storage for P, RHS, weights, 
+        target evaluations, and alphas is kept between subsequent calls to generatePolynomialCoefficients.
+        Storage is only reallocated when a later problem (e.g. after setProblemData) is larger than
+        what has been allocated. Storage is kept until clearPolynomialCoefficientsStorage is called.
+        Alphas from an earlier call are reused as storage only if nothing else references them; if a copy of
+        the solution set (or a view from getAlphas) is still held, the next call allocates new alphas instead.
+        \param number_of_batches    [in] - how many batches the workload will be broken up into
+        \param max_num_neighbors    [in] - largest number of neighbors expected for any target site (0 uses current neighbor lists)
+        \param max_num_targets      [in] - largest number of target sites expected (0 uses current target sites)
+        \param keep_coefficients    [in] - whether polynomial coefficients will be kept (see generatePolynomialCoefficients)
+    */
+    void setupPolynomialCoefficients(const int number_of_batches = 1, const int max_num_neighbors = 0, 
+            const int max_num_targets = 0, const bool keep_coefficients = false);
+
+    /*! \brief Estimates the bytes allocated by generatePolynomialCoefficients
+    //! Includes alphas, prestencil weights, P, RHS, weights, target evaluations, and (for manifold problems)
+    //! tangent bundle and curvature coefficients. Sets up quadrature and target operations if needed, but 
+    //! allocates no storage.
+    //! \param number_of_batches    [in] - how many batches the workload would be broken up into
+    //! \param overlap_batches      [in] - whether batches would be overlapped (doubling batch storage)
+    //! \param stream_alphas        [in] - whether alphas would be streamed (only stored for batches in flight)
+    //! \param keep_coefficients    [in] - whether polynomial coefficients would be kept (P is then solved 
+    //!                                    for in full, rather than one of its identical diagonal blocks)
+    */
+    std::size_t estimateMemoryFootprint(const int number_of_batches = 1, const bool overlap_batches = false,
+            const bool stream_alphas = false, const bool keep_coefficients = false);
+
+    /*! \brief Smallest number of batches for which generatePolynomialCoefficients fits in a memory budget
+    //! \param memory_budget        [in] - bytes available (0 uses free memory in the device memory space)
+    //! \param overlap_batches      [in] - whether batches will be overlapped (doubling batch storage)
+    //! \param stream_alphas        [in] - whether alphas will be streamed (only stored for batches in flight)
+    //! \param keep_coefficients    [in] - whether polynomial coefficients will be kept
+    */
+    int selectNumberOfBatches(const std::size_t memory_budget = 0, const bool overlap_batches = false,
+            const bool stream_alphas = false, const bool keep_coefficients = false);
+
+    //! Releases storage kept by setupPolynomialCoefficients. Subsequent calls to generatePolynomialCoefficients
+    //! allocate and deallocate their own storage.
+    void clearPolynomialCoefficientsStorage() {
+        _keep_plan_storage = false;
+        _w_storage = decltype(_w_storage)();
+        _P_storage = decltype(_P_storage)();
+        _RHS_storage = decltype(_RHS_storage)();
+        _P_float_storage = decltype(_P_float_storage)();
+        _RHS_float_storage = decltype(_RHS_float_storage)();
+        _Z_storage = decltype(_Z_storage)();
+        _alphas_storage = decltype(_alphas_storage)();
+    }
 
     /*! \brief Meant to calculate target operations and apply the evaluations to the previously 
     //! constructed polynomial coefficients. But now that is inside of generatePolynomialCoefficients because
     //! it must be to handle number_of_batches>1. Effectively, this just calls generatePolynomialCoefficients.
     //! \param number_of_batches    [in] - how many batches to break up the total workload into (for storage)
     //! \param keep_coefficients    [in] - whether to store (P^T W P)^-1 * P^T * W
+    //! \param overlap_batches      [in] - whether to overlap consecutive batches (see generatePolynomialCoefficients)
     */
-    void generateAlphas(const int number_of_batches = 1, const bool keep_coefficients = false);
+    void generateAlphas(const int number_of_batches = 1, const bool keep_coefficients = false, 
+            const bool overlap_batches = false);
 
 ///@}
 
 
 }; // GMLS Class
+
+template <>
+inline double* GMLS::getSolveData<double>(const Kokkos::View<double*>& double_view, 
+        const Kokkos::View<float*>& float_view) const {
+    compadre_assert_debug(!_single_precision_solve 
+            && "Scalar type requested does not match scalar type of the dense solve.");
+    return double_view.data();
+}
+
+template <>
+inline float* GMLS::getSolveData<float>(const Kokkos::View<double*>& double_view, 
+        const Kokkos::View<float*>& float_view) const {
+    compadre_assert_debug(_single_precision_solve 
+            && "Scalar type requested does not match scalar type of the dense solve.");
+    return float_view.data();
+}
+
 } // Compadre
 
 #endif
@@ -4,8 +4,11 @@
 #include "KokkosBatched_ApplyPivot_Decl.hpp"
 #include "KokkosBatched_Gemv_Decl.hpp"
 #include "KokkosBatched_Trsv_Decl.hpp"
-#include "KokkosBatched_UTV_Decl.hpp"
-#include "KokkosBatched_SolveUTV_Decl_Compadre.hpp"
+#if !defined(COMPADRE_USE_CUDA)
+#include "KokkosBatched_Vector.hpp"
+#endif
+
+#include <limits>
 
 using namespace KokkosBatched;
 
@@ -18,43 +21,68 @@ namespace GMLS_LinearAlgebra {
            typename MatrixViewType_B,
            typename MatrixViewType_X>
   struct Functor_TestBatchedTeamVectorSolveUTV {
+    typedef typename MatrixViewType_A::non_const_value_type value_type;
+    typedef Kokkos::View<value_type**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_matrix_right_type;
+    typedef Kokkos::View<value_type**, layout_left, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_matrix_left_type;
+    typedef Kokkos::View<value_type*, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_vector_type;
+
     MatrixViewType_A _a;
     MatrixViewType_B _b;
 
+    // if not empty, only these matrices are solved (one per team)
+    device_managed_local_index_type _matrix_indices;
+
     int _pm_getTeamScratchLevel_0;
     int _pm_getTeamScratchLevel_1;
     int _M, _N, _NRHS;
 
+    // number of householder transformations applied at once (compact WY) by the host kernels
+    int _block_size;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedTeamVectorSolveUTV(
+                      const int M,
+                      const int N,
+                      const int NRHS,
+                      const MatrixViewType_A &a,
+                      const MatrixViewType_B &b,
+                      const int block_size = 1)
+      : _a(a), _b(b), _M(M), _N(N), _NRHS(NRHS), _block_size(block_size) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
+
     KOKKOS_INLINE_FUNCTION
     Functor_TestBatchedTeamVectorSolveUTV(
                       const int M,
                       const int N,
                       const int NRHS,
                       const MatrixViewType_A &a,
-                      const MatrixViewType_B &b)
-      : _a(a), _b(b), _M(M), _N(N), _NRHS(NRHS) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
+                      const MatrixViewType_B &b,
+                      const device_managed_local_index_type &matrix_indices)
+      : _a(a), _b(b), _matrix_indices(matrix_indices), _M(M), _N(N), _NRHS(NRHS), _block_size(1) { _pm_getTeamScratchLevel_0 = 0; _pm_getTeamScratchLevel_1 = 0; }
 
     template<typename MemberType>
     KOKKOS_INLINE_FUNCTION
     void operator()(const MemberType &member) const {
 
-      const int k = member.league_rank();
+      const int k = (_matrix_indices.extent(0) > 0) ? _matrix_indices(member.league_rank()) : member.league_rank();
 
       // workspace vectors
-      scratch_vector_type ww_fast(member.team_scratch(_pm_getTeamScratchLevel_0), 3*_M);
-      scratch_vector_type ww_slow(member.team_scratch(_pm_getTeamScratchLevel_1), _N*_NRHS);
+      value_scratch_vector_type ww_fast(member.team_scratch(_pm_getTeamScratchLevel_0), 3*_M);
+      value_scratch_vector_type ww_slow(member.team_scratch(_pm_getTeamScratchLevel_1), _N*_NRHS);
 
-      scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
+      value_scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
               _a.extent(1), _a.extent(2));
-      scratch_matrix_right_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+      value_scratch_matrix_right_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
               _b.extent(1), _b.extent(2));
-      scratch_matrix_right_type xx(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+      value_scratch_matrix_right_type xx(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
               _b.extent(1), _b.extent(2));
 
       // if sizes don't match extents, then copy to a view with extents matching sizes
       if ((size_t)_M!=_a.extent(1) || (size_t)_N!=_a.extent(2)) {
-        scratch_matrix_right_type tmp(ww_slow.data(), _M, _N);
-        auto aaa = scratch_matrix_right_type(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), _M, _N);
+        value_scratch_matrix_right_type tmp(ww_slow.data(), _M, _N);
+        auto aaa = value_scratch_matrix_right_type(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), _M, _N);
         // copy A to W, then back to A
         Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_M),[&](const int &i) {
           Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_N),[&](const int &j) {
@@ -72,11 +100,11 @@ namespace GMLS_LinearAlgebra {
       }
 
       if (std::is_same<typename MatrixViewType_B::array_layout, layout_left>::value) {
-        scratch_matrix_right_type tmp(ww_slow.data(), _N, _NRHS);
+        value_scratch_matrix_right_type tmp(ww_slow.data(), _N, _NRHS);
         // coming from LU
         // then copy B to W, then back to B
         auto bb_left = 
-            scratch_matrix_left_type(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+            value_scratch_matrix_left_type(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
                     _b.extent(1), _b.extent(2));
         Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
           Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_NRHS),[&](const int &j) {
@@ -91,63 +119,21 @@ namespace GMLS_LinearAlgebra {
         });
       }
 
-      scratch_matrix_right_type uu(member.team_scratch(_pm_getTeamScratchLevel_1), _M, _N /* only N columns of U are filled, maximum */);
-      scratch_matrix_right_type vv(member.team_scratch(_pm_getTeamScratchLevel_1), _N, _N);
+      value_scratch_matrix_right_type uu(member.team_scratch(_pm_getTeamScratchLevel_1), _M, _N /* only N columns of U are filled, maximum */);
+      value_scratch_matrix_right_type vv(member.team_scratch(_pm_getTeamScratchLevel_1), _N, _N);
       scratch_local_index_type pp(member.team_scratch(_pm_getTeamScratchLevel_0), _N);
-
-      bool do_print = false;
-      if (do_print) {
-        Kokkos::single(Kokkos::PerTeam(member), [&] () {
-          //print a
-          printf("a=zeros(%lu,%lu);\n", aa.extent(0), aa.extent(1));
-              for (size_t j=0; j<aa.extent(0); ++j) {
-                  for (size_t k=0; k<aa.extent(1); ++k) {
-                      printf("a(%lu,%lu)= %f;\n", j+1,k+1, aa(j,k));
-                  }
-              }
-          //print b
-          printf("b=zeros(%lu,%lu);\n", bb.extent(0), bb.extent(1));
-              for (size_t j=0; j<bb.extent(0); ++j) {
-                  for (size_t k=0; k<bb.extent(1); ++k) {
-                      printf("b(%lu,%lu)= %f;\n", j+1,k+1, bb(j,k));
-                  }
-              }
-        });
-      }
-      do_print = false;
+      value_scratch_vector_type ww_block(member.team_scratch(_pm_getTeamScratchLevel_1), 
+              (_block_size > 1) ? _block_size*(_block_size + _N) : 0);
 
       /// Solving Ax = b using UTV transformation
       /// A P^T P x = b
       /// UTV P x = b;
-
-      /// UTV = A P^T
-      int matrix_rank(0);
-      member.team_barrier();
-      TeamVectorUTV<MemberType,AlgoTagType>
-        ::invoke(member, aa, pp, uu, vv, ww_fast, matrix_rank);
-      member.team_barrier();
-
-      if (do_print) {
-        Kokkos::single(Kokkos::PerTeam(member), [&] () {
-        printf("matrix_rank: %d\n", matrix_rank);
-        //print u
-        printf("u=zeros(%lu,%lu);\n", uu.extent(0), uu.extent(1));
-        for (size_t j=0; j<uu.extent(0); ++j) {
-            for (size_t k=0; k<uu.extent(1); ++k) {
-                printf("u(%lu,%lu)= %f;\n", j+1,k+1, uu(j,k));
-            }
-        }
-        });
-      }
-      TeamVectorSolveUTVCompadre<MemberType,AlgoTagType>
-        ::invoke(member, matrix_rank, _M, _N, _NRHS, uu, aa, vv, pp, bb, xx, ww_slow, ww_fast);
-      member.team_barrier();
+      teamQRPivotingSolve(member, aa, bb, xx, uu, vv, pp, ww_fast, ww_slow, _M, _N, _NRHS, _block_size, ww_block);
 
     }
 
     inline
     void run(ParallelManager pm) {
-      typedef typename MatrixViewType_A::non_const_value_type value_type;
       std::string name_region("KokkosBatched::Test::TeamVectorSolveUTVCompadre");
       std::string name_value_type = ( std::is_same<value_type,float>::value ? "::Float" :
                                       std::is_same<value_type,double>::value ? "::Double" :
@@ -159,19 +145,170 @@ namespace GMLS_LinearAlgebra {
       _pm_getTeamScratchLevel_0 = pm.getTeamScratchLevel(0);
       _pm_getTeamScratchLevel_1 = pm.getTeamScratchLevel(1);
       
-      int scratch_size = scratch_matrix_right_type::shmem_size(_N, _N); // V
-      scratch_size += scratch_matrix_right_type::shmem_size(_M, _N /* only N columns of U are filled, maximum */); // U
-      scratch_size += scratch_vector_type::shmem_size(_N*_NRHS); // W (for SolveUTV)
+      int scratch_size = value_scratch_matrix_right_type::shmem_size(_N, _N); // V
+      scratch_size += value_scratch_matrix_right_type::shmem_size(_M, _N /* only N columns of U are filled, maximum */); // U
+      scratch_size += value_scratch_vector_type::shmem_size(_N*_NRHS); // W (for SolveUTV)
+      if (_block_size > 1) {
+          scratch_size += value_scratch_vector_type::shmem_size(_block_size*(_block_size + _N)); // T, F, W (for blocked UTV)
+      }
 
-      int l0_scratch_size = scratch_vector_type::shmem_size(_N); // P (temporary)
-      l0_scratch_size += scratch_vector_type::shmem_size(3*_M); // W (for UTV)
+      int l0_scratch_size = value_scratch_vector_type::shmem_size(_N); // P (temporary)
+      l0_scratch_size += value_scratch_vector_type::shmem_size(3*_M); // W (for UTV)
 
       pm.clearScratchSizes();
       pm.setTeamScratchSize(0, l0_scratch_size);
       pm.setTeamScratchSize(1, scratch_size);
 
+      const int num_teams = (_matrix_indices.extent(0) > 0) ? _matrix_indices.extent(0) : _a.extent(0);
+      pm.CallFunctorWithTeamThreadsAndVectors(*this, num_teams);
+      pm.getExecutionSpace().fence();
+
+      Kokkos::Profiling::popRegion();
+    }
+  };
+
+
+
+  template<typename MatrixViewType_A,
+           typename MatrixViewType_B>
+  struct Functor_BatchedTeamVectorSolveCholesky {
+    typedef typename MatrixViewType_A::non_const_value_type value_type;
+    typedef Kokkos::View<value_type**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_matrix_right_type;
+    typedef Kokkos::View<value_type**, layout_left, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_matrix_left_type;
+
+    MatrixViewType_A _a;
+    MatrixViewType_B _b;
+
+    // set to 1 for each matrix whose factorization was abandoned
+    device_managed_local_index_type _needs_fallback;
+
+    int _pm_getTeamScratchLevel_1;
+    int _N, _NRHS;
+    value_type _pivot_tolerance;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_BatchedTeamVectorSolveCholesky(
+                      const int N,
+                      const int NRHS,
+                      const MatrixViewType_A &a,
+                      const MatrixViewType_B &b,
+                      const device_managed_local_index_type &needs_fallback)
+      : _a(a), _b(b), _needs_fallback(needs_fallback), _N(N), _NRHS(NRHS) { 
+        _pm_getTeamScratchLevel_1 = 0; 
+        _pivot_tolerance = std::sqrt(std::numeric_limits<value_type>::epsilon());
+    }
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MemberType &member) const {
+
+      const int k = member.league_rank();
+
+      value_scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
+              _a.extent(1), _a.extent(2));
+      value_scratch_matrix_right_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+              _b.extent(1), _b.extent(2));
+
+      // A is left untouched so that it is still available to a pivoted solve
+      value_scratch_matrix_right_type ll(member.team_scratch(_pm_getTeamScratchLevel_1), _N, _N);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,i+1),[&](const int &j) {
+            ll(i,j) = aa(i,j);
+        });
+      });
+
+      /// Solving Ax = b using Cholesky factorization
+      /// L L^T x = b
+
+      /// A = L L^T (right looking, L overwrites the lower triangle of ll)
+      /// a pivot that is small relative to the diagonal entry of A it came from indicates
+      /// that A is (numerically) rank deficient or not positive definite
+      for (int j=0; j<_N; ++j) {
+        member.team_barrier();
+        const value_type pivot = ll(j,j);
+        if (!(pivot > _pivot_tolerance * aa(j,j))) {
+          Kokkos::single(Kokkos::PerTeam(member), [&] () {
+            _needs_fallback(k) = 1;
+          });
+          // B is left untouched so that it is still available to a pivoted solve
+          return;
+        }
+        const value_type l_jj = std::sqrt(pivot);
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member,j,_N),[&](const int &i) {
+          ll(i,j) = (i==j) ? l_jj : ll(i,j) / l_jj;
+        });
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,j+1,_N),[&](const int &i) {
+          const value_type l_ij = ll(i,j);
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,j+1,i+1),[&](const int &l) {
+            ll(i,l) -= l_ij*ll(l,j);
+          });
+        });
+      }
+      member.team_barrier();
+
+      if (std::is_same<typename MatrixViewType_B::array_layout, layout_left>::value) {
+        value_scratch_matrix_right_type tmp(member.team_scratch(_pm_getTeamScratchLevel_1), _N, _NRHS);
+        // coming from LU
+        // then copy B to W, then back to B
+        auto bb_left = 
+            value_scratch_matrix_left_type(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+                    _b.extent(1), _b.extent(2));
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_NRHS),[&](const int &j) {
+              tmp(i,j) = bb_left(i,j);
+          });
+        });
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,_N),[&](const int &i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,0,_NRHS),[&](const int &j) {
+              bb(i,j) = tmp(i,j);
+          });
+        });
+        member.team_barrier();
+      }
+
+      /// L y = b, then L^T x = y
+      /// (right hand sides are independent, so each is substituted by a single lane)
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member,0,_NRHS),[&](const int &c) {
+        for (int i=0; i<_N; ++i) {
+          value_type sum = bb(i,c);
+          for (int l=0; l<i; ++l) sum -= ll(i,l)*bb(l,c);
+          bb(i,c) = sum / ll(i,i);
+        }
+        for (int i=_N-1; i>=0; --i) {
+          value_type sum = bb(i,c);
+          for (int l=i+1; l<_N; ++l) sum -= ll(l,i)*bb(l,c);
+          bb(i,c) = sum / ll(i,i);
+        }
+      });
+      member.team_barrier();
+
+    }
+
+    inline
+    void run(ParallelManager pm) {
+      std::string name_region("KokkosBatched::TeamVectorSolveCholeskyCompadre");
+      std::string name_value_type = ( std::is_same<value_type,float>::value ? "::Float" :
+                                      std::is_same<value_type,double>::value ? "::Double" : "::UnknownValueType" );
+      std::string name = name_region + name_value_type;
+      Kokkos::Profiling::pushRegion( name.c_str() );
+
+      _pm_getTeamScratchLevel_1 = pm.getTeamScratchLevel(1);
+
+      int scratch_size = value_scratch_matrix_right_type::shmem_size(_N, _N); // L
+      // W (for reordering B from layout_left)
+      scratch_size += (std::is_same<typename MatrixViewType_B::array_layout, layout_left>::value) ?
+          value_scratch_matrix_right_type::shmem_size(_N, _NRHS) : 0;
+
+      pm.clearScratchSizes();
+      pm.setTeamScratchSize(1, scratch_size);
+
       pm.CallFunctorWithTeamThreadsAndVectors(*this, _a.extent(0));
-      Kokkos::fence();
+      pm.getExecutionSpace().fence();
 
       Kokkos::Profiling::popRegion();
     }
@@ -179,33 +316,300 @@ namespace GMLS_LinearAlgebra {
 
 
 
-template <typename A_layout, typename B_layout, typename X_layout>
-void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices) {
+#if !defined(COMPADRE_USE_CUDA)
+  // SIMD packs are sized for the host, so this is only compiled when the device execution space is a host one
+  template<typename MatrixViewType_A,
+           typename MatrixViewType_B>
+  struct Functor_BatchedSIMDPackedSolveCholesky {
+    typedef typename MatrixViewType_A::non_const_value_type value_type;
+    typedef Kokkos::View<value_type**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_matrix_right_type;
+    typedef Kokkos::View<value_type**, layout_left, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            value_scratch_matrix_left_type;
+
+    // one matrix per SIMD lane, interleaved so that each entry of a pack holds the same entry of 
+    // vector_length different matrices
+    enum : int { vector_length = DefaultVectorLength<value_type, Kokkos::HostSpace>::value };
+    typedef Vector<SIMD<value_type>, vector_length> pack_type;
+    typedef Kokkos::View<pack_type**, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            pack_scratch_matrix_type;
+    typedef Kokkos::View<pack_type*, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
+            pack_scratch_vector_type;
+
+    MatrixViewType_A _a;
+    MatrixViewType_B _b;
+
+    // set to 1 for each matrix whose factorization was abandoned
+    device_managed_local_index_type _needs_fallback;
+
+    int _pm_getTeamScratchLevel_1;
+    int _N, _NRHS;
+    value_type _pivot_tolerance;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_BatchedSIMDPackedSolveCholesky(
+                      const int N,
+                      const int NRHS,
+                      const MatrixViewType_A &a,
+                      const MatrixViewType_B &b,
+                      const device_managed_local_index_type &needs_fallback)
+      : _a(a), _b(b), _needs_fallback(needs_fallback), _N(N), _NRHS(NRHS) { 
+        _pm_getTeamScratchLevel_1 = 0; 
+        _pivot_tolerance = std::sqrt(std::numeric_limits<value_type>::epsilon());
+    }
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    pack_type* getAlignedScratch(const MemberType &member, const int num_packs) const {
+        return static_cast<pack_type*>(member.team_scratch(_pm_getTeamScratchLevel_1)
+                .get_shmem_aligned(num_packs*sizeof(pack_type), alignof(pack_type)));
+    }
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MemberType &member) const {
+
+      const int first_matrix = member.league_rank()*vector_length;
+      const int num_lanes = ((size_t)(first_matrix + vector_length) > _a.extent(0)) ? 
+          _a.extent(0) - first_matrix : vector_length;
+
+      pack_scratch_matrix_type ll(getAlignedScratch(member, _N*_N), _N, _N);
+      pack_scratch_matrix_type xx(getAlignedScratch(member, _N*_NRHS), _N, _NRHS);
+      pack_scratch_vector_type dd(getAlignedScratch(member, _N), _N);
+
+      // pack lower triangle of A and B, padding unused lanes with an identity problem
+      bool lane_failed[vector_length];
+      for (int lane=0; lane<vector_length; ++lane) {
+        lane_failed[lane] = false;
+        if (lane < num_lanes) {
+          const int k = first_matrix + lane;
+          value_scratch_matrix_right_type aa(_a.data() + TO_GLOBAL(k)*TO_GLOBAL(_a.extent(1))*TO_GLOBAL(_a.extent(2)), 
+                  _a.extent(1), _a.extent(2));
+          for (int i=0; i<_N; ++i) {
+            for (int j=0; j<=i; ++j) ll(i,j)[lane] = aa(i,j);
+            dd(i)[lane] = aa(i,i);
+          }
+          if (std::is_same<typename MatrixViewType_B::array_layout, layout_left>::value) {
+            value_scratch_matrix_left_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+                    _b.extent(1), _b.extent(2));
+            for (int j=0; j<_NRHS; ++j) {
+              for (int i=0; i<_N; ++i) xx(i,j)[lane] = bb(i,j);
+            }
+          } else {
+            value_scratch_matrix_right_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+                    _b.extent(1), _b.extent(2));
+            for (int i=0; i<_N; ++i) {
+              for (int j=0; j<_NRHS; ++j) xx(i,j)[lane] = bb(i,j);
+            }
+          }
+        } else {
+          for (int i=0; i<_N; ++i) {
+            for (int j=0; j<=i; ++j) ll(i,j)[lane] = (i==j) ? 1 : 0;
+            dd(i)[lane] = 1;
+            for (int j=0; j<_NRHS; ++j) xx(i,j)[lane] = 0;
+          }
+        }
+      }
+
+      /// A = L L^T, for all lanes at once
+      /// a lane whose pivot is rejected (see Functor_BatchedTeamVectorSolveCholesky) continues
+      /// with a unit pivot so that the other lanes are unaffected, and its results are discarded
+      for (int j=0; j<_N; ++j) {
+        pack_type pivot = ll(j,j);
+        for (int lane=0; lane<vector_length; ++lane) {
+          if (!(pivot[lane] > _pivot_tolerance * dd(j)[lane])) {
+            lane_failed[lane] = true;
+            pivot[lane] = 1;
+          }
+        }
+        const pack_type l_jj = sqrt(pivot);
+        const pack_type inverse_l_jj = pack_type(1)/l_jj;
+        ll(j,j) = l_jj;
+        for (int i=j+1; i<_N; ++i) ll(i,j) *= inverse_l_jj;
+        for (int i=j+1; i<_N; ++i) {
+          const pack_type l_ij = ll(i,j);
+          for (int l=j+1; l<=i; ++l) ll(i,l) -= l_ij*ll(l,j);
+        }
+      }
+
+      /// L y = b, then L^T x = y
+      /// (row oriented, so that the innermost loop runs over contiguous right hand sides)
+      for (int i=0; i<_N; ++i) {
+        for (int l=0; l<i; ++l) {
+          const pack_type l_il = ll(i,l);
+          for (int c=0; c<_NRHS; ++c) xx(i,c) -= l_il*xx(l,c);
+        }
+        const pack_type inverse_l_ii = pack_type(1)/ll(i,i);
+        for (int c=0; c<_NRHS; ++c) xx(i,c) *= inverse_l_ii;
+      }
+      for (int i=_N-1; i>=0; --i) {
+        for (int l=i+1; l<_N; ++l) {
+          const pack_type l_li = ll(l,i);
+          for (int c=0; c<_NRHS; ++c) xx(i,c) -= l_li*xx(l,c);
+        }
+        const pack_type inverse_l_ii = pack_type(1)/ll(i,i);
+        for (int c=0; c<_NRHS; ++c) xx(i,c) *= inverse_l_ii;
+      }
+
+      // unpack solutions to B (layout_right), leaving A and B untouched for rejected lanes
+      for (int lane=0; lane<num_lanes; ++lane) {
+        const int k = first_matrix + lane;
+        if (lane_failed[lane]) {
+          _needs_fallback(k) = 1;
+        } else {
+          value_scratch_matrix_right_type bb(_b.data() + TO_GLOBAL(k)*TO_GLOBAL(_b.extent(1))*TO_GLOBAL(_b.extent(2)), 
+                  _b.extent(1), _b.extent(2));
+          for (int i=0; i<_N; ++i) {
+            for (int j=0; j<_NRHS; ++j) bb(i,j) = xx(i,j)[lane];
+          }
+        }
+      }
+
+    }
+
+    inline
+    void run(ParallelManager pm) {
+      std::string name_region("KokkosBatched::SIMDPackedSolveCholeskyCompadre");
+      std::string name_value_type = ( std::is_same<value_type,float>::value ? "::Float" :
+                                      std::is_same<value_type,double>::value ? "::Double" : "::UnknownValueType" );
+      std::string name = name_region + name_value_type;
+      Kokkos::Profiling::pushRegion( name.c_str() );
+
+      _pm_getTeamScratchLevel_1 = pm.getTeamScratchLevel(1);
+
+      // L, X, and diagonal of A, each padded for alignment
+      int scratch_size = (_N*_N + _N*_NRHS + _N + 3) * sizeof(pack_type);
+
+      pm.clearScratchSizes();
+      pm.setTeamScratchSize(1, scratch_size);
+
+      const int num_packs = (_a.extent(0) + vector_length - 1) / vector_length;
+      pm.CallFunctorWithTeamThreadsAndVectors(*this, num_packs, 1, 1);
+      pm.getExecutionSpace().fence();
+
+      Kokkos::Profiling::popRegion();
+    }
+  };
+#endif
+
+
+
+template <typename A_layout, typename B_layout, typename X_layout, typename value_type>
+void batchQRPivotingSolve(ParallelManager pm, value_type *A, int lda, int nda, value_type *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices, const int block_size) {
 
     typedef Algo::UTV::Unblocked algo_tag_type;
-    typedef Kokkos::View<double***, A_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+    typedef Kokkos::View<value_type***, A_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
                     MatrixViewType_A;
-    typedef Kokkos::View<double***, B_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+    typedef Kokkos::View<value_type***, B_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
                     MatrixViewType_B;
-    typedef Kokkos::View<double***, X_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+    typedef Kokkos::View<value_type***, X_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
                     MatrixViewType_X;
 
     MatrixViewType_A mat_A(A, num_matrices, lda, nda);
     MatrixViewType_B mat_B(B, num_matrices, ldb, ndb);
 
     Functor_TestBatchedTeamVectorSolveUTV
-      <device_execution_space, algo_tag_type, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(M,N,NRHS,mat_A,mat_B).run(pm);
+      <device_execution_space, algo_tag_type, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>(M,N,NRHS,mat_A,mat_B,block_size).run(pm);
+
+}
+
+template <typename A_layout, typename B_layout, typename value_type>
+void batchCholeskySolve(ParallelManager pm, value_type *A, int lda, int nda, value_type *B, int ldb, int ndb, int N, int NRHS, const int num_matrices, const bool pack_for_simd) {
+
+    typedef Kokkos::View<value_type***, A_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+                    MatrixViewType_A;
+    typedef Kokkos::View<value_type***, B_layout, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+                    MatrixViewType_B;
+
+    MatrixViewType_A mat_A(A, num_matrices, lda, nda);
+    MatrixViewType_B mat_B(B, num_matrices, ldb, ndb);
+
+    // views are allocated without initialization and filled on this ParallelManager's execution space 
+    // instance, so that batches on other instances are not waited on
+    const device_execution_space space = pm.getExecutionSpace();
+    device_managed_local_index_type needs_fallback(Kokkos::view_alloc(Kokkos::WithoutInitializing, 
+                "matrices needing pivoted solve"), num_matrices);
+    Kokkos::parallel_for("clear matrices needing pivoted solve", 
+            Kokkos::RangePolicy<device_execution_space>(space, 0, num_matrices), KOKKOS_LAMBDA(const int i) {
+        needs_fallback(i) = 0;
+    });
+    if (pack_for_simd) {
+#if !defined(COMPADRE_USE_CUDA)
+        Functor_BatchedSIMDPackedSolveCholesky<MatrixViewType_A, MatrixViewType_B>(N,NRHS,mat_A,mat_B,needs_fallback).run(pm);
+#else
+        compadre_assert_release(false && "Packing problems for SIMD is only available in builds without CUDA.");
+#endif
+    } else {
+        Functor_BatchedTeamVectorSolveCholesky<MatrixViewType_A, MatrixViewType_B>(N,NRHS,mat_A,mat_B,needs_fallback).run(pm);
+    }
+
+    // compact the matrices that could not be factored into a second batch on the device, 
+    // so that only the number of them is copied to the host
+    device_managed_local_index_type fallback_indices(Kokkos::view_alloc(Kokkos::WithoutInitializing, 
+                "indices of matrices needing pivoted solve"), num_matrices);
+    Kokkos::View<int, device_memory_space> device_num_fallback(Kokkos::view_alloc(Kokkos::WithoutInitializing, 
+                "number of matrices needing pivoted solve"));
+    Kokkos::parallel_scan("compact matrices needing pivoted solve", 
+            Kokkos::RangePolicy<device_execution_space>(space, 0, num_matrices), 
+            KOKKOS_LAMBDA(const int i, int& offset, const bool final) {
+        if (needs_fallback(i)) {
+            if (final) fallback_indices(offset) = i;
+            ++offset;
+        }
+        if (final && i == num_matrices-1) device_num_fallback() = offset;
+    });
+    auto host_num_fallback = Kokkos::create_mirror_view(device_num_fallback);
+    Kokkos::deep_copy(space, host_num_fallback, device_num_fallback);
+    space.fence();
+    const int num_fallback = (num_matrices > 0) ? host_num_fallback() : 0;
+
+    if (num_fallback > 0) {
+        typedef Algo::UTV::Unblocked algo_tag_type;
+        typedef Kokkos::View<value_type***, layout_right, Kokkos::MemoryTraits<Kokkos::Unmanaged> >
+                        MatrixViewType_X;
+        fallback_indices = Kokkos::subview(fallback_indices, Kokkos::make_pair(0,num_fallback));
+
+        // only the lower triangle of A is assembled, but the pivoted solve needs all of it
+        Kokkos::parallel_for("fill upper triangle of matrices needing pivoted solve", 
+                Kokkos::RangePolicy<device_execution_space>(space, 0, num_fallback), KOKKOS_LAMBDA(const int i) {
+            const int k = fallback_indices(i);
+            for (int r=0; r<N; ++r) {
+                for (int c=0; c<r; ++c) {
+                    mat_A(k,c,r) = mat_A(k,r,c);
+                }
+            }
+        });
+        Functor_TestBatchedTeamVectorSolveUTV
+          <device_execution_space, algo_tag_type, MatrixViewType_A, MatrixViewType_B, MatrixViewType_X>
+            (N,N,NRHS,mat_A,mat_B,fallback_indices).run(pm);
+    }
 
 }
 
-template void batchQRPivotingSolve<layout_right, layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_right, layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_right, layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_right, layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_right, layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_right, layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_left , layout_right>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
-template void batchQRPivotingSolve<layout_left , layout_left , layout_left >(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int);
+template void batchQRPivotingSolve<layout_right, layout_right, layout_right, double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_right, layout_left , double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_left , layout_right, double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_left , layout_left , double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_right, layout_right, double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_right, layout_left , double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_left , layout_right, double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_left , layout_left , double>(ParallelManager,double*,int,int,double*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_right, layout_right, float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_right, layout_left , float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_left , layout_right, float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_right, layout_left , layout_left , float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_right, layout_right, float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_right, layout_left , float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_left , layout_right, float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchQRPivotingSolve<layout_left , layout_left , layout_left , float>(ParallelManager,float*,int,int,float*,int,int,int,int,int,const int,const int);
+template void batchCholeskySolve<layout_right, layout_right, double>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_right, layout_left , double>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_left , layout_right, double>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_left , layout_left , double>(ParallelManager,double*,int,int,double*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_right, layout_right, float>(ParallelManager,float*,int,int,float*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_right, layout_left , float>(ParallelManager,float*,int,int,float*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_left , layout_right, float>(ParallelManager,float*,int,int,float*,int,int,int,int,const int,const bool);
+template void batchCholeskySolve<layout_left , layout_left , float>(ParallelManager,float*,int,int,float*,int,int,int,int,const int,const bool);
 
 } // GMLS_LinearAlgebra
 } // Compadre
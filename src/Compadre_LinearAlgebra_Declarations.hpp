@@ -18,6 +18,74 @@ namespace GMLS_LinearAlgebra {
     KOKKOS_INLINE_FUNCTION
     void largestTwoEigenvectorsThreeByThreeSymmetric(const member_type& teamMember, scratch_matrix_right_type V, scratch_matrix_right_type PtP, const int dimensions, pool_type& random_number_pool);
 
+    /*! \brief Forms the lower triangle of M = A^T*A (a symmetric rank-k update) from the first num_rows rows of A,
+        and scales each of those rows of A by the square root of its weight, e.g. turning P*sqrt(W) into P*W
+
+        On the host (one thread per team), each row of A is added to M and then scaled while it is in cache, 
+        so A is only read and written once.
+
+        \param teamMember    [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+        \param A         [in/out] - (num_rows or more) * N matrix, rows past num_rows are zero
+        \param M            [out] - N * N matrix, where N is the number of columns of A
+        \param w             [in] - weights, whose square roots scale the rows of A
+        \param num_rows      [in] - number of rows of A that can be nonzero
+        \param fill_upper    [in] - whether to also copy the lower triangle of M to its upper triangle (not 
+                                     needed by batchCholeskySolve)
+    */
+    template <typename matrix_type_A, typename matrix_type_M, typename vector_type_w>
+    KOKKOS_INLINE_FUNCTION
+    void symmetricRankKUpdateAndScaleRows(const member_type& teamMember, matrix_type_A A, matrix_type_M M, vector_type_w w, const int num_rows, const bool fill_upper);
+
+    /*! \brief Solves A*X = B with QR+Pivoting (UTV) for a single problem, using the threads and vector lanes of a team
+
+        This is the solve performed by each team in batchQRPivotingSolve, for kernels that keep A, B, and the 
+        workspace in scratch memory. B has the same form as in batchQRPivotingSolve, so for M>N only its first 
+        NRHS entries (the diagonal of a diagonal matrix) are read.
+
+        \param teamMember    [in] - Kokkos::TeamPolicy member type (created by parallel_for)
+        \param A         [in/out] - M * N matrix A (in), meaningless workspace output (out)
+        \param B         [in/out] - right hand sides (in), meaningless workspace output if X shares its memory (out)
+        \param X            [out] - N * NRHS solution, which may share memory with B
+        \param U            [out] - M * N workspace
+        \param V            [out] - N * N workspace
+        \param p            [out] - N workspace for pivots
+        \param w_fast       [out] - 3*M workspace
+        \param w_slow       [out] - N * NRHS workspace
+        \param M             [in] - number of rows containing data in A
+        \param N             [in] - number of columns containing data in A
+        \param NRHS          [in] - number of columns containing data in B
+        \param block_size    [in] - number of householder transformations accumulated (compact WY) by the host kernels
+        \param w_block      [out] - block_size * (block_size + N) workspace (empty for block_size of 1)
+    */
+    template <typename matrix_type_A, typename matrix_type_B, typename matrix_type_X, typename matrix_type_U, 
+              typename matrix_type_V, typename index_vector_type, typename vector_type>
+    KOKKOS_INLINE_FUNCTION
+    void teamQRPivotingSolve(const member_type& teamMember, matrix_type_A A, matrix_type_B B, matrix_type_X X, 
+            matrix_type_U U, matrix_type_V V, index_vector_type p, vector_type w_fast, vector_type w_slow, 
+            const int M, const int N, const int NRHS, const int block_size, vector_type w_block);
+
+    /*! \brief Solves A*X = diag(B) with QR+Pivoting (UTV) for a single problem, using a single thread
+
+        Produces the same solution as teamQRPivotingSolve for M>N, but takes no team member, so that each thread 
+        (or vector lane) of a team may solve a problem of its own. All matrices are row major.
+
+        \param A         [in/out] - M * N matrix A (in), meaningless workspace output (out)
+        \param B             [in] - M entries of the diagonal of the right hand side
+        \param X            [out] - N * M solution
+        \param U            [out] - M * N workspace
+        \param V            [out] - N * N workspace
+        \param p            [out] - N workspace for pivots
+        \param w_fast       [out] - 3*M workspace
+        \param w_slow       [out] - N * M workspace
+        \param M             [in] - number of rows containing data in A
+        \param N             [in] - number of columns containing data in A
+    */
+    template <typename matrix_type_A, typename vector_type_B, typename matrix_type_X, typename matrix_type_U, 
+              typename matrix_type_V, typename index_vector_type, typename vector_type>
+    KOKKOS_INLINE_FUNCTION
+    void serialQRPivotingSolve(matrix_type_A A, vector_type_B B, matrix_type_X X, matrix_type_U U, matrix_type_V V, 
+            index_vector_type p, vector_type w_fast, vector_type w_slow, const int M, const int N);
+
     /*! \brief Solves a batch of problems with QR+Pivoting
  
          ~ Note: Very strong assumption on B. ~
@@ -42,9 +110,58 @@ namespace GMLS_LinearAlgebra {
         \param N                    [in] - number of columns containing data in each matrix in A
         \param NRHS                 [in] - number of columns containing data in each matrix in B
         \param num_matrices         [in] - number of problems
+        \param block_size           [in] - number of householder transformations accumulated (compact WY) before 
+                                           updating the trailing matrix, 1 for the unblocked algorithm
+
+        The scalar type of A and B (double or float) is deduced, and the solve is performed in that precision.
+
+        The blocked algorithm is only used by the host kernels (a single thread per team on the host), and 
+        block_size is ignored otherwise.
+    */
+    template <typename A_layout=layout_right, typename B_layout=layout_right, typename X_layout=layout_right, typename value_type=double>
+    void batchQRPivotingSolve(ParallelManager pm, value_type *A, int lda, int nda, value_type *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices, const int block_size = 1);
+
+    /*! \brief Block size for batchQRPivotingSolve on (M x N) problems
+
+        Small problems fit in cache and are fastest unblocked, so this is 1 unless both M and N are large.
+    */
+    inline int getQRPivotingBlockSize(const int M, const int N) {
+        return (M >= 80 && N >= 20) ? 8 : 1;
+    }
+
+    /*! \brief Solves a batch of symmetric problems with Cholesky factorization, falling back to pivoted UTV
+         for any problem that is not numerically positive definite
+
+         A contains num_matrices * lda * nda data which is num_matrices different (lda x nda) matrices with valid 
+         entries of size (N x N), which are expected to be symmetric positive definite (e.g. P^T*W*P). B contains 
+         num_matrices * ldb * ndb data which is num_matrices different (ldb x ndb) right hand sides with valid 
+         entries of size (N x NRHS). The solution is stored in B as a layout_right (ldb x ndb) matrix, as is done 
+         by batchQRPivotingSolve.
+
+         Every matrix is first factored without pivoting, which requires roughly N^3/3 flops. A matrix whose 
+         factorization produces a pivot smaller than sqrt(machine epsilon) times the corresponding diagonal entry 
+         of A (rank deficient, ill-conditioned, or indefinite) is flagged, and only the flagged matrices are 
+         re-solved in a compacted second batch by the same pivoted UTV solver used in batchQRPivotingSolve.
+
+         Only the lower triangle of each matrix in A is read by the factorization (see 
+         symmetricRankKUpdateAndScaleRows), and the upper triangle of a flagged matrix is filled from its lower 
+         triangle before it is re-solved.
+
+        \param pm                   [in] - manager class for team and thread parallelism
+        \param A                    [in] - matrix A (unmodified, except by the pivoted UTV fallback)
+        \param lda                  [in] - row dimension of each matrix in A
+        \param nda                  [in] - columns dimension of each matrix in A
+        \param B                [in/out] - right hand sides (in), solution (out)
+        \param ldb                  [in] - row dimension of each matrix in B
+        \param ndb                  [in] - column dimension of each matrix in B
+        \param N                    [in] - number of rows and columns containing data in each matrix in A
+        \param NRHS                 [in] - number of columns containing data in each matrix in B
+        \param num_matrices         [in] - number of problems
+        \param pack_for_simd        [in] - factor and solve groups of problems together, one per SIMD lane, by 
+                                            interleaving them in a compact layout (builds without CUDA only)
     */
-    template <typename A_layout=layout_right, typename B_layout=layout_right, typename X_layout=layout_right>
-    void batchQRPivotingSolve(ParallelManager pm, double *A, int lda, int nda, double *B, int ldb, int ndb, int M, int N, int NRHS, const int num_matrices);
+    template <typename A_layout=layout_right, typename B_layout=layout_right, typename value_type=double>
+    void batchCholeskySolve(ParallelManager pm, value_type *A, int lda, int nda, value_type *B, int ldb, int ndb, int N, int NRHS, const int num_matrices, const bool pack_for_simd = false);
 
 } // GMLS_LinearAlgebra
 } // Compadre
@@ -3,6 +3,11 @@
 
 #include "Compadre_LinearAlgebra_Declarations.hpp"
 
+#include "KokkosBatched_UTV_Decl.hpp"
+#include "KokkosBatched_SolveUTV_Decl_Compadre.hpp"
+#include "KokkosBatched_UTV_Host_Internal_Compadre.hpp"
+#include "KokkosBatched_UTV_Serial_Internal_Compadre.hpp"
+
 namespace Compadre {
 namespace GMLS_LinearAlgebra {
 
@@ -145,6 +150,152 @@ void largestTwoEigenvectorsThreeByThreeSymmetric(const member_type& teamMember,
 
 }
 
+template <typename matrix_type_A, typename matrix_type_M, typename vector_type_w>
+KOKKOS_INLINE_FUNCTION
+void symmetricRankKUpdateAndScaleRows(const member_type& teamMember, matrix_type_A A, matrix_type_M M, vector_type_w w, const int num_rows, const bool fill_upper) {
+
+    typedef typename matrix_type_A::non_const_value_type value_type;
+    const int num_cols = A.extent(1);
+
+    // a team with a single thread on the host adds each row of A to M and scales it in the same pass, 
+    // while otherwise each entry of the lower triangle is reduced over the rows of A by one lane, 
+    // so rows of A can only be scaled once every lane is done reading them
+    const bool use_fused_rows = 
+        std::is_same<member_type::execution_space, Kokkos::DefaultHostExecutionSpace>::value
+        && teamMember.team_size()==1;
+
+    if (!use_fused_rows) {
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_cols), [&] (const int i) {
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, i+1), [&] (const int j) {
+                value_type m_ij = 0;
+                for (int r=0; r<num_rows; ++r) {
+                    m_ij += A(r,i)*A(r,j);
+                }
+                M(i,j) = m_ij;
+                if (fill_upper) M(j,i) = m_ij;
+            });
+        });
+        teamMember.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_rows), [&] (const int r) {
+            const value_type sqrt_w = std::sqrt(w(r));
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, num_cols), [&] (const int j) {
+                A(r,j) *= sqrt_w;
+            });
+        });
+    } else {
+        Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
+            for (int i=0; i<num_cols; ++i) {
+                for (int j=0; j<=i; ++j) {
+                    M(i,j) = 0;
+                }
+            }
+            for (int r=0; r<num_rows; ++r) {
+                for (int i=0; i<num_cols; ++i) {
+                    const value_type a_ri = A(r,i);
+                    for (int j=0; j<=i; ++j) {
+                        M(i,j) += a_ri*A(r,j);
+                    }
+                }
+                const value_type sqrt_w = std::sqrt(w(r));
+                for (int j=0; j<num_cols; ++j) {
+                    A(r,j) *= sqrt_w;
+                }
+            }
+            if (fill_upper) {
+                for (int i=0; i<num_cols; ++i) {
+                    for (int j=0; j<i; ++j) {
+                        M(j,i) = M(i,j);
+                    }
+                }
+            }
+        });
+    }
+    teamMember.team_barrier();
+
+}
+
+template <typename matrix_type_A, typename matrix_type_B, typename matrix_type_X, typename matrix_type_U, 
+          typename matrix_type_V, typename index_vector_type, typename vector_type>
+KOKKOS_INLINE_FUNCTION
+void teamQRPivotingSolve(const member_type& teamMember, matrix_type_A A, matrix_type_B B, matrix_type_X X, 
+        matrix_type_U U, matrix_type_V V, index_vector_type p, vector_type w_fast, vector_type w_slow, 
+        const int M, const int N, const int NRHS, const int block_size, vector_type w_block) {
+
+    typedef KokkosBatched::Algo::UTV::Unblocked algo_tag_type;
+
+    // a team with a single thread on the host runs the TeamVector kernels as scalar loops, 
+    // so use the forks that are ordered for vectorization instead
+    const bool use_host_kernels = 
+        std::is_same<member_type::execution_space, Kokkos::DefaultHostExecutionSpace>::value
+        && teamMember.team_size()==1 && A.stride(1)==1 && B.stride(1)==1;
+
+    /// UTV = A P^T
+    int matrix_rank(0);
+    teamMember.team_barrier();
+    if (use_host_kernels) {
+        matrix_rank = -1;
+        KokkosBatched::HostUTV_Internal_Compadre
+          ::invoke(teamMember, A.extent(0), A.extent(1), 
+                   A.data(), A.stride(0), A.stride(1),
+                   p.data(), p.stride(0),
+                   U.data(), U.stride(0), U.stride(1),
+                   V.data(), V.stride(0), V.stride(1),
+                   w_fast.data(), matrix_rank,
+                   block_size, w_block.data());
+    } else {
+        KokkosBatched::TeamVectorUTV<member_type,algo_tag_type>
+          ::invoke(teamMember, A, p, U, V, w_fast, matrix_rank);
+    }
+    teamMember.team_barrier();
+
+    /// UTV P x = b
+    if (use_host_kernels) {
+        KokkosBatched::HostSolveUTV_Internal_Compadre
+          ::invoke(teamMember, matrix_rank, M, N, NRHS,
+                   U.data(), U.stride(0), U.stride(1),
+                   A.data(), A.stride(0), A.stride(1),
+                   V.data(), V.stride(0), V.stride(1),
+                   p.data(), p.stride(0),
+                   B.data(), B.stride(0), B.stride(1),
+                   X.data(), X.stride(0), X.stride(1),
+                   w_slow.data(), w_fast.data());
+    } else {
+        KokkosBatched::TeamVectorSolveUTVCompadre<member_type,algo_tag_type>
+          ::invoke(teamMember, matrix_rank, M, N, NRHS, U, A, V, p, B, X, w_slow, w_fast);
+    }
+    teamMember.team_barrier();
+
+}
+
+template <typename matrix_type_A, typename vector_type_B, typename matrix_type_X, typename matrix_type_U, 
+          typename matrix_type_V, typename index_vector_type, typename vector_type>
+KOKKOS_INLINE_FUNCTION
+void serialQRPivotingSolve(matrix_type_A A, vector_type_B B, matrix_type_X X, matrix_type_U U, matrix_type_V V, 
+        index_vector_type p, vector_type w_fast, vector_type w_slow, const int M, const int N) {
+
+    /// UTV = A P^T
+    int matrix_rank(0);
+    KokkosBatched::SerialUTV_Internal_Compadre
+      ::invoke(M, N, 
+               A.data(), A.stride(0), A.stride(1),
+               p.data(), p.stride(0),
+               U.data(), U.stride(0),
+               V.data(), V.stride(0), V.stride(1),
+               w_fast.data(), matrix_rank);
+
+    /// UTV P x = diag(b)
+    KokkosBatched::SerialSolveUTV_Internal_Compadre
+      ::invoke(matrix_rank, M, N,
+               U.data(), U.stride(0),
+               A.data(), A.stride(0),
+               V.data(), V.stride(0), V.stride(1),
+               p.data(), p.stride(0),
+               B.data(),
+               X.data(), X.stride(0),
+               w_slow.data());
+
+}
+
 } // GMLS_LinearAlgebra
 } // Compadre
 
@@ -125,6 +125,12 @@ XYZ operator / ( const XYZ& vecA, const scalar_type& constant ) {
 inline std::ostream& operator << ( std::ostream& os, const XYZ& vec ) {
     os << "(" << vec.x << ", " << vec.y << ", " << vec.z << ")" ; return os; }
 
+//! Whether the dense solver solves the normal equations P^T*W*P rather than P*sqrt(w) against sqrt(w)
+KOKKOS_INLINE_FUNCTION
+bool solvesNormalEquations(DenseSolverType dense_solver_type) {
+    return (dense_solver_type == LU || dense_solver_type == CHOLESKY);
+}
+
 KOKKOS_INLINE_FUNCTION
 int getAdditionalAlphaSizeFromConstraint(DenseSolverType dense_solver_type, ConstraintType constraint_type) {
     // Return the additional constraint size
@@ -148,7 +154,7 @@ int getAdditionalCoeffSizeFromConstraintAndSpace(DenseSolverType dense_solver_ty
 
 KOKKOS_INLINE_FUNCTION
 void getRHSDims(DenseSolverType dense_solver_type, ConstraintType constraint_type, ReconstructionSpace reconstruction_space, const int dimension, const int M, const int N, int &RHS_row, int &RHS_col) {
-    // Return the appropriate size for _RHS. Since in LU, the system solves P^T*P against P^T*W.
+    // Return the appropriate size for _RHS. Since in LU (or Cholesky), the system solves P^T*P against P^T*W.
     // We store P^T*P in the RHS space, which means RHS can be much smaller compared to the
     // case for QR/SVD where the system solves PsqrtW against sqrtW*Identity
 
@@ -157,7 +163,7 @@ void getRHSDims(DenseSolverType dense_solver_type, ConstraintType constraint_typ
     if (constraint_type == NEUMANN_GRAD_SCALAR) {
         RHS_row = RHS_col = N + added_coeff_size;
     } else {
-        if (dense_solver_type != LU) {
+        if (!solvesNormalEquations(dense_solver_type)) {
             RHS_row = N;
             RHS_col = M;
         } else {
@@ -179,7 +185,7 @@ void getPDims(DenseSolverType dense_solver_type, ConstraintType constraint_type,
         out_row = M + added_alpha_size;
         out_col = N + added_coeff_size;
     } else {
-        if (dense_solver_type == LU) {
+        if (solvesNormalEquations(dense_solver_type)) {
             out_row = M + added_alpha_size;
             out_col = N + added_coeff_size;
         } else {
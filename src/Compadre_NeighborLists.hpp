@@ -209,6 +209,11 @@ struct NeighborLists {
         return _cr_neighbor_lists;
     }
 
+    //! Device view into number of neighbors list (use with caution)
+    view_type getNumberOfNeighborsList() {
+        return _number_of_neighbors_list;
+    }
+
 ///@}
 /** @name Public accessors
  */
@@ -185,6 +185,9 @@ namespace Compadre {
         QR, 
         //! LU factorization performed on P^T*W*P matrix
         LU, 
+        //! Cholesky factorization performed on P^T*W*P matrix, with problems that are not numerically
+        //! positive definite re-solved by QR+Pivoting on P^T*W*P (not available with constraints)
+        CHOLESKY, 
     };
 
     //! Problem type, that optionally can handle manifolds
@@ -41,6 +41,9 @@ public:
     int _default_threads;
     int _default_vector_lanes;
 
+    //! execution space instance that team policies and functor calls are launched on
+    device_execution_space _space;
+
 
 /** @name Private Modifiers
  *  Private function because information lives on the device
@@ -120,104 +123,104 @@ public:
         if (threads_per_team>0 && vector_lanes_per_thread>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else {
                 // scratch team levels and thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             }
         } else if (threads_per_team>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else {
                 // scratch team levels and thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, threads_per_team, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             }
         } else if (vector_lanes_per_thread>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else {
                 // scratch team levels and thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, vector_lanes_per_thread)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             }
         } else {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b));
             } else {
                 // scratch team levels and thread levels are the same
-                return Kokkos::TeamPolicy<device_execution_space>(batch_size, _default_threads, _default_vector_lanes)
+                return Kokkos::TeamPolicy<device_execution_space>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b));
             }
@@ -234,7 +237,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -243,7 +246,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -251,7 +254,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -259,7 +262,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -268,7 +271,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -277,7 +280,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -285,7 +288,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -293,7 +296,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -302,7 +305,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -311,7 +314,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -319,7 +322,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -327,7 +330,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -336,7 +339,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                     // all levels of each type need specified separately
                     Kokkos::parallel_for(
-                        Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                        Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                         .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                         .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                         .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -345,7 +348,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -353,7 +356,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -361,7 +364,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<Tag>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<Tag>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, typeid(Tag).name());
@@ -379,7 +382,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -388,7 +391,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -396,7 +399,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -404,7 +407,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -413,7 +416,7 @@ public:
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 // all levels of each type need specified separately
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -422,7 +425,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -430,7 +433,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -438,7 +441,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, threads_per_team, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, threads_per_team, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -446,7 +449,7 @@ public:
         } else if (vector_lanes_per_thread>0) {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -455,7 +458,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -463,7 +466,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -471,7 +474,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, vector_lanes_per_thread)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, vector_lanes_per_thread)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -479,7 +482,7 @@ public:
         } else {
             if ( (_scratch_team_level_a != _scratch_team_level_b) && (_scratch_thread_level_a != _scratch_thread_level_b) ) {
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
@@ -488,7 +491,7 @@ public:
             } else if (_scratch_team_level_a != _scratch_team_level_b) {
                 // scratch thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a))
                     .set_scratch_size(_scratch_team_level_b, Kokkos::PerTeam(_team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
@@ -496,7 +499,7 @@ public:
             } else if (_scratch_thread_level_a != _scratch_thread_level_b) {
                 // scratch team levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a))
                     .set_scratch_size(_scratch_thread_level_b, Kokkos::PerThread(_thread_scratch_size_b)),
@@ -504,7 +507,7 @@ public:
             } else {
                 // scratch team levels and thread levels are the same
                 Kokkos::parallel_for(
-                    Kokkos::TeamPolicy<>(batch_size, _default_threads, _default_vector_lanes)
+                    Kokkos::TeamPolicy<>(_space, batch_size, _default_threads, _default_vector_lanes)
                     .set_scratch_size(_scratch_team_level_a, Kokkos::PerTeam(_team_scratch_size_a + _team_scratch_size_b))
                     .set_scratch_size(_scratch_thread_level_a, Kokkos::PerThread(_thread_scratch_size_a + _thread_scratch_size_b)),
                     functor, functor_name);
@@ -528,6 +531,11 @@ public:
         CallFunctorWithTeamThreadsAndVectors<C>(functor, batch_size, _default_threads, 1, functor_name);
     }
 
+    //! Execution space instance that team policies and functor calls are launched on
+    device_execution_space getExecutionSpace() const {
+        return _space;
+    }
+
     KOKKOS_INLINE_FUNCTION
     int getTeamScratchLevel(const int level) const {
         if (level == 0) {
@@ -564,6 +572,14 @@ public:
         }
     }
 
+    //! Whether team_scratch_size bytes for each team, and thread_scratch_size bytes for each of its 
+    //! threads_per_team threads, fit together in the fastest level of scratch memory (level 0)
+    bool fitsInFastestScratch(const int team_scratch_size, const int thread_scratch_size, 
+            const int threads_per_team) const {
+        return team_scratch_size + threads_per_team*thread_scratch_size 
+            <= Kokkos::TeamPolicy<device_execution_space>::scratch_size_max(0);
+    }
+
 ///@}
 
 
@@ -604,6 +620,12 @@ public:
         }
     }
 
+    //! Sets the execution space instance that team policies and functor calls are launched on
+    //! (e.g. so that independent work can be overlapped on separate instances)
+    void setExecutionSpace(const device_execution_space& space) {
+        _space = space;
+    }
+
     void clearScratchSizes() {
         _team_scratch_size_a = 0;
         _team_scratch_size_b = 0;
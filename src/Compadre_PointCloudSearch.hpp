@@ -3,9 +3,13 @@
 
 #include "Compadre_Typedefs.hpp"
 #include "Compadre_NeighborLists.hpp"
+#include "Compadre_SpaceFillingCurve.hpp"
 #include "nanoflann.hpp"
 #include <Kokkos_Core.hpp>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <limits>
 
 namespace Compadre {
 
@@ -121,6 +125,181 @@ class RadiusResultSet {
     }
 };
 
+//! Result set for nanoflann that finds the k nearest neighbors and, in the same traversal, keeps every
+//! site that may lie within epsilon_multiplier times the distance to the kth nearest neighbor
+/*!
+*  The search radius reported to nanoflann shrinks as nearer sites are found, so the traversal visits
+*  only what a radius search with the final window size would visit. Storage grows as needed and is
+*  reused from one search to the next, so one result set should be kept per thread.
+*/
+template <typename _DistanceType, typename _IndexType = size_t>
+class KNNRadiusResultSet {
+
+  public:
+
+    typedef _DistanceType DistanceType;
+    typedef _IndexType IndexType;
+
+  protected:
+
+    IndexType _k;
+    DistanceType _epsilon_multiplier;
+    //! squared distance beyond which a site can not be within the final window
+    DistanceType _radius;
+    //! squared distances to the nearest sites found, as a max heap of size at most _k
+    std::vector<DistanceType> _knn_distances;
+    //! sites within _radius at the time they were found, in the order found
+    std::vector<std::pair<IndexType, DistanceType> > _candidates;
+
+    //! Window size for a kth nearest neighbor at squared distance kth_distance,
+    //! matching generateCRNeighborListsFromKNNSearch's follow on radius search
+    DistanceType getEpsilon(const DistanceType kth_distance) const {
+        return (kth_distance > 0) ? std::sqrt(kth_distance)*_epsilon_multiplier : 1e-14*_epsilon_multiplier;
+    }
+
+    void updateRadius() {
+        // epsilon is not monotone in the kth distance when it reaches 0, so the smallest window is
+        // a lower bound on the radius
+        const DistanceType epsilon = getEpsilon(_knn_distances.front());
+        const DistanceType min_epsilon = getEpsilon(0);
+        _radius = (epsilon > min_epsilon) ? epsilon*epsilon : min_epsilon*min_epsilon;
+    }
+
+  public:
+
+    KNNRadiusResultSet() : _k(0), _epsilon_multiplier(1), _radius(std::numeric_limits<DistanceType>::max()) {}
+
+    //! Clears results before a search for k nearest neighbors
+    void init(const IndexType k, const DistanceType epsilon_multiplier) {
+        _k = k;
+        _epsilon_multiplier = epsilon_multiplier;
+        _radius = std::numeric_limits<DistanceType>::max();
+        _knn_distances.clear();
+        _candidates.clear();
+    }
+
+    //! Number of nearest neighbors found (at most k)
+    size_t size() const { return _knn_distances.size(); }
+
+    bool full() const { return true; }
+
+    bool addPoint(DistanceType dist, IndexType index) {
+        if (dist >= _radius) return true;
+        if (_knn_distances.size() < _k) {
+            _knn_distances.push_back(dist);
+            std::push_heap(_knn_distances.begin(), _knn_distances.end());
+            if (_knn_distances.size() == _k) updateRadius();
+        } else if (_k > 0 && dist < _knn_distances.front()) {
+            std::pop_heap(_knn_distances.begin(), _knn_distances.end());
+            _knn_distances.back() = dist;
+            std::push_heap(_knn_distances.begin(), _knn_distances.end());
+            updateRadius();
+        }
+        if (dist < _radius) {
+            if (_candidates.size() == _candidates.capacity()) {
+                // before growing, drop candidates that the shrinking radius has ruled out
+                size_t num_kept = 0;
+                for (size_t j=0; j<_candidates.size(); ++j) {
+                    if (_candidates[j].second < _radius) _candidates[num_kept++] = _candidates[j];
+                }
+                _candidates.resize(num_kept);
+                // grow geometrically unless compaction freed most of the storage
+                if (2*num_kept > _candidates.capacity()) _candidates.reserve(2*_candidates.capacity() + 16);
+            }
+            _candidates.push_back(std::make_pair(index, dist));
+        }
+        return true;
+    }
+
+    DistanceType worstDist() const { return _radius; }
+
+    /*! \brief Keeps only sites within the final window, in the order they were found except that
+        the closest neighbor is put first (as in RadiusResultSet::sort), and returns the window size.
+    */
+    DistanceType finalize() {
+        const DistanceType epsilon = getEpsilon((_knn_distances.size() > 0) ? _knn_distances.front() : 0);
+        // same comparison as a radius search with epsilon
+        const DistanceType radius = epsilon*epsilon;
+        size_t num_kept = 0;
+        size_t best_index = 0;
+        for (size_t j=0; j<_candidates.size(); ++j) {
+            if (_candidates[j].second < radius) {
+                if (_candidates[j].second < _candidates[best_index].second || num_kept==0) best_index = num_kept;
+                _candidates[num_kept++] = _candidates[j];
+            }
+        }
+        _candidates.resize(num_kept);
+        if (best_index != 0) std::swap(_candidates[0], _candidates[best_index]);
+        return epsilon;
+    }
+
+    //! Number of neighbors within the window, after finalize()
+    size_t getNumberOfNeighbors() const { return _candidates.size(); }
+
+    //! Index of the jth neighbor within the window, after finalize()
+    IndexType getNeighbor(const size_t j) const { return _candidates[j].first; }
+};
+
+
+//! Neighbor lists that threads append to their own growable storage, one target site at a time,
+//! before they are compacted into compressed row NeighborLists
+struct ThreadNeighborChunks {
+
+    //! neighbors appended by each thread
+    std::vector<std::vector<int> > _chunks;
+    //! thread whose chunk holds each target site's neighbors
+    Kokkos::View<int*, host_memory_space> _chunk_of_target;
+    //! position of each target site's first neighbor in its chunk
+    Kokkos::View<size_t*, host_memory_space> _offset_in_chunk;
+    Kokkos::View<int*, host_memory_space> _number_of_neighbors_list;
+
+    ThreadNeighborChunks(const int num_threads, const int num_target_sites) 
+            : _chunks(num_threads),
+              _chunk_of_target("chunk of target", num_target_sites),
+              _offset_in_chunk("offset in chunk", num_target_sites),
+              _number_of_neighbors_list("number of neighbors list", num_target_sites) {}
+
+    void startRow(const int target_index, const int thread) {
+        _chunk_of_target(target_index) = thread;
+        _offset_in_chunk(target_index) = _chunks[thread].size();
+    }
+
+    void append(const int thread, const int neighbor_index) {
+        _chunks[thread].push_back(neighbor_index);
+    }
+
+    void endRow(const int target_index, const int thread) {
+        _number_of_neighbors_list(target_index) = _chunks[thread].size() - _offset_in_chunk(target_index);
+    }
+
+    //! Scans the number of neighbors for row offsets and copies each row out of its chunk
+    template <typename view_type>
+    NeighborLists<view_type> compact() {
+        compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename view_type::memory_space>::accessible==1)
+                && "NeighborLists returned from a neighbor search on the host must be accessible from the host.");
+        const int num_target_sites = _number_of_neighbors_list.extent(0);
+        view_type number_of_neighbors_list("number of neighbors list", num_target_sites);
+        Kokkos::deep_copy(number_of_neighbors_list, _number_of_neighbors_list);
+
+        // allocates compressed row storage after a parallel scan for the row offsets
+        NeighborLists<view_type> nla(number_of_neighbors_list);
+        auto cr_neighbor_lists = nla.getNeighborLists();
+        const std::vector<int>* chunks = _chunks.data();
+        auto chunk_of_target = _chunk_of_target;
+        auto offset_in_chunk = _offset_in_chunk;
+        Kokkos::parallel_for("compact neighbor lists", Kokkos::RangePolicy<host_execution_space>(0, num_target_sites), 
+                [&](const int i) {
+            const int* row = chunks[chunk_of_target(i)].data() + offset_in_chunk(i);
+            for (int j=0; j<nla.getNumberOfNeighborsHost(i); ++j) {
+                cr_neighbor_lists(nla.getRowOffsetHost(i)+j) = row[j];
+            }
+        });
+        Kokkos::fence();
+        nla.copyDeviceDataToHost();
+        return nla;
+    }
+};
+
 
 //!  PointCloudSearch generates neighbor lists and window sizes for each target site
 /*!
@@ -138,6 +317,17 @@ class RadiusResultSet {
 *    If a 2D view for `neighbors_list` is used, then \f$ N(i,j+1) \f$ will store the \f$ j^{th} \f$ neighbor of \f$ i \f$,
 *    and \f$ N(i,0) \f$ will store the number of neighbors for target \f$ i \f$.
 *
+*  #### Without a dry-run:
+*
+*    Compressed row searches also have overloads taking no neighbor list views, which search each target
+*    site once and return an owning NeighborLists.
+*
+*  #### Ordering source sites:
+*
+*    If order_sources_along_curve is set at construction, the kd-tree is built over a copy of the source
+*    sites in Morton order, so source sites near each other in space are near each other in memory during
+*    a search. Neighbor indices are mapped back, so all neighbor lists index source sites as given.
+*
 */
 template <typename view_type>
 class PointCloudSearch {
@@ -158,6 +348,13 @@ class PointCloudSearch {
         local_index_type _dim;
         local_index_type _max_leaf;
 
+        //! whether the kd-tree is built over a copy of the source sites in Morton order
+        bool _order_sources_along_curve;
+        //! source site coordinates in Morton order (only if _order_sources_along_curve)
+        Kokkos::View<double**, host_memory_space> _ordered_src_pts_view;
+        //! source site index, as given, of each source site in _ordered_src_pts_view
+        std::vector<int> _src_curve_order;
+
         std::shared_ptr<tree_type_1d> _tree_1d;
         std::shared_ptr<tree_type_2d> _tree_2d;
         std::shared_ptr<tree_type_3d> _tree_3d;
@@ -165,10 +362,11 @@ class PointCloudSearch {
     public:
 
         PointCloudSearch(view_type src_pts_view, const local_index_type dimension = -1,
-                const local_index_type max_leaf = -1) 
+                const local_index_type max_leaf = -1, const bool order_sources_along_curve = false) 
                 : _src_pts_view(src_pts_view), 
                   _dim((dimension < 0) ? src_pts_view.extent(1) : dimension),
-                  _max_leaf((max_leaf < 0) ? 10 : max_leaf) {
+                  _max_leaf((max_leaf < 0) ? 10 : max_leaf),
+                  _order_sources_along_curve(order_sources_along_curve) {
             compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename view_type::memory_space>::accessible==1)
                     && "Views passed to PointCloudSearch at construction should be accessible from the host.");
         };
@@ -191,20 +389,38 @@ class PointCloudSearch {
         inline int kdtree_get_point_count() const {return _src_pts_view.extent(0);}
 
         //! Returns the coordinate value of a point
-        inline double kdtree_get_pt(const int idx, int dim) const {return _src_pts_view(idx,dim);}
+        inline double kdtree_get_pt(const int idx, int dim) const {
+            return (_order_sources_along_curve) ? _ordered_src_pts_view(idx,dim) : _src_pts_view(idx,dim);
+        }
 
         //! Returns the distance between a point and a source site, given its index
         inline double kdtree_distance(const double* queryPt, const int idx, long long sz) const {
 
             double distance = 0;
             for (int i=0; i<_dim; ++i) {
-                distance += (_src_pts_view(idx,i)-queryPt[i])*(_src_pts_view(idx,i)-queryPt[i]);
+                const double diff = this->kdtree_get_pt(idx,i)-queryPt[i];
+                distance += diff*diff;
             }
             return std::sqrt(distance);
 
         }
 
+        //! Maps a source site index from the kd-tree to the source site index as given
+        inline int getSourceIndex(const int idx) const {
+            return (_order_sources_along_curve) ? _src_curve_order[idx] : idx;
+        }
+
         void generateKDTree() {
+            if (_order_sources_along_curve) {
+                _src_curve_order = getMortonOrder(_src_pts_view, _dim);
+                _ordered_src_pts_view = Kokkos::View<double**, host_memory_space>("ordered source coordinates", 
+                        _src_pts_view.extent(0), _dim);
+                Kokkos::parallel_for("copy ordered source coordinates", 
+                        Kokkos::RangePolicy<host_execution_space>(0, _src_pts_view.extent(0)), [&](const int i) {
+                    for (int d=0; d<_dim; ++d) _ordered_src_pts_view(i,d) = _src_pts_view(_src_curve_order[i],d);
+                });
+                Kokkos::fence();
+            }
             if (_dim==1) {
                 _tree_1d = std::make_shared<tree_type_1d>(1, *this, nanoflann::KDTreeSingleIndexAdaptorParams(_max_leaf));
                 _tree_1d->buildIndex();
@@ -217,6 +433,19 @@ class PointCloudSearch {
             }
         }
 
+        //! Traverses the kd-tree from the point x, passing source sites to result_set (a nanoflann result set)
+        template <typename result_set_type>
+        void searchKDTree(const double* x, result_set_type& result_set) const {
+            nanoflann::SearchParams sp; // default parameters
+            if (_dim==1) {
+                _tree_1d->findNeighbors(result_set, x, sp);
+            } else if (_dim==2) {
+                _tree_2d->findNeighbors(result_set, x, sp);
+            } else if (_dim==3) {
+                _tree_3d->findNeighbors(result_set, x, sp);
+            }
+        }
+
         /*! \brief Generates neighbor lists of 2D view by performing a radius search 
             where the radius to be searched is in the epsilons view.
             If uniform_radius is given, then this overrides the epsilons view radii sizes.
@@ -335,7 +564,7 @@ class PointCloudSearch {
                 if (!is_dry_run) {
                     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, loop_bound), [&](const int j) {
                         // cast to an whatever data type the 2D array of neighbor lists is using
-                        neighbor_lists(i,j+1) = static_cast<typename std::remove_pointer<typename std::remove_pointer<typename neighbor_lists_view_type::data_type>::type>::type>(neighbor_indices(j));
+                        neighbor_lists(i,j+1) = static_cast<typename std::remove_pointer<typename std::remove_pointer<typename neighbor_lists_view_type::data_type>::type>::type>(this->getSourceIndex(neighbor_indices(j)));
                     });
                     teamMember.team_barrier();
                 }
@@ -484,7 +713,7 @@ class PointCloudSearch {
                 if (!is_dry_run) {
                     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, loop_bound), [&](const int j) {
                         // cast to an whatever data type the 2D array of neighbor lists is using
-                        neighbor_lists(row_offsets(i)+j) = static_cast<typename std::remove_pointer<typename std::remove_pointer<typename neighbor_lists_view_type::data_type>::type>::type>(neighbor_indices(j));
+                        neighbor_lists(row_offsets(i)+j) = static_cast<typename std::remove_pointer<typename std::remove_pointer<typename neighbor_lists_view_type::data_type>::type>::type>(this->getSourceIndex(neighbor_indices(j)));
                     });
                     teamMember.team_barrier();
                 }
@@ -639,13 +868,15 @@ class PointCloudSearch {
 
         /*! \brief Generates compressed row neighbor lists by performing a k-nearest neighbor search
             Only accepts 1D neighbor_lists with 1D number_of_neighbors_list.
+            Neighbors within the window are collected during the same tree traversal that finds the
+            k nearest neighbors (see KNNRadiusResultSet), rather than by a follow-on radius search.
             \param is_dry_run               [in] - whether to do a dry-run (find neighbors, but don't store)
             \param trg_pts_view             [in] - target coordinates from which to seek neighbors
             \param neighbor_lists           [out] - 1D view of neighbor lists to be populated from search
             \param number_of_neighbors_list [in/out] - number of neighbors for each target site
             \param epsilons                 [in/out] - radius to search, overwritten if uniform_radius != 0
             \param neighbors_needed         [in] - k neighbors needed as a minimum
-            \param epsilon_multiplier       [in] - distance to kth neighbor multiplied by epsilon_multiplier for follow-on radius search
+            \param epsilon_multiplier       [in] - distance to kth neighbor multiplied by epsilon_multiplier to give the window size
             \param max_search_radius        [in] - largest valid search (useful only for MPI jobs if halo size exists)
         */
         template <typename trg_view_type, typename neighbor_lists_view_type, typename epsilons_view_type>
@@ -654,7 +885,7 @@ class PointCloudSearch {
                 epsilons_view_type epsilons, const int neighbors_needed, const double epsilon_multiplier = 1.6, 
                 double max_search_radius = 0.0) {
 
-            // First, do a knn search (removes need for guessing initial search radius)
+            // knn search (removes need for guessing initial search radius) fused with the radius search
 
             compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename trg_view_type::memory_space>::accessible==1) &&
                     "Target coordinates view passed to generateCRNeighborListsFromKNNSearch should be accessible from the host.");
@@ -678,11 +909,17 @@ class PointCloudSearch {
                         && "number_of_neighbors_list or neighbor lists View does not have large enough dimensions");
             compadre_assert_release((neighbor_lists_view_type::rank==1) && "neighbor_lists must be a 1D Kokkos view.");
 
-            // if dry-run, neighbors_needed, else max over previous dry-run
-            int max_neighbor_list_row_storage_size = neighbors_needed;
+            typedef Kokkos::View<global_index_type*, typename neighbor_lists_view_type::array_layout,
+                    typename neighbor_lists_view_type::memory_space, typename neighbor_lists_view_type::memory_traits> row_offsets_view_type;
+            row_offsets_view_type row_offsets;
             if (!is_dry_run) {
                 auto nla = CreateNeighborLists(neighbor_lists, number_of_neighbors_list);
-                max_neighbor_list_row_storage_size = nla.getMaxNumNeighbors();
+                Kokkos::resize(row_offsets, num_target_sites);
+                Kokkos::fence();
+                Kokkos::parallel_for(Kokkos::RangePolicy<host_execution_space>(0,num_target_sites), [&](const int i) {
+                    row_offsets(i) = nla.getRowOffsetHost(i); 
+                });
+                Kokkos::fence();
             }
 
             compadre_assert_release((epsilons.extent(0)==(size_t)num_target_sites)
@@ -691,43 +928,31 @@ class PointCloudSearch {
             typedef Kokkos::View<double*, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
                     scratch_double_view;
 
-            typedef Kokkos::View<size_t*, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > 
-                    scratch_int_view;
-
             // determine scratch space size needed
             int team_scratch_size = 0;
-            team_scratch_size += scratch_double_view::shmem_size(max_neighbor_list_row_storage_size); // distances
-            team_scratch_size += scratch_int_view::shmem_size(max_neighbor_list_row_storage_size); // indices
             team_scratch_size += scratch_double_view::shmem_size(_dim); // target coordinate
 
+            // result sets grow to fit the largest neighborhood a thread sees, and are reused between target sites
+            Kokkos::Experimental::UniqueToken<host_execution_space> token;
+            std::vector<KNNRadiusResultSet<double> > thread_result_sets(token.size());
+            KNNRadiusResultSet<double>* result_sets = thread_result_sets.data();
+
             // minimum number of neighbors found over all target sites' neighborhoods
             size_t min_num_neighbors = 0;
             //
-            // part 1. do knn search for neighbors needed for unisolvency
+            // a single traversal per target site finds the neighbors_needed nearest neighbors, which set
+            // the window size, along with every neighbor within that window
             // each row of neighbor lists is a neighbor list for the target site corresponding to that row
             //
-            // as long as neighbor_lists can hold the number of neighbors_needed, we don't need to check
-            // that the maximum number of neighbors will fit into neighbor_lists
-            //
-            Kokkos::parallel_reduce("knn search", host_team_policy(num_target_sites, Kokkos::AUTO)
+            Kokkos::parallel_reduce("knn and radius search", host_team_policy(num_target_sites, Kokkos::AUTO)
                     .set_scratch_size(0 /*shared memory level*/, Kokkos::PerTeam(team_scratch_size)), 
                     KOKKOS_LAMBDA(const host_member_type& teamMember, size_t& t_min_num_neighbors) {
 
                 // make unmanaged scratch views
-                scratch_double_view neighbor_distances(teamMember.team_scratch(0 /*shared memory*/), max_neighbor_list_row_storage_size);
-                scratch_int_view neighbor_indices(teamMember.team_scratch(0 /*shared memory*/), max_neighbor_list_row_storage_size);
                 scratch_double_view this_target_coord(teamMember.team_scratch(0 /*shared memory*/), _dim);
 
-                size_t neighbors_found = 0;
-
                 const int i = teamMember.league_rank();
 
-                Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, max_neighbor_list_row_storage_size), [=](const int j) {
-                    neighbor_indices(j) = 0;
-                    neighbor_distances(j) = -1.0;
-                });
-            
-                teamMember.team_barrier();
                 Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
                     // target_coords is LayoutLeft on device and its HostMirror, so giving a pointer to 
                     // this data would lead to a wrong result if the device is a GPU
@@ -736,32 +961,37 @@ class PointCloudSearch {
                         this_target_coord(j) = trg_pts_view(i,j);
                     }
 
-                    if (_dim==1) {
-                        neighbors_found = _tree_1d->knnSearch(this_target_coord.data(), neighbors_needed, 
-                                neighbor_indices.data(), neighbor_distances.data()) ;
-                    } else if (_dim==2) {
-                        neighbors_found = _tree_2d->knnSearch(this_target_coord.data(), neighbors_needed, 
-                                neighbor_indices.data(), neighbor_distances.data()) ;
-                    } else if (_dim==3) {
-                        neighbors_found = _tree_3d->knnSearch(this_target_coord.data(), neighbors_needed, 
-                                neighbor_indices.data(), neighbor_distances.data()) ;
-                    }
+                    const int token_id = token.acquire();
+                    KNNRadiusResultSet<double>& rs = result_sets[token_id];
+                    rs.init(neighbors_needed, epsilon_multiplier);
+                    this->searchKDTree(this_target_coord.data(), rs);
 
                     // get minimum number of neighbors found over all target sites' neighborhoods
-                    t_min_num_neighbors = (neighbors_found < t_min_num_neighbors) ? neighbors_found : t_min_num_neighbors;
-            
-                    // scale by epsilon_multiplier to window from location where the last neighbor was found
-                    epsilons(i) = (neighbor_distances(neighbors_found-1) > 0) ?
-                        std::sqrt(neighbor_distances(neighbors_found-1))*epsilon_multiplier : 1e-14*epsilon_multiplier;
-                    // the only time the second case using 1e-14 is used is when either zero neighbors or exactly one 
-                    // neighbor (neighbor is target site) is found.  when the follow on radius search is conducted, the one
-                    // neighbor (target site) will not be found if left at 0, so any positive amount will do, however 1e-14 
-                    // should is small enough to ensure that other neighbors are not found
+                    t_min_num_neighbors = (rs.size() < t_min_num_neighbors) ? rs.size() : t_min_num_neighbors;
+
+                    // distance to kth neighbor scaled by epsilon_multiplier, or 1e-14*epsilon_multiplier
+                    // if it is 0 so that a neighbor at the target site is still found
+                    epsilons(i) = rs.finalize();
 
                     compadre_kernel_assert_release((epsilons(i)<=max_search_radius || max_search_radius==0 || is_dry_run) 
                             && "max_search_radius given (generally derived from the size of a halo region), \
                                 and search radius needed would exceed this max_search_radius.");
-                    // neighbor_distances stores squared distances from neighbor to target, as returned by nanoflann
+
+                    const size_t neighbors_found = rs.getNumberOfNeighbors();
+                    if (is_dry_run) {
+                        number_of_neighbors_list(i) = neighbors_found;
+                    } else {
+                        compadre_kernel_assert_debug((neighbors_found==(size_t)number_of_neighbors_list(i)) 
+                                && "Number of neighbors found changed since dry-run.");
+                        // loop_bound so that we don't write into memory we don't have allocated
+                        const size_t loop_bound = (neighbors_found < (size_t)number_of_neighbors_list(i)) ?
+                            neighbors_found : number_of_neighbors_list(i);
+                        for (size_t j=0; j<loop_bound; ++j) {
+                            // cast to an whatever data type the 2D array of neighbor lists is using
+                            neighbor_lists(row_offsets(i)+j) = static_cast<typename std::remove_pointer<typename std::remove_pointer<typename neighbor_lists_view_type::data_type>::type>::type>(this->getSourceIndex(rs.getNeighbor(j)));
+                        }
+                    }
+                    token.release(token_id);
                 });
             }, Kokkos::Min<size_t>(min_num_neighbors) );
             Kokkos::fence();
@@ -773,20 +1003,170 @@ class PointCloudSearch {
             // Next, check that we found the neighbors_needed number that we require for unisolvency
             compadre_assert_release((num_target_sites==0 || (min_num_neighbors>=(size_t)neighbors_needed))
                     && "Neighbor search failed to find number of neighbors needed for unisolvency.");
-            
-            // call a radius search using values now stored in epsilons
-            generateCRNeighborListsFromRadiusSearch(is_dry_run, trg_pts_view, neighbor_lists, 
-                    number_of_neighbors_list, epsilons, 0.0 /*don't set uniform radius*/, max_search_radius);
 
             auto nla = CreateNeighborLists(number_of_neighbors_list);
             return nla.getTotalNeighborsOverAllListsHost();
         }
+
+        /*! \brief Generates compressed row neighbor lists by performing a radius search, in a single call
+            and with a single search per target site. Neighbors of each target site are appended to storage
+            owned by the thread that searched it, then compacted into the returned NeighborLists, so no
+            dry-run is needed.
+            \param trg_pts_view             [in] - target coordinates from which to seek neighbors
+            \param epsilons                 [in/out] - radius to search, overwritten if uniform_radius != 0
+            \param uniform_radius           [in] - double != 0 determines whether to overwrite all epsilons for uniform search
+            \param max_search_radius        [in] - largest valid search (useful only for MPI jobs if halo size exists)
+        */
+        template <typename neighbor_lists_view_type = Kokkos::View<int*, host_memory_space>, 
+                 typename trg_view_type, typename epsilons_view_type>
+        NeighborLists<neighbor_lists_view_type> generateCRNeighborListsFromRadiusSearch(trg_view_type trg_pts_view, 
+                epsilons_view_type epsilons, const double uniform_radius = 0.0, double max_search_radius = 0.0) {
+
+            compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename trg_view_type::memory_space>::accessible==1) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromRadiusSearch should be accessible from the host.");
+            compadre_assert_release((((int)trg_pts_view.extent(1))>=_dim) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromRadiusSearch must have \
+                    second dimension as large as _dim.");
+            compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename epsilons_view_type::memory_space>::accessible==1) &&
+                    "Views passed to generateCRNeighborListsFromRadiusSearch should be accessible from the host.");
+
+            // loop size
+            const int num_target_sites = trg_pts_view.extent(0);
+
+            if ((!_tree_1d && _dim==1) || (!_tree_2d && _dim==2) || (!_tree_3d && _dim==3)) {
+                this->generateKDTree();
+            }
+
+            compadre_assert_release((epsilons.extent(0)==(size_t)num_target_sites)
+                        && "epsilons View does not have the correct dimension");
+
+            Kokkos::Experimental::UniqueToken<host_execution_space> token;
+            std::vector<std::vector<std::pair<size_t, double> > > thread_results(token.size());
+            std::vector<std::pair<size_t, double> >* results = thread_results.data();
+            ThreadNeighborChunks chunks(token.size(), num_target_sites);
+
+            Kokkos::parallel_for("radius search", Kokkos::RangePolicy<host_execution_space>(0, num_target_sites), 
+                    [&](const int i) {
+
+                // set epsilons if radius is specified
+                if (uniform_radius > 0) epsilons(i) = uniform_radius;
+
+                compadre_kernel_assert_release((epsilons(i)<=max_search_radius || max_search_radius==0) && "max_search_radius given (generally derived from the size of a halo region), and search radius needed would exceed this max_search_radius.");
+
+                double this_target_coord[3] = {0,0,0};
+                for (int j=0; j<_dim; ++j) {
+                    this_target_coord[j] = trg_pts_view(i,j);
+                }
+
+                const int token_id = token.acquire();
+                nanoflann::RadiusResultSet<double> rrs(epsilons(i)*epsilons(i), results[token_id]);
+                this->searchKDTree(this_target_coord, rrs);
+
+                // puts closest neighbor as the first entry in the neighbor list, as RadiusResultSet::sort does
+                auto& found = results[token_id];
+                size_t best_index = 0;
+                for (size_t j=1; j<found.size(); ++j) {
+                    if (found[j].second < found[best_index].second) best_index = j;
+                }
+                if (best_index != 0) std::swap(found[0], found[best_index]);
+
+                chunks.startRow(i, token_id);
+                for (size_t j=0; j<found.size(); ++j) chunks.append(token_id, this->getSourceIndex(found[j].first));
+                chunks.endRow(i, token_id);
+                token.release(token_id);
+            });
+            Kokkos::fence();
+
+            return chunks.template compact<neighbor_lists_view_type>();
+        }
+
+        /*! \brief Generates compressed row neighbor lists by performing a k-nearest neighbor search, in a single
+            call and with a single search per target site (see KNNRadiusResultSet). Neighbors of each target site
+            are appended to storage owned by the thread that searched it, then compacted into the returned 
+            NeighborLists, so no dry-run is needed.
+            \param trg_pts_view             [in] - target coordinates from which to seek neighbors
+            \param epsilons                 [out] - window size for each target site
+            \param neighbors_needed         [in] - k neighbors needed as a minimum
+            \param epsilon_multiplier       [in] - distance to kth neighbor multiplied by epsilon_multiplier to give the window size
+            \param max_search_radius        [in] - largest valid search (useful only for MPI jobs if halo size exists)
+        */
+        template <typename neighbor_lists_view_type = Kokkos::View<int*, host_memory_space>, 
+                 typename trg_view_type, typename epsilons_view_type>
+        NeighborLists<neighbor_lists_view_type> generateCRNeighborListsFromKNNSearch(trg_view_type trg_pts_view, 
+                epsilons_view_type epsilons, const int neighbors_needed, const double epsilon_multiplier = 1.6, 
+                double max_search_radius = 0.0) {
+
+            compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename trg_view_type::memory_space>::accessible==1) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromKNNSearch should be accessible from the host.");
+            compadre_assert_release((((int)trg_pts_view.extent(1))>=_dim) &&
+                    "Target coordinates view passed to generateCRNeighborListsFromKNNSearch must have \
+                    second dimension as large as _dim.");
+            compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename epsilons_view_type::memory_space>::accessible==1) &&
+                    "Views passed to generateCRNeighborListsFromKNNSearch should be accessible from the host.");
+
+            // loop size
+            const int num_target_sites = trg_pts_view.extent(0);
+
+            if ((!_tree_1d && _dim==1) || (!_tree_2d && _dim==2) || (!_tree_3d && _dim==3)) {
+                this->generateKDTree();
+            }
+
+            compadre_assert_release((epsilons.extent(0)==(size_t)num_target_sites)
+                        && "epsilons View does not have the correct dimension");
+
+            Kokkos::Experimental::UniqueToken<host_execution_space> token;
+            std::vector<KNNRadiusResultSet<double> > thread_result_sets(token.size());
+            KNNRadiusResultSet<double>* result_sets = thread_result_sets.data();
+            ThreadNeighborChunks chunks(token.size(), num_target_sites);
+
+            // minimum number of neighbors found over all target sites' neighborhoods
+            size_t min_num_neighbors = 0;
+            Kokkos::parallel_reduce("knn and radius search", Kokkos::RangePolicy<host_execution_space>(0, num_target_sites), 
+                    [&](const int i, size_t& t_min_num_neighbors) {
+
+                double this_target_coord[3] = {0,0,0};
+                for (int j=0; j<_dim; ++j) {
+                    this_target_coord[j] = trg_pts_view(i,j);
+                }
+
+                const int token_id = token.acquire();
+                KNNRadiusResultSet<double>& rs = result_sets[token_id];
+                rs.init(neighbors_needed, epsilon_multiplier);
+                this->searchKDTree(this_target_coord, rs);
+
+                // get minimum number of neighbors found over all target sites' neighborhoods
+                t_min_num_neighbors = (rs.size() < t_min_num_neighbors) ? rs.size() : t_min_num_neighbors;
+
+                epsilons(i) = rs.finalize();
+
+                compadre_kernel_assert_release((epsilons(i)<=max_search_radius || max_search_radius==0) 
+                        && "max_search_radius given (generally derived from the size of a halo region), \
+                            and search radius needed would exceed this max_search_radius.");
+
+                chunks.startRow(i, token_id);
+                for (size_t j=0; j<rs.getNumberOfNeighbors(); ++j) chunks.append(token_id, this->getSourceIndex(rs.getNeighbor(j)));
+                chunks.endRow(i, token_id);
+                token.release(token_id);
+            }, Kokkos::Min<size_t>(min_num_neighbors) );
+            Kokkos::fence();
+
+            // if no target sites, then min_num_neighbors is set to neighbors_needed
+            // which also avoids min_num_neighbors being improperly set by min reduction
+            if (num_target_sites==0) min_num_neighbors = neighbors_needed;
+
+            // Next, check that we found the neighbors_needed number that we require for unisolvency
+            compadre_assert_release((num_target_sites==0 || (min_num_neighbors>=(size_t)neighbors_needed))
+                    && "Neighbor search failed to find number of neighbors needed for unisolvency.");
+
+            return chunks.template compact<neighbor_lists_view_type>();
+        }
 }; // PointCloudSearch
 
 //! CreatePointCloudSearch allows for the construction of an object of type PointCloudSearch with template deduction
 template <typename view_type>
-PointCloudSearch<view_type> CreatePointCloudSearch(view_type src_view, const local_index_type dimensions = -1, const local_index_type max_leaf = -1) { 
-    return PointCloudSearch<view_type>(src_view, dimensions, max_leaf);
+PointCloudSearch<view_type> CreatePointCloudSearch(view_type src_view, const local_index_type dimensions = -1, 
+        const local_index_type max_leaf = -1, const bool order_sources_along_curve = false) { 
+    return PointCloudSearch<view_type>(src_view, dimensions, max_leaf, order_sources_along_curve);
 }
 
 } // Compadre
@@ -37,6 +37,10 @@ struct SolutionSet {
     //! generated alpha coefficients (device)
     Kokkos::View<double*, layout_right, memory_space> _alphas; 
 
+    //! index (in the layout of alphas for all target sites) of the first entry of _alphas, which is 
+    //! nonzero when _alphas only holds a contiguous range of target sites (e.g. when streaming alphas)
+    global_index_type _alpha_index_offset;
+
     //! additional alpha coefficients due to constraints
     int _added_alpha_size;
 
@@ -46,6 +50,19 @@ struct SolutionSet {
     //! used for sizing P_target_row and the _alphas view
     int _total_alpha_values;
 
+    //! for each tile of alphas at one evaluation site (indexed as by getTargetOffsetIndex), the tile whose alphas
+    //! it has: itself if its alphas are stored, an earlier tile if it is a clone of that tile, or -1 if its alphas
+    //! are all zero (empty if every tile is stored)
+    Kokkos::View<int*, memory_space> _alpha_tile_source;
+
+    //! for each tile of alphas at one evaluation site, the tile of _alphas its values are stored in, or -1 if its
+    //! alphas are all zero (empty if every tile is stored)
+    Kokkos::View<int*, memory_space> _alpha_tile_storage;
+
+    //! number of tiles stored in _alphas for each neighbor and evaluation site (less than _total_alpha_values
+    //! when some tiles are zero or clones of another tile)
+    int _total_stored_alpha_values;
+
     //
     // Redundant variables (already exist in GMLS class)
     //
@@ -75,15 +92,17 @@ struct SolutionSet {
                 int dimensions, 
                 int local_dimensions,
                 const ProblemType problem_type) :
+                    _alpha_index_offset(0),
                     _added_alpha_size(0), 
                     _max_evaluation_sites_per_target(1),
                     _total_alpha_values(0),
+                    _total_stored_alpha_values(0),
                     _data_sampling_functional(data_sampling_functional),
                     _dimensions(dimensions), 
                     _local_dimensions(local_dimensions), 
                     _problem_type(problem_type) {}
 
-    SolutionSet() : _data_sampling_functional(PointSample) {}
+    SolutionSet() : _alpha_index_offset(0), _data_sampling_functional(PointSample) {}
 
     //! \brief Copy constructor (can be used to move data from device to host or vice-versa)
     template <typename other_memory_space>
@@ -93,9 +112,11 @@ struct SolutionSet {
             _local_dimensions(other._local_dimensions),
             _problem_type(other._problem_type) {
 
+        _alpha_index_offset = other._alpha_index_offset;
         _added_alpha_size = other._added_alpha_size;
         _max_evaluation_sites_per_target = other._max_evaluation_sites_per_target;
         _total_alpha_values = other._total_alpha_values;
+        _total_stored_alpha_values = other._total_stored_alpha_values;
         _neighbor_lists = other._neighbor_lists;
 
         // copy from other_memory_space to memory_space (if needed)
@@ -120,6 +141,12 @@ struct SolutionSet {
         if (_lro_input_tensor_rank.extent(0) != other._lro_input_tensor_rank.extent(0)) {
             Kokkos::resize(_lro_input_tensor_rank, other._lro_input_tensor_rank.extent(0));
         }
+        if (_alpha_tile_source.extent(0) != other._alpha_tile_source.extent(0)) {
+            Kokkos::resize(_alpha_tile_source, other._alpha_tile_source.extent(0));
+        }
+        if (_alpha_tile_storage.extent(0) != other._alpha_tile_storage.extent(0)) {
+            Kokkos::resize(_alpha_tile_storage, other._alpha_tile_storage.extent(0));
+        }
         Kokkos::deep_copy(_lro, other._lro);
         Kokkos::deep_copy(_lro_lookup, other._lro_lookup);
         Kokkos::deep_copy(_lro_total_offsets, other._lro_total_offsets);
@@ -127,6 +154,8 @@ struct SolutionSet {
         Kokkos::deep_copy(_lro_input_tile_size, other._lro_input_tile_size);
         Kokkos::deep_copy(_lro_output_tensor_rank, other._lro_output_tensor_rank);
         Kokkos::deep_copy(_lro_input_tensor_rank, other._lro_input_tensor_rank);
+        Kokkos::deep_copy(_alpha_tile_source, other._alpha_tile_source);
+        Kokkos::deep_copy(_alpha_tile_storage, other._alpha_tile_storage);
 
         // don't copy _alphas (expensive)
         // _alphas only copied using copyAlphas
@@ -150,6 +179,27 @@ struct SolutionSet {
                 + output_component );
     }
 
+    //! Maps an index from getTargetOffsetIndex to the column of _alphas holding its values (the same column for 
+    //! a tile and its clones), or to -1 if its alphas are all zero
+    template<typename ms=memory_space, enable_if_t<!std::is_same<host_memory_space, ms>::value, int> = 0>
+    KOKKOS_INLINE_FUNCTION
+    int getAlphaStorageIndex(const int target_offset_index) const {
+        if (_alpha_tile_storage.extent(0) == 0) return target_offset_index;
+        const int evaluation_site_local_index = target_offset_index / _total_alpha_values;
+        const int tile = _alpha_tile_storage(target_offset_index - evaluation_site_local_index*_total_alpha_values);
+        return (tile < 0) ? -1 : _total_stored_alpha_values*evaluation_site_local_index + tile;
+    }
+
+    //! Whether alphas for an index from getTargetOffsetIndex are computed and stored, rather than being zero
+    //! or a clone of another tile
+    template<typename ms=memory_space, enable_if_t<!std::is_same<host_memory_space, ms>::value, int> = 0>
+    KOKKOS_INLINE_FUNCTION
+    bool isAlphaTileStored(const int target_offset_index) const {
+        if (_alpha_tile_source.extent(0) == 0) return true;
+        const int tile = target_offset_index % _total_alpha_values;
+        return _alpha_tile_source(tile) == tile;
+    }
+
     //! Helper function for getting alphas for scalar reconstruction from scalar data
     template<typename ms=memory_space, enable_if_t<!std::is_same<host_memory_space, ms>::value, int> = 0>
     KOKKOS_INLINE_FUNCTION
@@ -219,7 +269,8 @@ struct SolutionSet {
     }
 
     //! Gives index into alphas given two axes, which when incremented by the neighbor number transforms access into
-    //! alphas from a rank 1 view into a rank 3 view.
+    //! alphas from a rank 1 view into a rank 3 view. alpha_column_offset is a column of _alphas, as given by
+    //! getAlphaColumnOffset or getAlphaStorageIndex.
     template<typename ms=memory_space, enable_if_t<!std::is_same<host_memory_space, ms>::value, int> = 0>
     KOKKOS_INLINE_FUNCTION
     global_index_type getAlphaIndex(const int target_index, const int alpha_column_offset) const {
@@ -230,14 +281,14 @@ struct SolutionSet {
         int alphas_per_tile_per_target = _neighbor_lists.getNumberOfNeighborsDevice(target_index) + _added_alpha_size;
 
         return (total_neighbors_before_target+TO_GLOBAL(total_added_alphas_before_target))
-                 *TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target)
-                   + TO_GLOBAL(alpha_column_offset*alphas_per_tile_per_target);
+                 *TO_GLOBAL(_total_stored_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target)
+                   + TO_GLOBAL(alpha_column_offset*alphas_per_tile_per_target) - _alpha_index_offset;
 
     }
 
     //! Retrieves the offset for an operator based on input and output component, generic to row
     //! (but still multiplied by the number of neighbors for each row and then needs a neighbor number added 
-    //! to this returned value to be meaningful)
+    //! to this returned value to be meaningful). Returns -1 if the alphas for these components are all zero.
     template<typename ms=memory_space, enable_if_t<!std::is_same<host_memory_space, ms>::value, int> = 0>
     KOKKOS_INLINE_FUNCTION
     int getAlphaColumnOffset(TargetOperation lro, const int output_component_axis_1, 
@@ -254,7 +305,7 @@ struct SolutionSet {
         const int input_index = getSamplingOutputIndex(_data_sampling_functional, input_component_axis_1, input_component_axis_2);
         const int output_index = getTargetOutputIndex((int)lro, output_component_axis_1, output_component_axis_2, _dimensions);
 
-        return getTargetOffsetIndex(lro_number, input_index, output_index, evaluation_site_local_index);
+        return getAlphaStorageIndex(getTargetOffsetIndex(lro_number, input_index, output_index, evaluation_site_local_index));
     }
 
     //! Underlying function all interface helper functions call to retrieve alpha values
@@ -283,6 +334,7 @@ struct SolutionSet {
 
         const int alpha_column_offset = this->getAlphaColumnOffset( lro, output_component_axis_1, 
                 output_component_axis_2, input_component_axis_1, input_component_axis_2, evaluation_site_local_index);
+        if (alpha_column_offset < 0) return 0;
 
         auto alphas_index = this->getAlphaIndex(target_index, alpha_column_offset);
         return _alphas(alphas_index + neighbor_index);
@@ -306,6 +358,25 @@ struct SolutionSet {
                 + output_component );
     }
 
+    //! Maps an index from getTargetOffsetIndex to the column of _alphas holding its values (the same column for 
+    //! a tile and its clones), or to -1 if its alphas are all zero
+    template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
+    int getAlphaStorageIndex(const int target_offset_index) const {
+        if (_alpha_tile_storage.extent(0) == 0) return target_offset_index;
+        const int evaluation_site_local_index = target_offset_index / _total_alpha_values;
+        const int tile = _alpha_tile_storage(target_offset_index - evaluation_site_local_index*_total_alpha_values);
+        return (tile < 0) ? -1 : _total_stored_alpha_values*evaluation_site_local_index + tile;
+    }
+
+    //! Whether alphas for an index from getTargetOffsetIndex are computed and stored, rather than being zero
+    //! or a clone of another tile
+    template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
+    bool isAlphaTileStored(const int target_offset_index) const {
+        if (_alpha_tile_source.extent(0) == 0) return true;
+        const int tile = target_offset_index % _total_alpha_values;
+        return _alpha_tile_source(tile) == tile;
+    }
+
     //! Helper function for getting alphas for scalar reconstruction from scalar data
     template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
     double getAlpha0TensorTo0Tensor(TargetOperation lro, const int target_index, const int neighbor_index, const int evaluation_site_local_index = 0) const {
@@ -366,7 +437,8 @@ struct SolutionSet {
     }
 
     //! Gives index into alphas given two axes, which when incremented by the neighbor number transforms access into
-    //! alphas from a rank 1 view into a rank 3 view.
+    //! alphas from a rank 1 view into a rank 3 view. alpha_column_offset is a column of _alphas, as given by
+    //! getAlphaColumnOffset or getAlphaStorageIndex.
     template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
     global_index_type getAlphaIndex(const int target_index, const int alpha_column_offset) const {
 
@@ -376,14 +448,14 @@ struct SolutionSet {
         int alphas_per_tile_per_target = _neighbor_lists.getNumberOfNeighborsHost(target_index) + _added_alpha_size;
 
         return (total_neighbors_before_target+TO_GLOBAL(total_added_alphas_before_target))
-                 *TO_GLOBAL(_total_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target)
-                   + TO_GLOBAL(alpha_column_offset*alphas_per_tile_per_target);
+                 *TO_GLOBAL(_total_stored_alpha_values)*TO_GLOBAL(_max_evaluation_sites_per_target)
+                   + TO_GLOBAL(alpha_column_offset*alphas_per_tile_per_target) - _alpha_index_offset;
 
     }
 
     //! Retrieves the offset for an operator based on input and output component, generic to row
     //! (but still multiplied by the number of neighbors for each row and then needs a neighbor number added 
-    //! to this returned value to be meaningful)
+    //! to this returned value to be meaningful). Returns -1 if the alphas for these components are all zero.
     template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
     int getAlphaColumnOffset(TargetOperation lro, const int output_component_axis_1, 
             const int output_component_axis_2, const int input_component_axis_1, 
@@ -399,7 +471,7 @@ struct SolutionSet {
         const int input_index = getSamplingOutputIndex(_data_sampling_functional, input_component_axis_1, input_component_axis_2);
         const int output_index = getTargetOutputIndex((int)lro, output_component_axis_1, output_component_axis_2, _dimensions);
 
-        return getTargetOffsetIndex(lro_number, input_index, output_index, evaluation_site_local_index);
+        return getAlphaStorageIndex(getTargetOffsetIndex(lro_number, input_index, output_index, evaluation_site_local_index));
     }
 
     //! Underlying function all interface helper functions call to retrieve alpha values
@@ -427,6 +499,7 @@ struct SolutionSet {
 
         const int alpha_column_offset = this->getAlphaColumnOffset( lro, output_component_axis_1, 
                 output_component_axis_2, input_component_axis_1, input_component_axis_2, evaluation_site_local_index);
+        if (alpha_column_offset < 0) return 0;
 
         auto alphas_index = this->getAlphaIndex(target_index, alpha_column_offset);
         return _alphas(alphas_index + neighbor_index);
@@ -456,10 +529,35 @@ struct SolutionSet {
                 Kokkos::resize(_alphas, other._alphas.extent(0));
             }
             Kokkos::deep_copy(_alphas, other._alphas);
+            _alpha_index_offset = other._alpha_index_offset;
         }
     }
 
 
+    //! Sets which tiles of alphas are zero or clones of another tile, so that only the remaining tiles are stored.
+    //! tile_sources has an entry for each tile at one evaluation site (see _alpha_tile_source).
+    template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
+    void setAlphaTileSources(const std::vector<int>& tile_sources) {
+        compadre_assert_release((tile_sources.size() == (size_t)_total_alpha_values) 
+                && "setAlphaTileSources requires a source for each tile of alphas.");
+        _alpha_tile_source = decltype(_alpha_tile_source)("alpha tile sources", _total_alpha_values);
+        _alpha_tile_storage = decltype(_alpha_tile_storage)("alpha tile storage", _total_alpha_values);
+        _total_stored_alpha_values = 0;
+        for (int i=0; i<_total_alpha_values; ++i) {
+            const int source = tile_sources[i];
+            compadre_assert_release((source == -1 || source == i || (source >= 0 && source < i && tile_sources[source] == source))
+                    && "A tile of alphas can only be a clone of an earlier tile that is stored.");
+            _alpha_tile_source(i) = source;
+            _alpha_tile_storage(i) = (source == i) ? _total_stored_alpha_values++ : 
+                ((source < 0) ? -1 : _alpha_tile_storage(source));
+        }
+        if (_total_stored_alpha_values == _total_alpha_values) {
+            // every tile is stored
+            _alpha_tile_source = decltype(_alpha_tile_source)();
+            _alpha_tile_storage = decltype(_alpha_tile_storage)();
+        }
+    }
+
     //! Empties the vector of target functionals to apply to the reconstruction
     template<typename ms=memory_space, enable_if_t<std::is_same<host_memory_space, ms>::value, int> = 0>
     void clearTargets() {
@@ -574,6 +672,11 @@ struct SolutionSet {
                 _total_alpha_values : std::pow(_local_dimensions, 1);
         }
 
+        // every tile is stored until setAlphaTileSources is called for these targets
+        _alpha_tile_source = decltype(_alpha_tile_source)();
+        _alpha_tile_storage = decltype(_alpha_tile_storage)();
+        _total_stored_alpha_values = _total_alpha_values;
+
         Kokkos::deep_copy(_lro_lookup, host_lro_lookup);
         Kokkos::deep_copy(_lro_total_offsets, host_lro_total_offsets);
         Kokkos::deep_copy(_lro_output_tile_size, host_lro_output_tile_size);
@@ -0,0 +1,79 @@
+#ifndef _COMPADRE_SPACEFILLINGCURVE_HPP_
+#define _COMPADRE_SPACEFILLINGCURVE_HPP_
+
+#include "Compadre_Typedefs.hpp"
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Compadre {
+
+//! Interleaves the bits of a coordinate, quantized to the box starting at box_min with
+//! side lengths 1/inv_box_length, into a Morton code (Z-order curve index)
+KOKKOS_INLINE_FUNCTION
+std::uint64_t getMortonCode(const double* x, const double* box_min, const double* inv_box_length, const int dim) {
+    const int bits = (dim==1) ? 62 : ((dim==2) ? 31 : 21);
+    const double max_cell = (double)((((std::uint64_t)1) << bits) - 1);
+    std::uint64_t code = 0;
+    for (int d=0; d<dim; ++d) {
+        double s = (x[d] - box_min[d])*inv_box_length[d];
+        s = (s < 0) ? 0 : ((s > 1) ? 1 : s);
+        const std::uint64_t cell = (std::uint64_t)(s*max_cell);
+        for (int b=0; b<bits; ++b) {
+            code |= ((cell >> b) & 1) << (b*dim + d);
+        }
+    }
+    return code;
+}
+
+/*! \brief Orders sites along a Morton curve over their bounding box, so that sites near each other in
+    the ordering are near each other in space.
+    \param coordinates      [in] - sites as rows, accessible from the host
+    \param dim              [in] - number of leading columns of coordinates to order by
+    \param indices          [in] - rows of coordinates to order (all rows if empty)
+    \return rows of coordinates in Morton order, with ties kept in the order given
+*/
+template <typename view_type>
+std::vector<int> getMortonOrder(view_type coordinates, const int dim,
+        const std::vector<int>& indices = std::vector<int>()) {
+
+    compadre_assert_release((Kokkos::SpaceAccessibility<host_execution_space, typename view_type::memory_space>::accessible==1)
+            && "Coordinates passed to getMortonOrder should be accessible from the host.");
+    compadre_assert_release((dim>=1 && dim<=3 && (int)coordinates.extent(1)>=dim)
+            && "getMortonOrder orders by 1, 2, or 3 coordinates.");
+
+    const bool all_sites = indices.empty();
+    const int num_sites = (all_sites) ? coordinates.extent(0) : indices.size();
+    auto site = [&](const int i) { return (all_sites) ? i : indices[i]; };
+
+    double box_min[3] = {0,0,0}, box_max[3] = {0,0,0}, inv_box_length[3] = {0,0,0};
+    for (int d=0; d<dim; ++d) {
+        if (num_sites > 0) box_min[d] = box_max[d] = coordinates(site(0),d);
+        for (int i=1; i<num_sites; ++i) {
+            box_min[d] = std::min(box_min[d], coordinates(site(i),d));
+            box_max[d] = std::max(box_max[d], coordinates(site(i),d));
+        }
+        inv_box_length[d] = (box_max[d] > box_min[d]) ? 1.0/(box_max[d] - box_min[d]) : 0.0;
+    }
+
+    // sorting by (code, position) breaks ties by position, so the result is deterministic
+    std::vector<std::pair<std::uint64_t, int> > keys(num_sites);
+    Kokkos::parallel_for("morton order codes", Kokkos::RangePolicy<host_execution_space>(0, num_sites),
+            [&](const int i) {
+        double x[3] = {0,0,0};
+        for (int d=0; d<dim; ++d) x[d] = coordinates(site(i),d);
+        keys[i] = std::make_pair(getMortonCode(x, box_min, inv_box_length, dim), i);
+    });
+    Kokkos::fence();
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<int> order(num_sites);
+    for (int i=0; i<num_sites; ++i) order[i] = site(keys[i].second);
+    return order;
+}
+
+} // Compadre
+
+#endif
@@ -31,7 +31,7 @@ void computeTargetFunctionals(const TargetData& data, const member_type& teamMem
     bool additional_evaluation_sites_need_handled = 
         (data._additional_pc._source_coordinates.extent(0) > 0) ? true : false; // additional evaluation sites are specified
 
-    const int target_index = data._initial_index_for_batch + teamMember.league_rank();
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
 
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, P_target_row.extent(0)), [&] (const int j) {
         Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, P_target_row.extent(1)),
@@ -977,7 +977,7 @@ void computeCurvatureFunctionals(const TargetData& data, const member_type& team
 
     compadre_kernel_assert_release(((int)thread_workspace.extent(0)>=(data._curvature_poly_order+1)*data._local_dimensions) && "Workspace thread_workspace not large enough.");
 
-    const int target_index = data._initial_index_for_batch + teamMember.league_rank();
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
 
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, P_target_row.extent(0)), [&] (const int j) {
         Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, P_target_row.extent(1)),
@@ -1047,7 +1047,7 @@ void computeTargetFunctionalsOnManifold(const TargetData& data, const member_typ
     compadre_kernel_assert_release(((int)thread_workspace.extent(0)>=(data._poly_order+1)*data._local_dimensions) && "Workspace thread_workspace not large enough.");
 
     // only designed for 2D manifold embedded in 3D space
-    const int target_index = data._initial_index_for_batch + teamMember.league_rank();
+    const int target_index = data.getTargetIndex(teamMember.league_rank());
     // not const b.c. of gcc 7.2 issue
     int target_NP = GMLS::getNP(data._poly_order, data._dimensions-1, data._reconstruction_space);
 
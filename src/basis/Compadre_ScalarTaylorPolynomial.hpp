@@ -104,6 +104,69 @@ namespace ScalarTaylorPolynomialBasis {
         });
     }
 
+    /*! \brief Returns size of basis, for a dimension and degree known at compile time
+        \tparam degree              - highest degree of polynomial
+        \tparam dimension           - spatial dimension to evaluate
+    */
+    template <int degree, int dimension>
+    KOKKOS_INLINE_FUNCTION
+    constexpr int getSize() {
+        return (dimension == 3) ? (degree+1)*(degree+2)*(degree+3)/6 :
+               (dimension == 2) ? (degree+1)*(degree+2)/2 : degree+1;
+    }
+
+    /*! \brief Evaluates the scalar Taylor polynomial basis, for a dimension and degree known at compile time
+
+        Computes the same values, in the same order, as evaluate(...) with starting_order = 0 and replacing 
+        the values in delta. All loop bounds are constants, so the loops are unrolled and the powers stay in 
+        registers. This is called by a single thread, so it does not need any workspace, which lets each thread 
+        of TiledStandardGMLS evaluate the basis for its own target site.
+        \tparam dimension               - spatial dimension to evaluate
+        \tparam max_degree              - highest degree of polynomial
+        \param delta               [out] - array of at least getSize<max_degree,dimension>() entries
+        \param h                    [in] - epsilon/window size
+        \param x                    [in] - x coordinate (already shifted by target)
+        \param y                    [in] - y coordinate (already shifted by target)
+        \param z                    [in] - z coordinate (already shifted by target)
+    */
+    template <int dimension, int max_degree>
+    KOKKOS_INLINE_FUNCTION
+    void evaluate(double* delta, const double h, const double x, const double y, const double z) {
+        const double factorial[] = {1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600, 6227020800, 87178291200};
+        double x_over_h_to_i[max_degree+1];
+        double y_over_h_to_i[max_degree+1];
+        double z_over_h_to_i[max_degree+1];
+        x_over_h_to_i[0] = 1;
+        y_over_h_to_i[0] = 1;
+        z_over_h_to_i[0] = 1;
+        for (int i=1; i<=max_degree; ++i) {
+            x_over_h_to_i[i] = x_over_h_to_i[i-1]*(x/h);
+            y_over_h_to_i[i] = (dimension > 1) ? y_over_h_to_i[i-1]*(y/h) : 0;
+            z_over_h_to_i[i] = (dimension > 2) ? z_over_h_to_i[i-1]*(z/h) : 0;
+        }
+        int i = 0;
+        for (int n = 0; n <= max_degree; n++){
+            if (dimension==3) {
+                for (int alphaz = 0; alphaz <= n; alphaz++){
+                    const int s = n - alphaz;
+                    for (int alphay = 0; alphay <= s; alphay++){
+                        const int alphax = s - alphay;
+                        const double alphaf = factorial[alphax]*factorial[alphay]*factorial[alphaz];
+                        delta[i++] = x_over_h_to_i[alphax]*y_over_h_to_i[alphay]*z_over_h_to_i[alphaz]/alphaf;
+                    }
+                }
+            } else if (dimension==2) {
+                for (int alphay = 0; alphay <= n; alphay++){
+                    const int alphax = n - alphay;
+                    const double alphaf = factorial[alphax]*factorial[alphay];
+                    delta[i++] = x_over_h_to_i[alphax]*y_over_h_to_i[alphay]/alphaf;
+                }
+            } else {
+                delta[i++] = x_over_h_to_i[n]/factorial[n];
+            }
+        }
+    }
+
     /*! \brief Evaluates the first partial derivatives of scalar Taylor polynomial basis
      *  delta[j] = weight_of_original_value * delta[j] + weight_of_new_value * (calculation of this function)
         \param delta                [in/out] - scratch space that is allocated so that each thread has its own copy. Must be at least as large as the _basis_multipler*the dimension of the polynomial basis.
@@ -5,8 +5,9 @@
 
 namespace Compadre {
 
+template <typename matrix_type>
 KOKKOS_INLINE_FUNCTION
-void evaluateConstraints(scratch_matrix_right_type M, scratch_matrix_right_type PsqrtW, const ConstraintType constraint_type, const ReconstructionSpace reconstruction_space, const int NP, const double cutoff_p, const int dimension, const int num_neighbors = 0, scratch_matrix_right_type* T = NULL) {
+void evaluateConstraints(matrix_type M, matrix_type PsqrtW, const ConstraintType constraint_type, const ReconstructionSpace reconstruction_space, const int NP, const double cutoff_p, const int dimension, const int num_neighbors = 0, scratch_matrix_right_type* T = NULL) {
     if (constraint_type == ConstraintType::NEUMANN_GRAD_SCALAR) {
         if (reconstruction_space == ReconstructionSpace::ScalarTaylorPolynomial 
                 || reconstruction_space == ReconstructionSpace::VectorOfScalarClonesTaylorPolynomial) {
@@ -0,0 +1,606 @@
+#ifndef __KOKKOSBATCHED_UTV_HOST_INTERNAL_COMPADRE_HPP__
+#define __KOKKOSBATCHED_UTV_HOST_INTERNAL_COMPADRE_HPP__
+
+#include "KokkosBatched_Util.hpp"
+
+#include "KokkosBatched_UTV_TeamVector_Internal.hpp"
+#include "KokkosBatched_SolveUTV_TeamVector_Internal_Compadre.hpp"
+
+// explicitly vectorize loops over contiguous entries (ignored without OpenMP)
+#if defined(KOKKOS_ENABLE_OPENMP) && !defined(__CUDA_ARCH__)
+#define COMPADRE_HOST_SIMD _Pragma("omp simd")
+#else
+#define COMPADRE_HOST_SIMD
+#endif
+
+namespace KokkosBatched {
+
+    /// Host Internal
+    /// =============
+    //
+    // Attention!: These are forks of TeamVectorUTV_Internal and
+    // TeamVectorSolveUTV_Internal_Compadre for a team with a single thread
+    // and a single vector lane, which is how host execution spaces run them.
+    //
+    // There, the TeamVectorRange loops of the TeamVector versions become
+    // scalar loops, most of which run down columns of row major matrices.
+    // These versions compute the same factorization and solution, but
+    // order every update as a sequence of row operations so that the
+    // innermost loop runs over contiguous entries and is vectorized.
+    //
+    // Only the full rank path is reordered. A rank deficient matrix
+    // continues with the TeamVector versions after the column pivoted QR.
+    //
+    // All matrices are assumed to be row major (unit stride in their
+    // second index), which is all that Compadre passes.
+    //
+    struct HostUTV_Internal_Compadre {
+
+    // apply H = I - u u^T / tau, with u = [1; u2], from the left to [a1t; A2]
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    applyLeftHouseholder(const int m, const int n,
+           const ValueType tau,
+           const ValueType * u2, const int u2s,
+           /* */ ValueType * a1t,
+           /* */ ValueType * A2, const int as0,
+           /* */ ValueType * w1t) {
+
+        const ValueType inv_tau = ValueType(1)/tau;
+
+        // w1t = (a1t + u2'A2) / tau
+        COMPADRE_HOST_SIMD
+        for (int j=0; j<n; ++j) w1t[j] = a1t[j];
+        for (int i=0; i<m; ++i) {
+            const ValueType u2_i = u2[i*u2s];
+            const ValueType * A2_i = A2 + i*as0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<n; ++j) w1t[j] += u2_i*A2_i[j];
+        }
+        COMPADRE_HOST_SIMD
+        for (int j=0; j<n; ++j) {
+            w1t[j] *= inv_tau;
+            a1t[j] -= w1t[j];
+        }
+
+        // A2 -= u2 w1t
+        for (int i=0; i<m; ++i) {
+            const ValueType u2_i = u2[i*u2s];
+            ValueType * A2_i = A2 + i*as0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<n; ++j) A2_i[j] -= u2_i*w1t[j];
+        }
+    }
+
+    // y += alpha*(c_0 x_0 + c_1 x_1 + ...) for count rows x_l of X, taking four rows at a time so that y is 
+    // loaded and stored once for every four multiply-adds (the level 3 updates of the blocked versions)
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    addScaledRows(const int n, const int count,
+           const ValueType alpha,
+           const ValueType * c, const int cs,
+           const ValueType * X, const int xs0,
+           /* */ ValueType * y) {
+        int l = 0;
+        for (; l+4<=count; l+=4) {
+            const ValueType c0 = alpha*c[l*cs], c1 = alpha*c[(l+1)*cs], c2 = alpha*c[(l+2)*cs], c3 = alpha*c[(l+3)*cs];
+            const ValueType * x0 = X + l*xs0;
+            const ValueType * x1 = x0 + xs0;
+            const ValueType * x2 = x1 + xs0;
+            const ValueType * x3 = x2 + xs0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<n; ++j) y[j] += c0*x0[j] + c1*x1[j] + c2*x2[j] + c3*x3[j];
+        }
+        for (; l<count; ++l) {
+            const ValueType c0 = alpha*c[l*cs];
+            const ValueType * x0 = X + l*xs0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<n; ++j) y[j] += c0*x0[j];
+        }
+    }
+
+    // householder transformation of [chi1; x2] (TeamVectorLeftHouseholderInternal)
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    leftHouseholder(const int m_x2,
+           /* */ ValueType * chi1,
+           /* */ ValueType * x2, const int x2s,
+           /* */ ValueType * tau) {
+
+        typedef ValueType value_type;
+        using ats = Kokkos::ArithTraits<value_type>;
+
+        value_type norm_x2_square(0);
+        for (int i=0; i<m_x2; ++i) norm_x2_square += x2[i*x2s]*x2[i*x2s];
+        if (norm_x2_square == value_type(0)) {
+            *chi1 = -(*chi1);
+            *tau = 0.5;
+        } else {
+            const value_type norm_chi1 = ats::abs(*chi1);
+            const value_type norm_x = ats::sqrt(norm_x2_square + norm_chi1*norm_chi1);
+            const value_type alpha = (*chi1 < 0 ? value_type(1) : value_type(-1))*norm_x;
+            const value_type chi1_minus_alpha = *chi1 - alpha;
+            const value_type inv_chi1_minus_alpha = value_type(1)/chi1_minus_alpha;
+            for (int i=0; i<m_x2; ++i) x2[i*x2s] *= inv_chi1_minus_alpha;
+            *tau = 0.5 + 0.5*(norm_x2_square/(chi1_minus_alpha*chi1_minus_alpha));
+            *chi1 = alpha;
+        }
+    }
+
+    // find max location (first maximum, as in TeamVectorFindAmaxInternal) of norm, and swap 
+    // the norm and column at that location with the first one
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    applyColumnPivot(const int m, const int n,
+           /* */ ValueType * norm,
+           /* */ ValueType * A, const int as0) {
+
+        int piv = 0;
+        for (int j=1; j<n; ++j) {
+            if (norm[j] > norm[piv]) piv = j;
+        }
+        if (piv != 0) {
+            const ValueType tmp = norm[0];
+            norm[0] = norm[piv];
+            norm[piv] = tmp;
+            for (int i=0; i<m; ++i) {
+                ValueType * A_i = A + i*as0;
+                const ValueType tmp_a = A_i[0];
+                A_i[0] = A_i[piv];
+                A_i[piv] = tmp_a;
+            }
+        }
+        return piv;
+    }
+
+    // QR with column pivoting (TeamVectorQR_WithColumnPivotingInternal), one householder
+    // transformation applied to the whole trailing matrix at a time
+    template<typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    qrWithColumnPivoting(const int m, const int n,
+           /* */ ValueType * A, const int as0,
+           /* */ IntType   * p, const int ps0,
+           /* */ ValueType * t,
+           /* */ ValueType * norm,
+           /* */ ValueType * work,
+           /* */ int &matrix_rank) {
+
+        typedef ValueType value_type;
+        using ats = Kokkos::ArithTraits<value_type>;
+
+        const int min_mn = m < n ? m : n;
+
+        matrix_rank = min_mn;
+        value_type max_diag(0);
+        for (int k=0; k<min_mn; ++k) {
+
+            p[k*ps0] = applyColumnPivot(m, n-k, norm + k, A + k, as0);
+
+            value_type * chi1 = A + k*as0 + k;
+            value_type * x2 = chi1 + as0;
+            const int m_x2 = m - k - 1;
+            leftHouseholder(m_x2, chi1, x2, as0, t + k);
+
+            // left apply householder to A22
+            applyLeftHouseholder(m_x2, n-k-1, t[k], x2, as0, chi1 + 1, x2 + 1, as0, work);
+
+            // break condition
+            if (matrix_rank == min_mn) {
+                if (k == 0) max_diag = ats::abs(A[0]);
+                const value_type val_diag = ats::abs(*chi1), threshold(10*max_diag*ats::epsilon());
+                if (val_diag < threshold) {
+                    matrix_rank = k;
+                    break;
+                }
+            }
+
+            // norm update
+            COMPADRE_HOST_SIMD
+            for (int j=k+1; j<n; ++j) norm[j] -= chi1[j-k]*chi1[j-k];
+        }
+    }
+
+    // QR with column pivoting, as in qrWithColumnPivoting, but blocked as in LAPACK's xLAQPS.
+    // The trailing matrix is updated once per block of householder transformations as A -= V F^T,
+    // while only the pivot row and pivot column are updated as each transformation is formed.
+    //
+    // work is block_size*(n + 1)
+    template<typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    qrWithColumnPivotingBlocked(const int m, const int n,
+           /* */ ValueType * A, const int as0,
+           /* */ IntType   * p, const int ps0,
+           /* */ ValueType * t,
+           /* */ ValueType * norm,
+           const int block_size,
+           /* */ ValueType * work,
+           /* */ int &matrix_rank) {
+
+        typedef ValueType value_type;
+        using ats = Kokkos::ArithTraits<value_type>;
+
+        const int min_mn = m < n ? m : n;
+
+        // F^T for the columns of the current block (block_size x n, columns are relative to k0)
+        value_type * Ft = work;
+        const int fs0 = n;
+        value_type * aux = work + block_size*n;
+
+        matrix_rank = min_mn;
+        value_type max_diag(0);
+        for (int k0=0; k0<min_mn; k0+=block_size) {
+            const int nb = (k0 + block_size < min_mn) ? block_size : min_mn - k0;
+            const int n_F = n - k0;
+
+            for (int jj=0; jj<nb; ++jj) {
+                const int k = k0 + jj;
+
+                // apply pivot to A, norms, and rows of F
+                const int piv = applyColumnPivot(m, n-k, norm + k, A + k, as0);
+                p[k*ps0] = piv;
+                if (piv != 0) {
+                    for (int l=0; l<jj; ++l) {
+                        value_type * Ft_l = Ft + l*fs0 + (k-k0);
+                        const value_type tmp = Ft_l[0];
+                        Ft_l[0] = Ft_l[piv];
+                        Ft_l[piv] = tmp;
+                    }
+                }
+
+                // bring pivot column up to date: A(k:m,k) -= V(k:m,0:jj) F(k,0:jj)^T
+                if (jj > 0) {
+                    for (int l=0; l<jj; ++l) aux[l] = Ft[l*fs0 + jj];
+                    for (int i=k; i<m; ++i) {
+                        value_type * A_i = A + i*as0;
+                        value_type sum(0);
+                        for (int l=0; l<jj; ++l) sum += A_i[k0+l]*aux[l];
+                        A_i[k] -= sum;
+                    }
+                }
+
+                value_type * chi1 = A + k*as0 + k;
+                value_type * x2 = chi1 + as0;
+                const int m_x2 = m - k - 1;
+                leftHouseholder(m_x2, chi1, x2, as0, t + k);
+                const value_type beta = value_type(1)/t[k];
+
+                // F(k+1:n,jj) = beta*(A(k:m,k+1:n)^T v - F(k+1:n,0:jj) V(k:m,0:jj)^T v), with v(k) = 1
+                // 
+                // V(k:m,0:jj) is stored in A(k:m,k0:k), so V(k:m,0:jj)^T v is found in the same pass over rows 
+                // as A(k:m,k+1:n)^T v, and is kept in F(k0:k,jj) until it is used
+                value_type * Ft_jj = Ft + jj*fs0;
+                {
+                    const value_type * A_k = A + k*as0 + k0;
+                    COMPADRE_HOST_SIMD
+                    for (int j=0; j<n_F; ++j) Ft_jj[j] = A_k[j];
+                    addScaledRows(n_F, m_x2, value_type(1), x2, as0, A_k + as0, as0, Ft_jj);
+                }
+                for (int l=0; l<jj; ++l) {
+                    aux[l] = Ft_jj[l];
+                    Ft_jj[l] = 0;
+                }
+                Ft_jj[jj] = 0;
+                addScaledRows(n_F-jj-1, jj, value_type(-1), aux, 1, Ft + jj+1, fs0, Ft_jj + jj+1);
+                COMPADRE_HOST_SIMD
+                for (int j=jj+1; j<n_F; ++j) Ft_jj[j] *= beta;
+
+                // bring pivot row up to date: A(k,k+1:n) -= V(k,0:jj+1) F(k+1:n,0:jj+1)^T
+                {
+                    value_type * A_k = A + k*as0;
+                    addScaledRows(n-k-1, jj, value_type(-1), A_k + k0, 1, Ft + jj+1, fs0, A_k + k+1);
+                    COMPADRE_HOST_SIMD
+                    for (int j=k+1; j<n; ++j) A_k[j] -= Ft_jj[j-k0];
+                }
+
+                // break condition
+                if (matrix_rank == min_mn) {
+                    if (k == 0) max_diag = ats::abs(A[0]);
+                    const value_type val_diag = ats::abs(*chi1), threshold(10*max_diag*ats::epsilon());
+                    if (val_diag < threshold) {
+                        // rows of R above k are already up to date, which is all that is used
+                        matrix_rank = k;
+                        return;
+                    }
+                }
+
+                // norm update
+                COMPADRE_HOST_SIMD
+                for (int j=k+1; j<n; ++j) norm[j] -= chi1[j-k]*chi1[j-k];
+            }
+
+            // A(k0+nb:m,k0+nb:n) -= V(k0+nb:m,0:nb) F(k0+nb:n,0:nb)^T
+            for (int i=k0+nb; i<m; ++i) {
+                value_type * A_i = A + i*as0;
+                addScaledRows(n-k0-nb, nb, value_type(-1), A_i + k0, 1, Ft + nb, fs0, A_i + k0+nb);
+            }
+        }
+    }
+
+    // form Q = H0 H1 ... H(k-1) [I; 0] in U (TeamVectorQR_FormQ_Internal)
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    formQ(const int m, const int k,
+           const ValueType * A, const int as0,
+           const ValueType * t,
+           /* */ ValueType * U, const int us0,
+           /* */ ValueType * work) {
+        for (int i=0; i<m; ++i) {
+            ValueType * U_i = U + i*us0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<k; ++j) U_i[j] = (i==j) ? ValueType(1) : ValueType(0);
+        }
+        // columns of U left of the householder vector being applied are still
+        // the identity there, so only the remaining columns are updated
+        for (int l=k-1; l>=0; --l) {
+            applyLeftHouseholder(m-l-1, k-l, t[l], A + (l+1)*as0 + l, as0,
+                    U + l*us0 + l, U + (l+1)*us0 + l, us0, work);
+        }
+    }
+
+    // form Q as in formQ, applying blocks of householder transformations at a time in their
+    // compact WY representation, H(k0) ... H(k0+nb-1) = I - V T V^T
+    //
+    // work is block_size*(block_size + k)
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    static void
+    formQBlocked(const int m, const int k,
+           const ValueType * A, const int as0,
+           const ValueType * t,
+           /* */ ValueType * U, const int us0,
+           const int block_size,
+           /* */ ValueType * work) {
+
+        typedef ValueType value_type;
+
+        value_type * T = work; // block_size x block_size
+        value_type * W = work + block_size*block_size; // block_size x k
+        const int ws0 = k;
+
+        for (int i=0; i<m; ++i) {
+            value_type * U_i = U + i*us0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<k; ++j) U_i[j] = (i==j) ? value_type(1) : value_type(0);
+        }
+
+        const int last_block = ((k-1)/block_size)*block_size;
+        for (int k0=last_block; k0>=0; k0-=block_size) {
+            const int nb = (k0 + block_size < k) ? block_size : k - k0;
+            const int n_W = k - k0;
+
+            // V(0:m-k0,0:nb) is stored below the diagonal of A(k0:m,k0:k0+nb), with a unit diagonal
+            const value_type * V = A + k0*as0 + k0;
+
+            // T upper triangular, with T(l,l) = 1/tau(l) and T(0:l,l) = -T(l,l) T(0:l,0:l) V(:,0:l)^T V(:,l)
+            for (int l=0; l<nb; ++l) {
+                const value_type beta = value_type(1)/t[k0+l];
+                // V(:,0:l)^T V(:,l) is staged in the strictly lower part of T
+                value_type * T_l = T + l*block_size;
+                for (int q=0; q<l; ++q) T_l[q] = V[l*as0 + q];
+                for (int i=l+1; i<m-k0; ++i) {
+                    const value_type * V_i = V + i*as0;
+                    const value_type v_il = V_i[l];
+                    for (int q=0; q<l; ++q) T_l[q] += V_i[q]*v_il;
+                }
+                for (int q=0; q<l; ++q) {
+                    value_type sum(0);
+                    for (int r=q; r<l; ++r) sum += T[q*block_size + r]*T_l[r];
+                    T[q*block_size + l] = -beta*sum;
+                }
+                T[l*block_size + l] = beta;
+            }
+
+            // W = V^T U(k0:m,k0:k)
+            for (int l=0; l<nb; ++l) {
+                value_type * W_l = W + l*ws0;
+                const value_type * U_l = U + (k0+l)*us0 + k0;
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<n_W; ++j) W_l[j] = U_l[j];
+                addScaledRows(n_W, m-k0-l-1, value_type(1), V + (l+1)*as0 + l, as0, U_l + us0, us0, W_l);
+            }
+
+            // W = T W
+            for (int l=0; l<nb; ++l) {
+                value_type * W_l = W + l*ws0;
+                const value_type T_ll = T[l*block_size + l];
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<n_W; ++j) W_l[j] *= T_ll;
+                addScaledRows(n_W, nb-l-1, value_type(1), T + l*block_size + l+1, 1, W_l + ws0, ws0, W_l);
+            }
+
+            // U(k0:m,k0:k) -= V W
+            for (int i=0; i<m-k0; ++i) {
+                value_type * U_i = U + (k0+i)*us0 + k0;
+                if (i < nb) {
+                    addScaledRows(n_W, i, value_type(-1), V + i*as0, 1, W, ws0, U_i);
+                    const value_type * W_i = W + i*ws0;
+                    COMPADRE_HOST_SIMD
+                    for (int j=0; j<n_W; ++j) U_i[j] -= W_i[j];
+                } else {
+                    addScaledRows(n_W, nb, value_type(-1), V + i*as0, 1, W, ws0, U_i);
+                }
+            }
+        }
+    }
+
+    template<typename MemberType,
+             typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    invoke(const MemberType &member,
+           const int m, const int n, // m = NumRows(A)
+           /* */ ValueType * A, const int as0, const int as1,
+           /* */ IntType   * p, const int ps0,
+           /* */ ValueType * U, const int us0, const int us1,
+           /* */ ValueType * V, const int vs0, const int vs1,
+           /* */ ValueType * w, // 3*m, tau, norm, householder workspace
+           /* */ int &matrix_rank,
+           const int block_size = 1,
+           /* */ ValueType * block_work = nullptr) { // block_size*(block_size + n), if block_size > 1
+
+        typedef ValueType value_type;
+
+        // same workspace partitioning as TeamVectorUTV_Internal
+        value_type *t = w; w += m;
+        value_type *norm = w; w += n;
+        value_type *work = w;
+
+        // initial column norms
+        COMPADRE_HOST_SIMD
+        for (int j=0; j<n; ++j) norm[j] = 0;
+        for (int i=0; i<m; ++i) {
+            const value_type * A_i = A + i*as0;
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<n; ++j) norm[j] += A_i[j]*A_i[j];
+        }
+
+        if (block_size > 1) {
+            qrWithColumnPivotingBlocked(m, n, A, as0, p, ps0, t, norm, block_size, block_work, matrix_rank);
+            formQBlocked(m, matrix_rank, A, as0, t, U, us0, block_size, block_work);
+        } else {
+            qrWithColumnPivoting(m, n, A, as0, p, ps0, t, norm, work, matrix_rank);
+            formQ(m, matrix_rank, A, as0, t, U, us0, work);
+        }
+
+        /// for rank deficient matrix
+        if (matrix_rank < n) {
+            const value_type zero(0);
+            TeamVectorSetLowerTriangularInternal
+              ::invoke(member,
+                   matrix_rank, matrix_rank,
+                   1, zero,
+                   A, as0, as1);
+            TeamVectorQR_Internal
+              ::invoke(member,
+                   n, matrix_rank,
+                   A, as1, as0,
+                   t, 1,
+                   work);
+            TeamVectorQR_FormQ_Internal
+              ::invoke(member,
+                   n, matrix_rank, matrix_rank,
+                   A, as1, as0,
+                   t, 1,
+                   V, vs1, vs0,
+                   work);
+        }
+
+        return 0;
+    }
+    };
+
+    struct HostSolveUTV_Internal_Compadre {
+
+    template<typename MemberType,
+             typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    invoke(const MemberType &member,
+           const int matrix_rank,
+           const int m, const int n, const int nrhs,
+           const ValueType * U, const int us0, const int us1,
+           const ValueType * T, const int ts0, const int ts1,
+           const ValueType * V, const int vs0, const int vs1,
+           const IntType   * p, const int ps0,
+           /* */ ValueType * B, const int bs0, const int bs1,
+           /* */ ValueType * X, const int xs0, const int xs1,
+           /* */ ValueType * w, ValueType * wq) {
+
+        typedef ValueType value_type;
+
+        if (matrix_rank < n) {
+            return TeamVectorSolveUTV_Internal_Compadre
+              ::invoke(member,
+                   matrix_rank, m, n, nrhs,
+                   U, us0, us1,
+                   T, ts0, ts1,
+                   V, vs0, vs1,
+                   p, ps0,
+                   B, bs0, bs1,
+                   X, xs0, xs1,
+                   w, wq);
+        }
+
+        if (m==n) { // LU case
+            /// W = U^T B (W is matrix_rank x nrhs, row major)
+            value_type * W = w;
+            for (int i=0; i<matrix_rank; ++i) {
+                value_type * W_i = W + i*nrhs;
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<nrhs; ++j) W_i[j] = 0;
+            }
+            for (int l=0; l<m; ++l) {
+                const value_type * B_l = B + l*bs0;
+                for (int i=0; i<matrix_rank; ++i) {
+                    const value_type U_li = U[l*us0+i*us1];
+                    value_type * W_i = W + i*nrhs;
+                    COMPADRE_HOST_SIMD
+                    for (int j=0; j<nrhs; ++j) W_i[j] += U_li*B_l[j*bs1];
+                }
+            }
+            /// X = W
+            for (int i=0; i<matrix_rank; ++i) {
+                const value_type * W_i = W + i*nrhs;
+                value_type * X_i = X + i*xs0;
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<nrhs; ++j) X_i[j*xs1] = W_i[j];
+            }
+        } else {
+            /// X = U^T diag(B)
+            for (int j=0; j<nrhs; ++j) wq[j] = B[j];
+            for (int i=0; i<matrix_rank; ++i) {
+                value_type * X_i = X + i*xs0;
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<nrhs; ++j) X_i[j*xs1] = U[j*us0+i*us1]*wq[j];
+            }
+        }
+
+        /// X = T^{-1} X (T is upper triangular)
+        for (int i=matrix_rank-1; i>=0; --i) {
+            value_type * X_i = X + i*xs0;
+            for (int l=i+1; l<matrix_rank; ++l) {
+                const value_type T_il = T[i*ts0+l*ts1];
+                const value_type * X_l = X + l*xs0;
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<nrhs; ++j) X_i[j*xs1] -= T_il*X_l[j*xs1];
+            }
+            const value_type inv_T_ii = value_type(1)/T[i*ts0+i*ts1];
+            COMPADRE_HOST_SIMD
+            for (int j=0; j<nrhs; ++j) X_i[j*xs1] *= inv_T_ii;
+        }
+
+        /// X = P^T X
+        for (int i=matrix_rank-1; i>=0; --i) {
+            const int piv = p[i*ps0];
+            if (piv != 0) {
+                value_type * X_i = X + i*xs0;
+                value_type * X_p = X + (i+piv)*xs0;
+                COMPADRE_HOST_SIMD
+                for (int j=0; j<nrhs; ++j) {
+                    const value_type tmp = X_i[j*xs1];
+                    X_i[j*xs1] = X_p[j*xs1];
+                    X_p[j*xs1] = tmp;
+                }
+            }
+        }
+
+        return 0;
+    }
+    };
+
+} // end namespace KokkosBatched
+
+#undef COMPADRE_HOST_SIMD
+
+#endif
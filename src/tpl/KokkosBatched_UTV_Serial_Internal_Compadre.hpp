@@ -0,0 +1,180 @@
+#ifndef __KOKKOSBATCHED_UTV_SERIAL_INTERNAL_COMPADRE_HPP__
+#define __KOKKOSBATCHED_UTV_SERIAL_INTERNAL_COMPADRE_HPP__
+
+#include "KokkosBatched_Util.hpp"
+
+#include "KokkosBatched_SetTriangular_Internal.hpp"
+#include "KokkosBatched_QR_Serial_Internal.hpp"
+#include "KokkosBatched_SetIdentity_Internal.hpp"
+#include "KokkosBatched_ApplyQ_Serial_Internal.hpp"
+
+#include "KokkosBatched_UTV_Host_Internal_Compadre.hpp"
+
+namespace KokkosBatched {
+
+    /// Serial Internal
+    /// ===============
+    //
+    // Attention!: These are versions of HostUTV_Internal_Compadre and
+    // HostSolveUTV_Internal_Compadre that take no team member, so that a
+    // single thread (or vector lane) can factor and solve a problem of its
+    // own, on the host or on a device.
+    //
+    // The full rank path is the same as the host kernels. A rank deficient
+    // matrix is completed with the Serial QR and ApplyQ of KokkosKernels
+    // rather than the TeamVector versions.
+    //
+    // As for the host kernels, all matrices are assumed to be row major
+    // (unit stride in their second index), and the right hand side of the
+    // least squares solve is diagonal, with its diagonal stored in B.
+    //
+    struct SerialUTV_Internal_Compadre {
+
+    template<typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    invoke(const int m, const int n, // m = NumRows(A)
+           /* */ ValueType * A, const int as0, const int as1,
+           /* */ IntType   * p, const int ps0,
+           /* */ ValueType * U, const int us0,
+           /* */ ValueType * V, const int vs0, const int vs1,
+           /* */ ValueType * w, // 3*m, tau, norm, householder workspace
+           /* */ int &matrix_rank) {
+
+        typedef ValueType value_type;
+        typedef HostUTV_Internal_Compadre host_type;
+
+        // same workspace partitioning as TeamVectorUTV_Internal
+        value_type *t = w; w += m;
+        value_type *norm = w; w += n;
+        value_type *work = w;
+
+        // initial column norms
+        for (int j=0; j<n; ++j) norm[j] = 0;
+        for (int i=0; i<m; ++i) {
+            const value_type * A_i = A + i*as0;
+            for (int j=0; j<n; ++j) norm[j] += A_i[j]*A_i[j];
+        }
+
+        host_type::qrWithColumnPivoting(m, n, A, as0, p, ps0, t, norm, work, matrix_rank);
+        host_type::formQ(m, matrix_rank, A, as0, t, U, us0, work);
+
+        /// for rank deficient matrix
+        if (matrix_rank < n) {
+            const value_type zero(0);
+            SerialSetLowerTriangularInternal
+              ::invoke(matrix_rank, matrix_rank,
+                   1, zero,
+                   A, as0, as1);
+            SerialQR_Internal
+              ::invoke(n, matrix_rank,
+                   A, as1, as0,
+                   t, 1,
+                   work);
+            // V = H0 H1 ... H(matrix_rank-1) [I; 0] (TeamVectorQR_FormQ_Internal)
+            SerialSetIdentityInternal
+              ::invoke(n, matrix_rank,
+                   V, vs1, vs0);
+            SerialApplyQ_LeftForwardInternal
+              ::invoke(n, matrix_rank, matrix_rank,
+                   A, as1, as0,
+                   t, 1,
+                   V, vs1, vs0,
+                   work);
+        }
+
+        return 0;
+    }
+    };
+
+    struct SerialSolveUTV_Internal_Compadre {
+
+    template<typename ValueType,
+             typename IntType>
+    KOKKOS_INLINE_FUNCTION
+    static int
+    invoke(const int matrix_rank,
+           const int m, const int n,
+           const ValueType * U, const int us0,
+           const ValueType * T, const int ts0,
+           const ValueType * V, const int vs0, const int vs1,
+           const IntType   * p, const int ps0,
+           const ValueType * B, // diagonal of the m x m right hand side
+           /* */ ValueType * X, const int xs0, // n x m
+           /* */ ValueType * w) { // matrix_rank x m, if matrix_rank < n
+
+        typedef ValueType value_type;
+
+        if (matrix_rank < n) {
+            /// W = U^T diag(B) (W is matrix_rank x m, row major)
+            value_type * W = w;
+            for (int i=0; i<matrix_rank; ++i) {
+                value_type * W_i = W + i*m;
+                for (int j=0; j<m; ++j) W_i[j] = U[j*us0+i]*B[j];
+            }
+
+            /// W = T^{-1} W (T is lower triangular after the second QR)
+            for (int i=0; i<matrix_rank; ++i) {
+                value_type * W_i = W + i*m;
+                for (int l=0; l<i; ++l) {
+                    const value_type T_il = T[i*ts0+l];
+                    const value_type * W_l = W + l*m;
+                    for (int j=0; j<m; ++j) W_i[j] -= T_il*W_l[j];
+                }
+                const value_type inv_T_ii = value_type(1)/T[i*ts0+i];
+                for (int j=0; j<m; ++j) W_i[j] *= inv_T_ii;
+            }
+
+            /// X = V^T W
+            for (int i=0; i<n; ++i) {
+                value_type * X_i = X + i*xs0;
+                for (int j=0; j<m; ++j) X_i[j] = 0;
+                for (int l=0; l<matrix_rank; ++l) {
+                    const value_type V_il = V[i*vs1+l*vs0];
+                    const value_type * W_l = W + l*m;
+                    for (int j=0; j<m; ++j) X_i[j] += V_il*W_l[j];
+                }
+            }
+        } else {
+            /// X = U^T diag(B)
+            for (int i=0; i<matrix_rank; ++i) {
+                value_type * X_i = X + i*xs0;
+                for (int j=0; j<m; ++j) X_i[j] = U[j*us0+i]*B[j];
+            }
+
+            /// X = T^{-1} X (T is upper triangular)
+            for (int i=matrix_rank-1; i>=0; --i) {
+                value_type * X_i = X + i*xs0;
+                for (int l=i+1; l<matrix_rank; ++l) {
+                    const value_type T_il = T[i*ts0+l];
+                    const value_type * X_l = X + l*xs0;
+                    for (int j=0; j<m; ++j) X_i[j] -= T_il*X_l[j];
+                }
+                const value_type inv_T_ii = value_type(1)/T[i*ts0+i];
+                for (int j=0; j<m; ++j) X_i[j] *= inv_T_ii;
+            }
+        }
+
+        /// X = P^T X
+        for (int i=matrix_rank-1; i>=0; --i) {
+            const int piv = p[i*ps0];
+            if (piv != 0) {
+                value_type * X_i = X + i*xs0;
+                value_type * X_p = X + (i+piv)*xs0;
+                for (int j=0; j<m; ++j) {
+                    const value_type tmp = X_i[j];
+                    X_i[j] = X_p[j];
+                    X_p[j] = tmp;
+                }
+            }
+        }
+
+        return 0;
+    }
+    };
+
+} // end namespace KokkosBatched
+
+
+#endif